@@ -1677,6 +1677,8 @@ Editor::loudness_analyze_region_selection ()
 	ag.Progress.connect_same_thread (c, std::bind (&SimpleProgressDialog::update_progress, &spd, _1, _2));
 	spd.show();
 
+	std::list<std::shared_ptr<AudioRegion> > regions;
+
 	for (RegionSelection::iterator j = ars.begin (); j != ars.end (); ++j) {
 		AudioRegionView* arv = dynamic_cast<AudioRegionView*> (*j);
 		if (!arv) {
@@ -1686,8 +1688,9 @@ Editor::loudness_analyze_region_selection ()
 		if (!ar) {
 			continue;
 		}
-		ag.analyze_region (ar);
+		regions.push_back (ar);
 	}
+	ag.analyze_regions (regions);
 	spd.hide();
 	if (!ag.canceled ()) {
 		ExportReport er (_("Audio Report/Analysis"), ag.results ());
@@ -5533,11 +5536,14 @@ Editor::ui_parameter_changed (string parameter)
 		}
 	} else if (parameter == "use-note-bars-for-velocity") {
 		ArdourCanvas::Note::set_show_velocity_bars (UIConfiguration::instance().get_use_note_bars_for_velocity());
+		_track_canvas->invalidate_cached_area ();
 		_track_canvas->request_redraw (_track_canvas->visible_area());
 	} else if (parameter == "use-note-color-for-velocity") {
 		/* handled individually by each MidiRegionView */
 	} else if (parameter == "show-selection-marker") {
 		update_ruler_visibility ();
+	} else if (parameter == "editor-canvas-tile-cache") {
+		hv_scroll_group->set_tile_cache (UIConfiguration::instance().get_editor_canvas_tile_cache ());
 	}
 }
 
@@ -110,6 +110,7 @@ Editor::initialize_canvas ()
 													     ArdourCanvas::ScrollGroup::ScrollsHorizontally));
 	CANVAS_DEBUG_NAME (hv_scroll_group, "canvas hv scroll");
 	_track_canvas->add_scroller (*hsg);
+	hsg->set_tile_cache (UIConfiguration::instance().get_editor_canvas_tile_cache ());
 
 	cursor_scroll_group = cg = new ArdourCanvas::ScrollGroup (_track_canvas->root(), ArdourCanvas::ScrollGroup::ScrollsHorizontally);
 	CANVAS_DEBUG_NAME (cursor_scroll_group, "canvas cursor scroll");
@@ -1041,6 +1042,7 @@ Editor::color_handler()
 
 	/* redraw the whole thing */
 	_track_canvas->set_background_color (UIConfiguration::instance().color ("arrange base"));
+	_track_canvas->invalidate_cached_area ();
 	_track_canvas->queue_draw ();
 
 /*
@@ -27,6 +27,8 @@
 
 #include "pbd/unwind.h"
 
+#include "ardour/analyser.h"
+#include "ardour/audioregion.h"
 #include "ardour/control_protocol_manager.h"
 #include "ardour/midi_region.h"
 #include "ardour/midi_track.h"
@@ -1687,6 +1689,23 @@ Editor::region_selection_changed ()
 		_session->clear_object_selection ();
 	}
 
+	/* analyse sources of selected regions first, they are the most likely
+	 * to be used for transient based operations.
+	 */
+	if (Config->get_auto_analyse_audio ()) {
+		for (auto const& rv : selection->regions) {
+			std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (rv->region ());
+			if (!ar) {
+				continue;
+			}
+			for (uint32_t n = 0; n < ar->n_channels (); ++n) {
+				if (!ar->source (n)->has_been_analysed ()) {
+					Analyser::prioritize_source (ar->source (n));
+				}
+			}
+		}
+	}
+
 	if (_session->solo_selection_active()) {
 		play_solo_selection(false);
 	}
@@ -49,6 +49,8 @@ LevelMeterBase::LevelMeterBase (Session* s, PBD::EventLoop::InvalidationRecord*
 	: parent_invalidator(ir)
 	, _meter (0)
 	, _meter_orientation(o)
+	, _levels_seq (0)
+	, _level_reader (-1)
 	, regular_meter_width (6)
 	, meter_length (0)
 	, thin_meter_width(2)
@@ -71,6 +73,9 @@ LevelMeterBase::~LevelMeterBase ()
 	_configuration_connection.disconnect();
 	_meter_type_connection.disconnect();
 	_parameter_connection.disconnect();
+	if (_meter) {
+		_meter->remove_level_reader (_level_reader);
+	}
 	for (vector<MeterInfo>::iterator i = meters.begin(); i != meters.end(); i++) {
 		delete (*i).meter;
 	}
@@ -83,10 +88,17 @@ LevelMeterBase::set_meter (PeakMeter* meter)
 	_configuration_connection.disconnect();
 	_meter_type_connection.disconnect();
 
+	if (_meter) {
+		_meter->remove_level_reader (_level_reader);
+		_level_reader = -1;
+	}
+
 	_meter = meter;
+	_levels_seq = 0;
 	color_changed = true; // force update
 
 	if (_meter) {
+		_level_reader = _meter->add_level_reader ();
 		_meter->ConfigurationChanged.connect (_configuration_connection, parent_invalidator, std::bind (&LevelMeterBase::configuration_changed, this, _1, _2), gui_context());
 		_meter->MeterTypeChanged.connect (_meter_type_connection, parent_invalidator, std::bind (&LevelMeterBase::meter_type_changed, this, _1), gui_context());
 	}
@@ -137,11 +149,16 @@ LevelMeterBase::update_meters ()
 		return 0.0f;
 	}
 
+	/* read all channels at once, nothing to do if no new levels were published */
+	if (!_meter->read_levels (_levels, _levels_seq, _level_reader)) {
+		return max_peak;
+	}
+
 	uint32_t nmidi = _meter->input_streams().n_midi();
 
 	for (n = 0, i = meters.begin(); i != meters.end(); ++i, ++n) {
 		if ((*i).packed) {
-			const float mpeak = _meter->meter_level(n, MeterMaxPeak);
+			const float mpeak = _meter->level_of (_levels, n, MeterMaxPeak);
 			if (mpeak > (*i).max_peak) {
 				(*i).max_peak = mpeak;
 				(*i).meter->set_highlight(mpeak >= UIConfiguration::instance().get_meter_peak());
@@ -151,10 +168,10 @@ LevelMeterBase::update_meters ()
 			}
 
 			if (n < nmidi) {
-				(*i).meter->set (_meter->meter_level (n, MeterPeak));
+				(*i).meter->set (_meter->level_of (_levels, n, MeterPeak));
 			} else {
 				MeterType meter_type = _meter->meter_type ();
-				const float peak = _meter->meter_level (n, meter_type);
+				const float peak = _meter->level_of (_levels, n, meter_type);
 				if (meter_type == MeterPeak) {
 					(*i).meter->set (log_meter (peak));
 				} else if (meter_type == MeterPeak0dB) {
@@ -168,13 +185,13 @@ LevelMeterBase::update_meters ()
 				} else if (meter_type == MeterVU) {
 					(*i).meter->set (meter_deflect_vu (peak + vu_standard() + meter_lineup(0)));
 				} else if (meter_type == MeterK12) {
-					(*i).meter->set (meter_deflect_k (peak, 12), meter_deflect_k(_meter->meter_level(n, MeterPeak), 12));
+					(*i).meter->set (meter_deflect_k (peak, 12), meter_deflect_k(_meter->level_of (_levels, n, MeterPeak), 12));
 				} else if (meter_type == MeterK14) {
-					(*i).meter->set (meter_deflect_k (peak, 14), meter_deflect_k(_meter->meter_level(n, MeterPeak), 14));
+					(*i).meter->set (meter_deflect_k (peak, 14), meter_deflect_k(_meter->level_of (_levels, n, MeterPeak), 14));
 				} else if (meter_type == MeterK20) {
-					(*i).meter->set (meter_deflect_k (peak, 20), meter_deflect_k(_meter->meter_level(n, MeterPeak), 20));
+					(*i).meter->set (meter_deflect_k (peak, 20), meter_deflect_k(_meter->level_of (_levels, n, MeterPeak), 20));
 				} else { // RMS
-					(*i).meter->set (log_meter (peak), log_meter(_meter->meter_level(n, MeterPeak)));
+					(*i).meter->set (log_meter (peak), log_meter(_meter->level_of (_levels, n, MeterPeak)));
 				}
 			}
 		}
@@ -78,6 +78,10 @@ private:
 	ARDOUR::PeakMeter* _meter;
 	ArdourWidgets::FastMeter::Orientation _meter_orientation;
 
+	std::vector<float> _levels;
+	uint64_t           _levels_seq;
+	int                _level_reader;
+
 	Width _width;
 
 	struct MeterInfo {
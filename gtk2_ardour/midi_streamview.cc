@@ -239,8 +239,10 @@ MidiStreamView::update_contents_metrics(std::shared_ptr<Region> r)
 	std::shared_ptr<MidiRegion> mr = std::dynamic_pointer_cast<MidiRegion>(r);
 
 	if (mr) {
+		/* may load the model, which takes the source lock */
+		std::shared_ptr<MidiModel> model = mr->model();
 		Source::ReaderLock lm (mr->midi_source(0)->mutex());
-		_range_dirty = update_data_note_range (mr->model()->lowest_note(), mr->model()->highest_note());
+		_range_dirty = update_data_note_range (model->lowest_note(), model->highest_note());
 	}
 }
 
@@ -2399,6 +2399,16 @@ RCOptionEditor::RCOptionEditor ()
 
 	add_option (_("General"), new UndoOptions (_rc_config));
 
+	SpinOption<uint32_t>* undo_mem = new SpinOption<uint32_t> (
+		"history-memory-budget",
+		_("Undo history memory limit (MB)"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_history_memory_budget),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_history_memory_budget),
+		0, 16384, 16, 256
+		);
+	Gtkmm2ext::UI::instance()->set_tip (undo_mem->tip_widget(), _("When the undo history uses more memory than this, the oldest operations are moved to disk. They are read back when undo reaches them, and are saved with the session history. Set to 0 for no limit."));
+	add_option (_("General"), undo_mem);
+
 	add_option (_("General"),
 	     new BoolOption (
 		     "verify-remove-last-capture",
@@ -3145,9 +3155,17 @@ These settings will only take effect after %1 is restarted.\n\
 #endif
 
 	add_option (_("Appearance/Quirks"), new OptionEditorBlank ());
-#if (!defined USE_CAIRO_IMAGE_SURFACE || defined CAIRO_SUPPORTS_FORCE_BUGGY_GRADIENTS_ENVIRONMENT_VARIABLE || defined __APPLE__)
 	add_option (_("Appearance"), new OptionEditorHeading (_("Graphics Acceleration")));
-#endif
+
+	bo = new BoolOption (
+		"editor-canvas-tile-cache",
+		_("Cache rendered editor canvas content while scrolling"),
+		sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::get_editor_canvas_tile_cache),
+		sigc::mem_fun (UIConfiguration::instance(), &UIConfiguration::set_editor_canvas_tile_cache)
+		);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("When enabled, already rendered parts of the editor's track canvas are kept and re-used when scrolling, and only newly exposed areas are rendered. This uses additional memory."));
+	add_option (_("Appearance"), bo);
 
 #ifdef __APPLE__
 	ComboOption<AppleNSGLViewMode>* glmode = new ComboOption<AppleNSGLViewMode> (
@@ -4045,6 +4063,18 @@ These settings will only take effect after %1 is restarted.\n\
 				sigc::mem_fun (*this, &RCOptionEditor::plugin_scan_refresh)));
 
 	add_option (_("Plugins"), new PluginScanTimeOutSliderOption (_rc_config));
+
+	SpinOption<uint32_t>* sjo = new SpinOption<uint32_t> (
+			"plugin-scan-jobs",
+			_("Concurrent scanner processes"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_plugin_scan_jobs),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_plugin_scan_jobs),
+			0, 32,
+			1, 4
+			);
+	add_option (_("Plugins"), sjo);
+	Gtkmm2ext::UI::instance()->set_tip (sjo->tip_widget(),
+					    _("Number of VST plugins that are scanned at the same time, each in a separate process. 0 selects a value based on the number of CPU cores."));
 #endif
 
 	add_option (_("Plugins"), new OptionEditorHeading (_("General")));
@@ -4102,6 +4132,16 @@ These settings will only take effect after %1 is restarted.\n\
 	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
 					    _("<b>When enabled</b> plugins will be activated when they are added to tracks/busses.\n<b>When disabled</b> plugins will be left inactive when they are added to tracks/busses"));
 
+	bo = new BoolOption (
+		"defer-inactive-route-plugins",
+			_("Load plugins of inactive tracks/busses when they are activated"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_defer_inactive_route_plugins),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_defer_inactive_route_plugins)
+			);
+	add_option (_("Plugins"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    _("<b>When enabled</b> plugins of tracks/busses that are inactive when a session is loaded are only instantiated when the track/bus is activated. This speeds up loading sessions with many inactive tracks.\n<b>When disabled</b> all plugins are instantiated when the session is loaded."));
+
 	bo = new BoolOption (
 		"setup-sidechain",
 			_("Setup Sidechain ports when loading plugin with aux inputs"),
@@ -4880,6 +4920,25 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+		ComboOption<int32_t>* athreads = new ComboOption<int32_t> (
+				"analysis-thread-count",
+				_("Audio analysis uses"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_analysis_thread_count),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_analysis_thread_count)
+				);
+
+		athreads->add (-2, _("all but two processors"));
+		athreads->add (-1, _("all but one processor"));
+		athreads->add (0, _("all available processors"));
+
+		for (uint32_t i = 1; i <= hwcpus; ++i) {
+			athreads->add (i, string_compose (P_("%1 processor", "%1 processors", i), i));
+		}
+
+		athreads->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
+
+		add_option (_("Performance"), athreads);
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
@@ -5026,6 +5085,18 @@ These settings will only take effect after %1 is restarted.\n\
 #endif
 	}
 
+#ifdef __linux__
+	bo = new BoolOption (
+		     "async-read-ahead",
+		     _("Batch disk reads asynchronously"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_async_read_ahead),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_async_read_ahead)
+		     );
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    _("When enabled, the file data of all tracks is requested at once (using io_uring) before the disk buffers are refilled. This can help with many tracks on SSDs or network storage. Has no effect if the system does not support io_uring."));
+	add_option (_("Performance"), bo);
+#endif
+
 	/* Image cache size */
 	add_option (_("Performance"), new OptionEditorHeading (_("Memory Usage")));
 
@@ -5041,6 +5112,19 @@ These settings will only take effect after %1 is restarted.\n\
 		 _("Increasing the cache size uses more memory to store waveform images, which can improve graphical performance."));
 	add_option (_("Performance"), sics);
 
+	SpinOption<uint32_t>* pbc = new SpinOption<uint32_t> (
+			"playback-cache-megabytes",
+			_("Audio playback cache size (megabytes)"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_playback_cache_megabytes),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_playback_cache_megabytes),
+			0, 262144,
+			256, 4096
+			);
+	Gtkmm2ext::UI::instance()->set_tip (
+			pbc->tip_widget(),
+		 _("Keep audio that is used by the session in memory, up to the given size. Playback and locates then do not need to read from disk. If the session does not fit, the least recently played audio is replaced. 0 disables the cache."));
+	add_option (_("Performance"), pbc);
+
 	add_option (_("Performance"), new OptionEditorHeading (_("Automation")));
 
 	add_option (_("Performance"),
@@ -635,4 +635,221 @@ arm_neon_copy_vector(float* __restrict dst, const float* __restrict src, uint32_
 	}
 }
 
+C_FUNC float
+arm_neon_resample_filter(const float *p1, const float *p2, const float *q1, const float *q2, float a, float b, uint32_t hl)
+{
+	const int n = hl;
+	int i = 0;
+
+	float32x4_t va  = vdupq_n_f32(a);
+	float32x4_t vb  = vdupq_n_f32(b);
+	float32x4_t acc = vdupq_n_f32(0.f);
+
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t c1 = vmlaq_f32(vmulq_f32(vb, vld1q_f32(q1 + i + n)), va, vld1q_f32(q1 + i));
+		float32x4_t c2 = vmlaq_f32(vmulq_f32(vb, vld1q_f32(q2 + i - n)), va, vld1q_f32(q2 + i));
+
+		float32x4_t x1 = vld1q_f32(p1 + i);
+		// p2 is read backwards
+		float32x4_t x2 = vrev64q_f32(vld1q_f32(p2 - i - 4));
+		x2 = vcombine_f32(vget_high_f32(x2), vget_low_f32(x2));
+
+		acc = vmlaq_f32(acc, x1, c1);
+		acc = vmlaq_f32(acc, x2, c2);
+	}
+
+	float32x2_t s2 = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+	float s = vget_lane_f32(vpadd_f32(s2, s2), 0);
+
+	for (; i < n; ++i) {
+		const float c1 = a * q1[i] + b * q1[i + n];
+		const float c2 = a * q2[i] + b * q2[i - n];
+		s += p1[i] * c1 + p2[-i - 1] * c2;
+	}
+
+	return s;
+}
+
+/* Meter ballistics, four channels at a time: one channel per lane,
+ * see x86_sse_kmeter_process()
+ */
+
+static inline void
+load_transposed(const float *const *buf, uint32_t i, float32x4_t *s)
+{
+	float32x4x2_t t01 = vtrnq_f32(vld1q_f32(buf[0] + i), vld1q_f32(buf[1] + i));
+	float32x4x2_t t23 = vtrnq_f32(vld1q_f32(buf[2] + i), vld1q_f32(buf[3] + i));
+
+	s[0] = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+	s[1] = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+	s[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+	s[3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+void
+arm_neon_kmeter_process(const float *const *buf, float *z1, float *z2, uint32_t nframes, float omega)
+{
+	const float32x4_t w  = vdupq_n_f32(omega);
+	const float32x4_t w4 = vdupq_n_f32(4 * omega);
+
+	float32x4_t a = vld1q_f32(z1);
+	float32x4_t b = vld1q_f32(z2);
+
+	for (uint32_t i = 0; i < nframes; i += 4) {
+		float32x4_t s[4];
+		load_transposed(buf, i, s);
+		for (int j = 0; j < 4; ++j) {
+			a = vaddq_f32(a, vmulq_f32(w, vsubq_f32(vmulq_f32(s[j], s[j]), a)));
+		}
+		b = vaddq_f32(b, vmulq_f32(w4, vsubq_f32(a, b)));
+	}
+
+	vst1q_f32(z1, a);
+	vst1q_f32(z2, b);
+}
+
+void
+arm_neon_ppm_process(const float *const *buf, float *z1, float *z2, float *m, uint32_t nframes, float w1, float w2, float w3)
+{
+	const float32x4_t vw1 = vdupq_n_f32(w1);
+	const float32x4_t vw2 = vdupq_n_f32(w2);
+	const float32x4_t vw3 = vdupq_n_f32(w3);
+
+	float32x4_t a  = vld1q_f32(z1);
+	float32x4_t b  = vld1q_f32(z2);
+	float32x4_t mx = vld1q_f32(m);
+
+	for (uint32_t i = 0; i < nframes; i += 4) {
+		float32x4_t s[4];
+		load_transposed(buf, i, s);
+		a = vmulq_f32(a, vw3);
+		b = vmulq_f32(b, vw3);
+
+		float32x4_t t[4];
+		for (int j = 0; j < 4; ++j) {
+			t[j] = vabsq_f32(s[j]);
+		}
+
+		/* skip the serial updates if no sample exceeds the filter values */
+		const float32x4_t tmax = vmaxnmq_f32(vmaxnmq_f32(t[0], t[1]), vmaxnmq_f32(t[2], t[3]));
+		if (vmaxvq_u32(vcgtq_f32(tmax, vminq_f32(a, b)))) {
+			for (int j = 0; j < 4; ++j) {
+				/* if (t > z) z += w * (t - z) */
+				a = vbslq_f32(vcgtq_f32(t[j], a), vaddq_f32(a, vmulq_f32(vw1, vsubq_f32(t[j], a))), a);
+				b = vbslq_f32(vcgtq_f32(t[j], b), vaddq_f32(b, vmulq_f32(vw2, vsubq_f32(t[j], b))), b);
+			}
+		}
+
+		/* if (t > m) m = t */
+		const float32x4_t ab = vaddq_f32(a, b);
+		mx = vbslq_f32(vcgtq_f32(ab, mx), ab, mx);
+	}
+
+	vst1q_f32(z1, a);
+	vst1q_f32(z2, b);
+	vst1q_f32(m, mx);
+}
+
+void
+arm_neon_vumeter_process(const float *const *buf, float *z1, float *z2, float *m, uint32_t nframes, float w)
+{
+	const float32x4_t half = vdupq_n_f32(.5f);
+	const float32x4_t vw   = vdupq_n_f32(w);
+	const float32x4_t vw4  = vdupq_n_f32(4 * w);
+
+	float32x4_t a  = vld1q_f32(z1);
+	float32x4_t b  = vld1q_f32(z2);
+	float32x4_t mx = vld1q_f32(m);
+
+	for (uint32_t i = 0; i < nframes; i += 4) {
+		float32x4_t s[4];
+		load_transposed(buf, i, s);
+		const float32x4_t t2 = vmulq_f32(b, half);
+		for (int j = 0; j < 4; ++j) {
+			const float32x4_t t1 = vsubq_f32(vabsq_f32(s[j]), t2);
+			a = vaddq_f32(a, vmulq_f32(vw, vsubq_f32(t1, a)));
+		}
+		b  = vaddq_f32(b, vmulq_f32(vw4, vsubq_f32(a, b)));
+		mx = vbslq_f32(vcgtq_f32(b, mx), b, mx);
+	}
+
+	vst1q_f32(z1, a);
+	vst1q_f32(z2, b);
+	vst1q_f32(m, mx);
+}
+
+void
+arm_neon_kweight_process(const float *const *buf, float *z, float *sum, uint32_t nframes, const float *coeff)
+{
+	const float32x4_t a0  = vdupq_n_f32(coeff[0]);
+	const float32x4_t a1  = vdupq_n_f32(coeff[1]);
+	const float32x4_t a2  = vdupq_n_f32(coeff[2]);
+	const float32x4_t b1  = vdupq_n_f32(coeff[3]);
+	const float32x4_t b2  = vdupq_n_f32(coeff[4]);
+	const float32x4_t c3  = vdupq_n_f32(coeff[5]);
+	const float32x4_t c4  = vdupq_n_f32(coeff[6]);
+	const float32x4_t eps = vdupq_n_f32(1e-15f);
+
+	float32x4_t z1 = vld1q_f32(z);
+	float32x4_t z2 = vld1q_f32(z + 4);
+	float32x4_t z3 = vld1q_f32(z + 8);
+	float32x4_t z4 = vld1q_f32(z + 12);
+	float32x4_t s  = vdupq_n_f32(0);
+
+	auto step = [&](float32x4_t d) {
+		const float32x4_t x = vaddq_f32(vsubq_f32(vsubq_f32(d, vmulq_f32(b1, z1)), vmulq_f32(b2, z2)), eps);
+		const float32x4_t y = vsubq_f32(vsubq_f32(vaddq_f32(vaddq_f32(vmulq_f32(a0, x), vmulq_f32(a1, z1)), vmulq_f32(a2, z2)), vmulq_f32(c3, z3)), vmulq_f32(c4, z4));
+		z2 = z1;
+		z1 = x;
+		z4 = vaddq_f32(z4, z3);
+		z3 = vaddq_f32(z3, y);
+		s  = vaddq_f32(s, vmulq_f32(y, y));
+	};
+
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		float32x4_t d[4];
+		load_transposed(buf, i, d);
+		step(d[0]);
+		step(d[1]);
+		step(d[2]);
+		step(d[3]);
+	}
+	for (; i < nframes; ++i) {
+		float32x4_t d = vdupq_n_f32(buf[0][i]);
+		d = vsetq_lane_f32(buf[1][i], d, 1);
+		d = vsetq_lane_f32(buf[2][i], d, 2);
+		d = vsetq_lane_f32(buf[3][i], d, 3);
+		step(d);
+	}
+
+	vst1q_f32(z, z1);
+	vst1q_f32(z + 4, z2);
+	vst1q_f32(z + 8, z3);
+	vst1q_f32(z + 12, z4);
+	vst1q_f32(sum, s);
+}
+
+float
+arm_neon_compute_true_peak(const float *buf, uint32_t nframes, const float *coeff, uint32_t n_phases, float current)
+{
+	float32x4_t m = vdupq_n_f32(current);
+	uint32_t    i = 0;
+
+	for (; i + 4 <= nframes; i += 4) {
+		const float *r = &buf[i];
+		m = vmaxq_f32(m, vabsq_f32(vld1q_f32(r + 47)));
+		for (uint32_t p = 0; p < n_phases; ++p) {
+			const float *h = &coeff[48 * p];
+			float32x4_t  u = vmulq_f32(vld1q_f32(r), vdupq_n_f32(h[0]));
+			for (int k = 1; k < 48; ++k) {
+				u = vaddq_f32(u, vmulq_f32(vld1q_f32(r + k), vdupq_n_f32(h[k])));
+			}
+			m = vmaxq_f32(m, vabsq_f32(u));
+		}
+	}
+
+	return default_compute_true_peak(&buf[i], nframes - i, coeff, n_phases, vmaxvq_f32(m));
+}
+
 #endif
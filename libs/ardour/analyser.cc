@@ -24,6 +24,7 @@
 #include "ardour/rc_configuration.h"
 #include "ardour/session_event.h"
 #include "ardour/transient_detector.h"
+#include "ardour/utils.h"
 
 #include "pbd/compose.h"
 #include "pbd/error.h"
@@ -34,12 +35,13 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
-Glib::Threads::Mutex          Analyser::analysis_active_lock;
 Glib::Threads::Mutex          Analyser::analysis_queue_lock;
 Glib::Threads::Cond           Analyser::SourcesToAnalyse;
+Glib::Threads::Cond           Analyser::AnalysisDone;
 list<std::weak_ptr<Source>> Analyser::analysis_queue;
+set<Source const*>          Analyser::analysis_active;
 bool                          Analyser::analysis_thread_run = false;
-PBD::Thread*                  Analyser::analysis_thread     = 0;
+vector<PBD::Thread*>          Analyser::analysis_threads;
 
 Analyser::Analyser ()
 {
@@ -52,7 +54,17 @@ Analyser::init ()
 		return;
 	}
 	analysis_thread_run = true;
-	analysis_thread     = PBD::Thread::create (sigc::ptr_fun (&Analyser::work), "Analyzer");
+
+	/* sources are independent, and each is read once by a single worker */
+	uint32_t n_threads = how_many_analysis_threads ();
+
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		PBD::Thread* t = PBD::Thread::create (sigc::ptr_fun (&Analyser::work), string_compose ("Analyzer %1", i + 1));
+		if (!t) {
+			break;
+		}
+		analysis_threads.push_back (t);
+	}
 }
 
 void
@@ -61,9 +73,28 @@ Analyser::terminate ()
 	if (!analysis_thread_run) {
 		return;
 	}
-	analysis_thread_run = false;
-	SourcesToAnalyse.broadcast ();
-	analysis_thread->join ();
+	{
+		Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+		analysis_thread_run = false;
+		SourcesToAnalyse.broadcast ();
+	}
+	for (auto const& t : analysis_threads) {
+		t->join ();
+		delete t;
+	}
+	analysis_threads.clear ();
+}
+
+list<std::weak_ptr<Source>>::iterator
+Analyser::find_queued (std::shared_ptr<Source> const& src)
+{
+	/* called with analysis_queue_lock held */
+	for (list<std::weak_ptr<Source>>::iterator i = analysis_queue.begin (); i != analysis_queue.end (); ++i) {
+		if (i->lock () == src) {
+			return i;
+		}
+	}
+	return analysis_queue.end ();
 }
 
 void
@@ -78,8 +109,32 @@ Analyser::queue_source_for_analysis (std::shared_ptr<Source> src, bool force)
 	}
 
 	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	/* a queued source is analysed with its current data. A source that
+	 * is being analysed already is only analysed again when forced,
+	 * since its data may have changed since that analysis started.
+	 */
+	if (find_queued (src) != analysis_queue.end ()) {
+		return;
+	}
+
+	if (!force && analysis_active.find (src.get ()) != analysis_active.end ()) {
+		return;
+	}
+
 	analysis_queue.push_back (std::weak_ptr<Source> (src));
-	SourcesToAnalyse.broadcast ();
+	SourcesToAnalyse.signal ();
+}
+
+void
+Analyser::prioritize_source (std::shared_ptr<Source> src)
+{
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	list<std::weak_ptr<Source>>::iterator i = find_queued (src);
+	if (i != analysis_queue.end () && i != analysis_queue.begin ()) {
+		analysis_queue.splice (analysis_queue.begin (), analysis_queue, i);
+	}
 }
 
 void
@@ -87,36 +142,41 @@ Analyser::work ()
 {
 	SessionEvent::create_per_thread_pool ("Analyser", 64);
 
-	while (true) {
-		analysis_queue_lock.lock ();
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	while (analysis_thread_run) {
 
-	wait:
-		if (analysis_queue.empty () && analysis_thread_run) {
+		if (analysis_queue.empty ()) {
 			SourcesToAnalyse.wait (analysis_queue_lock);
+			continue;
 		}
 
-		if (!analysis_thread_run) {
-			analysis_queue_lock.unlock ();
-			break;
+		std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (analysis_queue.front ().lock ());
+		analysis_queue.pop_front ();
+
+		if (!afs || afs->empty ()) {
+			continue;
 		}
 
-		if (analysis_queue.empty ()) {
-			goto wait;
+		/* a forced re-analysis must wait for the current one */
+		while (analysis_thread_run && analysis_active.find (afs.get ()) != analysis_active.end ()) {
+			AnalysisDone.wait (analysis_queue_lock);
 		}
 
-		std::shared_ptr<Source> src (analysis_queue.front ().lock ());
-		analysis_queue.pop_front ();
-		analysis_queue_lock.unlock ();
+		if (!analysis_thread_run) {
+			break;
+		}
 
-		std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (src);
+		analysis_active.insert (afs.get ());
+		lm.release ();
 
-		if (afs && !afs->empty ()) {
-			Glib::Threads::Mutex::Lock lm (analysis_active_lock);
-			analyse_audio_file_source (afs);
-		}
+		analyse_audio_file_source (afs);
+
+		lm.acquire ();
+		analysis_active.erase (afs.get ());
+		AnalysisDone.broadcast ();
 	}
 }
-
 void
 Analyser::analyse_audio_file_source (std::shared_ptr<AudioFileSource> src)
 {
@@ -142,6 +202,10 @@ void
 Analyser::flush ()
 {
 	Glib::Threads::Mutex::Lock lq (analysis_queue_lock);
-	Glib::Threads::Mutex::Lock la (analysis_active_lock);
 	analysis_queue.clear ();
+
+	/* wait for analyses that are in progress */
+	while (!analysis_active.empty ()) {
+		AnalysisDone.wait (analysis_queue_lock);
+	}
 }
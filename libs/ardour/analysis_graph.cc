@@ -17,12 +17,19 @@
  */
 
 
+#include <functional>
+
+#include "pbd/cpus.h"
+#include "pbd/pthread_utils.h"
 #include "pbd/progress.h"
 
 #include "ardour/analysis_graph.h"
+#include "ardour/ardour.h"
 #include "ardour/route.h"
 #include "ardour/session.h"
+#include "ardour/utils.h"
 
+#include "temporal/tempo.h"
 #include "temporal/time.h"
 
 #include "audiographer/process_context.h"
@@ -36,51 +43,69 @@
 using namespace ARDOUR;
 using namespace AudioGrapher;
 
-AnalysisGraph::AnalysisGraph (Session *s)
-	: _session (s)
-	, _max_chunksize (8192)
-	, _samples_read (0)
-	, _samples_end (0)
-	, _canceled (false)
-{
-	_buf     = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
-	_mixbuf  = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
-	_gainbuf = (float *)  malloc(sizeof(float)  * _max_chunksize);
-}
+namespace {
 
-AnalysisGraph::~AnalysisGraph ()
+/** Buffers and processing chain to analyze one region at a time */
+class RegionAnalyser
 {
-	free (_buf);
-	free (_mixbuf);
-	free (_gainbuf);
-}
+public:
+	RegionAnalyser (samplecnt_t max_chunksize)
+		: _max_chunksize (max_chunksize)
+	{
+		_buf     = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
+		_mixbuf  = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
+		_gainbuf = (float *)  malloc(sizeof(float)  * _max_chunksize);
+	}
 
-void
-AnalysisGraph::analyze_region (std::shared_ptr<AudioRegion> region, bool raw)
-{
-	analyze_region (region.get(), raw, (PBD::Progress*)0);
-}
+	~RegionAnalyser ()
+	{
+		free (_buf);
+		free (_mixbuf);
+		free (_gainbuf);
+	}
 
-void
-AnalysisGraph::analyze_region (AudioRegion const* region, bool raw, PBD::Progress* p)
+	/** @param progress is called with the number of samples read, and returns false to cancel
+	 * @return the result, or a null pointer if the analysis was cancelled
+	 */
+	ExportAnalysisPtr run (Session*, AudioRegion const*, bool raw, std::function<bool (samplecnt_t)> const& progress);
+
+private:
+	samplecnt_t _max_chunksize;
+	Sample*     _buf;
+	Sample*     _mixbuf;
+	float*      _gainbuf;
+};
+
+ExportAnalysisPtr
+RegionAnalyser::run (Session* session, AudioRegion const* region, bool raw, std::function<bool (samplecnt_t)> const& progress)
 {
 	int n_channels = region->n_channels();
 	if (n_channels == 0 || n_channels > _max_chunksize) {
-		return;
+		return ExportAnalysisPtr ();
 	}
 	samplecnt_t n_samples = _max_chunksize - (_max_chunksize % n_channels);
 
-	interleaver.reset (new Interleaver<Sample> ());
+	std::shared_ptr<Interleaver<Sample> > interleaver (new Interleaver<Sample> ());
+	std::shared_ptr<Chunker<Sample> >     chunker (new Chunker<Sample> (n_samples));
+	std::shared_ptr<Analyser>             analyser;
+
+	{
+		/* FFT plan creation is not thread-safe */
+		Glib::Threads::Mutex::Lock lk (ARDOUR::fft_planner_lock);
+		analyser.reset (new Analyser (
+					session->nominal_sample_rate(),
+					n_channels,
+					n_samples,
+					region->length_samples()));
+	}
+
 	interleaver->init (n_channels, _max_chunksize);
-	chunker.reset (new Chunker<Sample> (n_samples));
-	analyser.reset (new Analyser (
-				_session->nominal_sample_rate(),
-				n_channels,
-				n_samples,
-				region->length_samples()));
 	interleaver->add_output(chunker);
 	chunker->add_output (analyser);
 
+	ExportAnalysisPtr rv;
+	bool              canceled = false;
+
 	samplecnt_t x = 0;
 	samplecnt_t length = region->length_samples();
 	while (x < length) {
@@ -107,19 +132,141 @@ AnalysisGraph::analyze_region (AudioRegion const* region, bool raw, PBD::Progres
 			}
 		}
 		x += n;
+		if (!progress (n)) {
+			canceled = true;
+			break;
+		}
+	}
+
+	if (!canceled) {
+		rv = analyser->result ();
+	}
+
+	chunker->clear_outputs ();
+	Glib::Threads::Mutex::Lock lk (ARDOUR::fft_planner_lock);
+	analyser.reset ();
+	return rv;
+}
+
+} // namespace
+
+AnalysisGraph::AnalysisGraph (Session *s)
+	: _session (s)
+	, _max_chunksize (8192)
+	, _samples_read (0)
+	, _samples_end (0)
+	, _canceled (false)
+{
+	_buf     = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
+	_mixbuf  = (Sample *) malloc(sizeof(Sample) * _max_chunksize);
+	_gainbuf = (float *)  malloc(sizeof(float)  * _max_chunksize);
+}
+
+AnalysisGraph::~AnalysisGraph ()
+{
+	free (_buf);
+	free (_mixbuf);
+	free (_gainbuf);
+}
+
+void
+AnalysisGraph::analyze_region (std::shared_ptr<AudioRegion> region, bool raw)
+{
+	analyze_region (region.get(), raw, (PBD::Progress*)0);
+}
+
+void
+AnalysisGraph::analyze_region (AudioRegion const* region, bool raw, PBD::Progress* p)
+{
+	RegionAnalyser ra (_max_chunksize);
+
+	ExportAnalysisPtr rv = ra.run (_session, region, raw, [this, p] (samplecnt_t n) {
 		_samples_read += n;
 		Progress (_samples_read, _samples_end);
 		if (_canceled) {
-			return;
+			return false;
 		}
 		if (p) {
 			p->set_progress (_samples_read / (float) _samples_end);
 			if (p->cancelled ()) {
-				return;
+				return false;
 			}
 		}
+		return true;
+	});
+
+	if (rv) {
+		_results.insert (std::make_pair (region->name(), rv));
+	}
+}
+
+void
+AnalysisGraph::analyze_regions (std::list<std::shared_ptr<AudioRegion> > const& regions, bool raw)
+{
+	std::vector<std::shared_ptr<AudioRegion> > todo (regions.begin (), regions.end ());
+	std::vector<ExportAnalysisPtr>             results (todo.size ());
+	std::atomic<size_t>                        next (0);
+	std::atomic<size_t>                        running (0);
+	std::atomic<samplecnt_t>                   samples_read (0);
+
+	if (todo.empty ()) {
+		return;
+	}
+
+	auto worker = [&] () {
+		Temporal::TempoMap::fetch ();
+		RegionAnalyser ra (_max_chunksize);
+		size_t i;
+		while (!_canceled && (i = next.fetch_add (1)) < todo.size ()) {
+			results[i] = ra.run (_session, todo[i].get (), raw, [&] (samplecnt_t n) {
+				samples_read += n;
+				return !_canceled;
+			});
+		}
+		--running;
+	};
+
+	const size_t n_threads = std::min<size_t> (todo.size (), how_many_analysis_threads ());
+	std::vector<PBD::Thread*> threads;
+
+	for (size_t i = 0; i < n_threads; ++i) {
+		++running;
+		PBD::Thread* t = PBD::Thread::create (worker, string_compose ("Analysis %1", i + 1));
+		if (!t) {
+			--running;
+			break;
+		}
+		threads.push_back (t);
+	}
+
+	if (threads.empty ()) {
+		++running;
+		worker ();
+	}
+
+	/* the cancel callback is usually invoked by Progress handlers */
+	while (running > 0) {
+		Glib::usleep (50000);
+		Progress (_samples_read + samples_read, _samples_end);
+	}
+
+	for (auto const& t : threads) {
+		t->join ();
+		delete t;
+	}
+
+	_samples_read += samples_read;
+
+	if (_canceled) {
+		return;
+	}
+
+	/* add results in order, as analyze_region() does */
+	for (size_t i = 0; i < todo.size (); ++i) {
+		if (results[i]) {
+			_results.insert (std::make_pair (todo[i]->name(), results[i]));
+		}
 	}
-	_results.insert (std::make_pair (region->name(), analyser->result ()));
 }
 
 void
@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
+#include <set>
+#include <vector>
 
 #include "ardour/libardour_visibility.h"
 #include "pbd/pthread_utils.h"
@@ -37,16 +40,21 @@ public:
 	static void init ();
 	static void terminate ();
 	static void queue_source_for_analysis (std::shared_ptr<Source>, bool force);
+	/** Move a queued source to the front of the queue, e.g. because the user is looking at it */
+	static void prioritize_source (std::shared_ptr<Source>);
 	static void work ();
 	static void flush ();
 
 private:
-	static Glib::Threads::Mutex               analysis_active_lock;
 	static Glib::Threads::Mutex               analysis_queue_lock;
 	static Glib::Threads::Cond                SourcesToAnalyse;
+	static Glib::Threads::Cond                AnalysisDone;
 	static std::list<std::weak_ptr<Source>> analysis_queue;
+	static std::set<Source const*>          analysis_active;
 	static bool                               analysis_thread_run;
-	static PBD::Thread*                       analysis_thread;
+	static std::vector<PBD::Thread*>          analysis_threads;
+
+	static std::list<std::weak_ptr<Source>>::iterator find_queued (std::shared_ptr<Source> const&);
 
 	static void analyse_audio_file_source (std::shared_ptr<AudioFileSource>);
 };
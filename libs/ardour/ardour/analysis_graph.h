@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -49,13 +51,15 @@ class LIBARDOUR_API AnalysisGraph {
 
 		void analyze_region (ARDOUR::AudioRegion const*, bool raw = false, PBD::Progress* = 0);
 		void analyze_region (std::shared_ptr<ARDOUR::AudioRegion>, bool raw = false);
+		/** Analyze regions concurrently, Progress is emitted by the calling thread */
+		void analyze_regions (std::list<std::shared_ptr<ARDOUR::AudioRegion> > const&, bool raw = false);
 
 		void analyze_range (std::shared_ptr<ARDOUR::Route>, std::shared_ptr<ARDOUR::AudioPlaylist>, const std::list<TimelineRange>&);
 
 		const AnalysisResults& results () const { return _results; }
 
 		void cancel () { _canceled = true; }
-		bool canceled () const { return _canceled; }
+		bool canceled () const { return _canceled.load (); }
 
 		void set_total_samples (samplecnt_t p) { _samples_end = p; }
 		PBD::Signal<void(samplecnt_t, samplecnt_t)> Progress;
@@ -70,7 +74,7 @@ class LIBARDOUR_API AnalysisGraph {
 		float*           _gainbuf;
 		samplecnt_t       _samples_read;
 		samplecnt_t       _samples_end;
-		bool             _canceled;
+		std::atomic<bool> _canceled;
 
 		typedef std::shared_ptr<AudioGrapher::Analyser> AnalysisPtr;
 		typedef std::shared_ptr<AudioGrapher::Chunker<float> > ChunkerPtr;
@@ -70,6 +70,7 @@ public:
 
 	bool can_truncate_peaks() const { return true; }
 	bool can_be_analysed() const    { return _length.is_positive(); }
+	bool cacheable () const         { return !writable (); }
 
 	static bool safe_audio_file_extension (const std::string& path);
 
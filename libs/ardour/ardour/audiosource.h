@@ -51,6 +51,9 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	virtual samplecnt_t available_peaks (double zoom) const;
 
 	virtual samplecnt_t read (Sample *dst, samplepos_t start, samplecnt_t cnt, int channel=0) const;
+
+	/** @return true if reads may be served from the SourceCache */
+	virtual bool cacheable () const { return false; }
 	virtual samplecnt_t write (Sample const * src, samplecnt_t cnt);
 
 	virtual float sample_rate () const = 0;
@@ -96,6 +99,8 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	virtual bool clamped_at_unity () const = 0;
 
   protected:
+	friend class SourceCache;
+
 	static bool _build_missing_peakfiles;
 	static bool _build_peakfiles;
 
@@ -119,6 +124,7 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 
 	mutable off_t _peak_byte_max; // modified in compute_and_write_peak()
 
+	samplecnt_t read_uncached (Sample *dst, samplepos_t start, samplecnt_t cnt) const;
 	virtual samplecnt_t read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const = 0;
 	virtual samplecnt_t write_unlocked (Sample const * dst, samplecnt_t cnt) = 0;
 	virtual std::string construct_peak_filepath (const std::string& audio_path, const bool in_session = false, const bool old_peak_name = false) const = 0;
@@ -39,6 +39,8 @@
 
 namespace ARDOUR
 {
+class ReadAhead;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -101,6 +103,7 @@ private:
 	void process_delegated_work ();
 	void config_changed (std::string);
 	bool flush_tracks_to_disk_normal (std::shared_ptr<RouteList const>, uint32_t& errors);
+	void read_ahead (RouteList const&);
 	void queue_request (Request::Type r);
 
 	pthread_t thread;
@@ -117,6 +120,7 @@ private:
 	PBD::RingBuffer<PBD::CrossThreadPool*> pool_trash;
 	CrossThreadChannel                    _xthread;
 	PBD::MPMCQueue<sigc::slot<void> >     _delegated_work;
+	ReadAhead*                            _read_ahead;
 };
 
 } // namespace ARDOUR
@@ -35,6 +35,7 @@ namespace ARDOUR
 class Playlist;
 class AudioPlaylist;
 class MidiPlaylist;
+class ReadAhead;
 
 template <typename T> class MidiRingBuffer;
 
@@ -84,6 +85,9 @@ public:
 	/** For contexts outside the normal butler refill loop (allocates temporary working buffers) */
 	int do_refill_with_alloc (bool partial_fill, bool reverse);
 
+	/** Queue reads of the file data that the next do_refill() is going to use */
+	LIBARDOUR_API void prefetch (ReadAhead&);
+
 	LIBARDOUR_API bool pending_overwrite () const;
 
 	/* Working buffers for do_refill (butler thread) */
@@ -235,6 +239,7 @@ private:
 
 	int refill (Sample* sum_buffer, Sample* mixdown_buffer, float* gain_buffer, samplecnt_t fill_level, bool reversed);
 	int refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gain_buffer, samplecnt_t fill_level, bool reversed);
+	samplecnt_t refill_read_size (samplecnt_t total_space) const;
 
 	sampleoffset_t calculate_playback_distance (pframes_t);
 
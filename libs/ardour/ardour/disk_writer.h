@@ -102,6 +102,18 @@ public:
 
 	float buffer_load () const;
 
+	/** Number of write-latency histogram buckets. Bucket 0 counts writes
+	 * that took less than 1 ms, bucket n > 0 writes of [2^(n-1), 2^n) ms,
+	 * and the last bucket all slower writes.
+	 */
+	static const size_t write_latency_buckets = 12;
+
+	/** @return histogram of the time taken to write captured audio to disk */
+	std::vector<int32_t> write_latency () const;
+	/** @return longest time taken to write captured audio, in microseconds */
+	int64_t max_write_latency () const { return _max_write_latency.load (); }
+	void reset_write_latency ();
+
 	int seek (samplepos_t sample, bool complete_refill);
 
 	static PBD::Signal<void()> Overrun;
@@ -167,6 +179,10 @@ private:
 
 	void loop (samplepos_t);
 
+	samplecnt_t write_audio (std::shared_ptr<AudioFileSource> const&, Sample const*, samplecnt_t);
+	void        record_write_latency (int64_t usec);
+	std::string write_latency_summary () const;
+
 	CaptureInfos                 capture_info;
 	mutable Glib::Threads::Mutex capture_info_lock;
 
@@ -195,6 +211,9 @@ private:
 	std::atomic<int> _num_captured_loops;
 	std::atomic<int> _reset_last_capture_sources;
 
+	std::atomic<int32_t> _write_latency[write_latency_buckets];
+	std::atomic<int64_t> _max_write_latency;
+
 	std::shared_ptr<SMFSource> _midi_write_source;
 
 	std::list<std::shared_ptr<Source> >            _last_capture_sources;
@@ -159,6 +159,8 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 	int  post_process ();
 	void finish_timespan ();
 
+	std::shared_ptr<RouteList const> export_sinks () const;
+
 	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
 	ExportTimespanPtr     current_timespan;
 	TimespanBounds        timespan_bounds;
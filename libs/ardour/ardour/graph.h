@@ -34,6 +34,7 @@
 #include "pbd/semutils.h"
 
 #include "ardour/audio_backend.h"
+#include "ardour/graphnode.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/session_handle.h"
 #include "ardour/types.h"
@@ -47,6 +48,7 @@ class Graph;
 class IOPlug;
 class Route;
 class RTTaskList;
+class RTSubTaskList;
 class Session;
 class GraphEdges;
 
@@ -83,7 +85,7 @@ public:
 	uint32_t n_threads () const;
 
 	/* called by GraphNode */
-	void trigger (ProcessNode* n);
+	bool trigger (ProcessNode* n);
 	void reached_terminal_node ();
 
 	/* called by virtual GraphNode::process() */
@@ -92,6 +94,7 @@ public:
 
 	/* RTTasks */
 	void process_tasklist (RTTaskList const&);
+	void process_subtasks (RTSubTaskList&);
 
 protected:
 	virtual void session_going_away ();
@@ -105,6 +108,23 @@ private:
 
 	void helper_thread ();
 
+	/** A trigger-queue entry that lets a graph thread help to process an
+	 * RTSubTaskList. It is owned by the graph, because it may remain
+	 * queued after the list has been processed.
+	 */
+	struct SubTaskHelper : public ProcessNode {
+		SubTaskHelper () : list (0), queued (false) {}
+
+		void prep (GraphChain const*) {}
+		void run (GraphChain const*);
+
+		std::atomic<RTSubTaskList*> list;
+		std::atomic<bool>           queued;
+	};
+
+	static const size_t max_subtask_helpers = 32;
+	SubTaskHelper       _subtask_helpers[max_subtask_helpers];
+
 	PBD::MPMCQueue<ProcessNode*> _trigger_queue;      ///< nodes that can be processed
 	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue
 
@@ -21,6 +21,8 @@
 #ifndef __IEC2PPMDSP_H
 #define __IEC2PPMDSP_H
 
+#include <stdint.h>
+
 #include "ardour/libardour_visibility.h"
 
 class LIBARDOUR_API Iec2ppmdsp
@@ -36,6 +38,12 @@ public:
 
     static void init (float fsamp);
 
+    /** Process @a n_meters meters, @a p holds one buffer for each.
+     * Four meters are processed at a time, by the runtime selected
+     * (SIMD) ARDOUR::ppm_process function.
+     */
+    static void process (Iec2ppmdsp* const* m, float const* const* p, uint32_t n_meters, int n);
+
 private:
 
     float          _z1;          // filter state
@@ -21,6 +21,8 @@
 #ifndef __KMETERDSP_H
 #define __KMETERDSP_H
 
+#include <stdint.h>
+
 #include "ardour/libardour_visibility.h"
 
 class LIBARDOUR_API Kmeterdsp
@@ -36,8 +38,16 @@ public:
 
     static void init (int fsamp);
 
+    /** Process @a n_meters meters, @a p holds one buffer for each.
+     * Four meters are processed at a time, by the runtime selected
+     * (SIMD) ARDOUR::kmeter_process function.
+     */
+    static void process (Kmeterdsp* const* m, float const* const* p, uint32_t n_meters, int n);
+
 private:
 
+    void store (float z1, float z2);
+
     float          _z1;          // filter state
     float          _z2;          // filter state
     float          _rms;         // max rms value since last read()
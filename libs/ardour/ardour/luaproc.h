@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <set>
 #include <vector>
 #include <string>
@@ -35,7 +36,9 @@
 #  include "pbd/reallocpool.h"
 #endif
 
+#include "pbd/spinlock.h"
 #include "pbd/stateful.h"
+#include "pbd/timing.h"
 
 #include "ardour/types.h"
 #include "ardour/plugin.h"
@@ -128,6 +131,15 @@ public:
 	DSP::DspShm* instance_shm () { return &lshm; }
 	LuaTableRef* instance_ref () { return &lref; }
 
+	/* per instance DSP statistics */
+	bool   get_stats (PBD::microseconds_t& min, PBD::microseconds_t& max, double& avg, double& dev) const;
+	void   clear_stats ();
+	size_t mem_used () const { return _mem_used.load (); }
+	size_t mem_peak () const { return _mem_peak.load (); }
+
+	/** Run pending garbage collection of all instances, called by the butler */
+	static void collect_garbage_pending ();
+
 	struct FactoryPreset {
 		std::string               name;
 		std::map<uint32_t, float> param;
@@ -166,6 +178,39 @@ private:
 	bool _connect_all_audio_outputs;
 	bool _set_time_info;
 
+	/* arguments passed to the DSP function, allocated once and
+	 * re-used every cycle (see connect_and_run) */
+	luabridge::LuaRef * _lua_time;
+	luabridge::LuaRef * _lua_in_map;
+	luabridge::LuaRef * _lua_out_map;
+	luabridge::LuaRef * _lua_midi_sink;
+
+	std::vector<float*> _in_map_cache;
+	std::vector<float*> _out_map_cache;
+
+	void setup_dsp_args ();
+	void clear_dsp_args ();
+
+	/* The collector of the DSP Lua state does not run in the process
+	 * thread. connect_and_run() requests a step when the script allocated
+	 * memory, and the butler runs it (see collect_garbage_pending).
+	 * _dsp_lock serializes DSP and collection.
+	 */
+	PBD::spinlock_t   _dsp_lock;
+	std::atomic<bool> _gc_pending;
+	int               _gc_mem_kb;
+	bool              _time_looping;
+
+	void collect_garbage_step ();
+
+	static std::atomic<int> _gc_requests;
+
+	/* statistics, updated in the process thread */
+	PBD::TimingStats    _timing_stats;
+	std::atomic<int>    _stat_reset;
+	std::atomic<size_t> _mem_used;
+	std::atomic<size_t> _mem_peak;
+
 	void queue_draw () { QueueDraw(); /* EMIT SIGNAL */ }
 	DSP::DspShm lshm;
 
@@ -19,7 +19,6 @@
 #define _lufs_meter_h_
 
 #include <cstdint>
-#include <functional>
 #include <map>
 
 #include "pbd/stack_allocator.h"
@@ -50,9 +49,6 @@ private:
 	float sumfrag (uint32_t) const;
 
 	void  calc_true_peak (float const** data, const uint32_t n_samples);
-	float upsample_x4 (int chn, float const x);
-	float upsample_x2 (int chn, float const x);
-	std::function< float(int, const float) > upsample;
 
 	const float _g[5] = { 1.0, 1.0, 1.0, 1.41, 1.41 };
 
@@ -61,10 +57,12 @@ private:
 	uint32_t _n_channels;
 	uint32_t _n_fragment;
 
-	/* filter coeff */
-	float _a0, _a1, _a2;
-	float _b1, _b2;
-	float _c3, _c4;
+	/* filter coeff: a0, a1, a2, b1, b2, c3, c4 */
+	float _coeff[7];
+
+	/* true-peak upsampling */
+	float const* _tp_coeff;
+	uint32_t     _tp_phases;
 
 	/* state */
 	uint32_t _frag_pos;
@@ -97,7 +95,7 @@ private:
 	};
 
 	FilterState _fst[5];
-	float*      _z[5];
+	float*      _z[5]; ///< true-peak, history followed by the current block
 };
 
 } // namespace ARDOUR
@@ -25,6 +25,7 @@
 #define __ardour_lv2_plugin_h__
 
 #include <glibmm/threads.h>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -368,6 +369,10 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 	bool _was_activated;
 	bool _has_state_interface;
 
+	/* (de)activation requested while the state is restored asynchronously */
+	bool _activation_deferred;
+	bool _activate_after_restore;
+
 	const std::string plugin_dir () const;
 	const std::string scratch_dir () const;
 	const std::string file_dir () const;
@@ -396,6 +401,7 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 	samplecnt_t plugin_latency () const;
 
 	void latency_compute_run ();
+	void restore_done ();
 	std::string do_save_preset (std::string);
 	void do_remove_preset (std::string);
 	void find_presets ();
@@ -410,7 +416,10 @@ public:
 	LV2PluginInfo (const char* plugin_uri);
 	~LV2PluginInfo ();
 
-	static PluginInfoList* discover (std::function <void (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool)> cb);
+	typedef std::function <void (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool)> ScanLogCallback;
+
+	/** @param use_index list plugins from the persistent index, if it is still valid */
+	static PluginInfoList* discover (ScanLogCallback cb, bool use_index = true);
 
 	PluginPtr load (Session& session);
 	std::vector<Plugin::PresetRecord> get_presets (bool user_only) const;
@@ -422,6 +431,9 @@ public:
 	char * _plugin_uri;
 
 private:
+	static PluginInfoList* read_index (std::vector<std::string>& dirs, ScanLogCallback cb);
+	static void write_index (PluginInfoList const&, std::vector<std::string> const& dirs, std::map<std::string, std::string> const& bundles, XMLNode* scan_log);
+
 	bool _is_instrument;
 	bool _is_utility;
 	bool _is_analyzer;
@@ -39,6 +39,7 @@ namespace ARDOUR {
 
 class BufferSet;
 class ChanCount;
+class MeterSnapshot;
 class Session;
 
 /** Meters peaks on the input and stores them for access.
@@ -80,8 +81,35 @@ public:
 	ChanCount input_streams ()  const { return current_meters; }
 	ChanCount output_streams () const { return current_meters; }
 
+	/** @return the level of channel @a n, as published at the end of
+	 * the last process cycle (see MeterSnapshot).
+	 */
 	float meter_level (uint32_t n, MeterType type);
 
+	/** Copy the published levels of all channels to @a levels, with
+	 * MeterSnapshot::NValues per channel. This is cheaper than calling
+	 * meter_level() for every channel and type.
+	 *
+	 * @param seq the snapshot sequence number of the previous read,
+	 * updated on return. Set it to 0 to force a read.
+	 * @param reader the id returned by add_level_reader(), if any
+	 * @return false if @a levels is unchanged, because no new levels
+	 * were published since @a seq, or no consistent copy could be made
+	 */
+	bool read_levels (std::vector<float>& levels, uint64_t& seq, int reader = -1);
+
+	/** Register a periodic consumer of read_levels(). The K/IEC/VU
+	 * maxima are held until every registered reader has read them.
+	 * Without registered readers, any read restarts the hold.
+	 *
+	 * @return reader id, or -1 if no more readers can be registered
+	 */
+	int  add_level_reader ();
+	void remove_level_reader (int reader);
+
+	/** @return the level of channel @a n from @a levels (see read_levels) */
+	float level_of (std::vector<float> const& levels, uint32_t n, MeterType type) const;
+
 	void      set_meter_type (MeterType t);
 	MeterType meter_type () const { return _meter_type; }
 
@@ -113,7 +141,25 @@ private:
 	std::vector<Iec2ppmdsp*> _iec2meter;
 	std::vector<Vumeterdsp*> _vumeter;
 
+	std::vector<float const*> _audio_data; ///< used by run (), one buffer per audio channel
+
 	MeterType _meter_type;
+
+	void write_snapshot ();
+	bool read_channel (uint32_t n, float* v) const;
+	void levels_read (int reader);
+
+	template <typename ChannelValues>
+	float level (uint32_t n, MeterType type, ChannelValues const& channel) const;
+
+	std::shared_ptr<MeterSnapshot> _snapshot;
+	int32_t                        _snapshot_slot;
+	uint32_t                       _snapshot_channels;
+	std::atomic<bool>              _snapshot_reset; ///< restart the K/IEC/VU hold
+	std::atomic<uint32_t>          _level_readers;  ///< registered readers, one bit each
+	std::atomic<uint32_t>          _levels_read;    ///< readers that read since the last restart
+	samplecnt_t                    _hold_samples;   ///< since the last restart, see write_snapshot ()
+
 };
 
 } // namespace ARDOUR
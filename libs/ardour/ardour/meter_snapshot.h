@@ -0,0 +1,118 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include <stdint.h>
+
+#include <glibmm/threads.h>
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+/** Levels of all meters of a session, published once per process cycle.
+ *
+ * Every PeakMeter owns a slot of NValues floats per channel. Meters
+ * write their levels into the back buffer during run(), and at the end
+ * of each cycle the session copies the back buffer to the front buffer,
+ * from which the GUI, control surfaces etc. read.
+ *
+ * The sequence number is odd while the front buffer is being updated.
+ * Readers use it to detect and retry inconsistent reads, and may
+ * compare it with a previously seen value to skip work when no new
+ * levels were published.
+ *
+ * Storage is only grown, by replacing it. Replaced storage is kept
+ * until the snapshot is destroyed, since the process thread may still
+ * use it during the current cycle.
+ */
+class LIBARDOUR_API MeterSnapshot
+{
+public:
+	enum Value {
+		Peak,    ///< peak power in dB (0..1 for MIDI)
+		MaxPeak, ///< peak signal since last reset, coefficient
+		KRms,    ///< coefficient
+		IEC1,    ///< coefficient
+		IEC2,    ///< coefficient
+		VU,      ///< coefficient
+		NValues
+	};
+
+	MeterSnapshot ();
+	~MeterSnapshot ();
+
+	/** Allocate a slot for @a n_channels channels
+	 * @return offset of the slot, or -1 if @a n_channels is zero
+	 */
+	int32_t allocate (uint32_t n_channels);
+	void    release (int32_t slot, uint32_t n_channels);
+
+	/** @return the values of @a slot, to be written in the process thread
+	 * by the owner of the slot only.
+	 */
+	float* back (int32_t slot) const {
+		return &_storage.load (std::memory_order_acquire)->back[slot];
+	}
+
+	/** Make the levels written during this cycle visible to readers
+	 * (called by the session at the end of each process cycle).
+	 */
+	void publish ();
+
+	uint64_t sequence () const {
+		return _sequence.load (std::memory_order_acquire);
+	}
+
+	/** Copy @a n published values starting at @a offset to @a dst
+	 * @param seq if not NULL, set to the sequence number of the copy
+	 * @return false if the range is invalid, or no consistent copy could be made
+	 */
+	bool read (uint32_t offset, uint32_t n, float* dst, uint64_t* seq = 0) const;
+
+private:
+	MeterSnapshot (MeterSnapshot const&);
+	MeterSnapshot& operator= (MeterSnapshot const&);
+
+	struct Storage {
+		Storage (uint32_t c)
+			: capacity (c)
+			, back (c)
+			, front (c)
+		{}
+
+		uint32_t const     capacity;
+		std::vector<float> back;
+		std::vector<float> front;
+	};
+
+	void reset_slot (Storage*, uint32_t offset, uint32_t size);
+
+	std::atomic<Storage*> _storage;
+	std::atomic<uint32_t> _used; ///< end of the highest allocated slot
+	std::atomic<uint64_t> _sequence;
+
+	Glib::Threads::Mutex         _lock;
+	std::map<uint32_t, uint32_t> _free; ///< offset -> size, below _used
+	std::vector<Storage*>        _retired;
+};
+
+} // namespace ARDOUR
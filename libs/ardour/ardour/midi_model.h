@@ -140,6 +140,8 @@ public:
 			return !_added_notes.empty() || !_removed_notes.empty();
 		}
 
+		size_t memory_size () const;
+
 		NoteDiffCommand& operator+= (const NoteDiffCommand& other);
 
 		static Variant get_value (const NotePtr note, Property prop);
@@ -194,6 +196,8 @@ public:
 
 		void change (std::shared_ptr<Evoral::Event<TimeType> >, TimeType);
 
+		size_t memory_size () const;
+
 	private:
 		struct Change {
 			Change () : sysex_id (0) {}
@@ -231,6 +235,8 @@ public:
 		void change_program (PatchChangePtr, uint8_t);
 		void change_bank (PatchChangePtr, int);
 
+		size_t memory_size () const;
+
 		enum Property {
 			Time,
 			Channel,
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <time.h>
 #include <glibmm/threads.h>
@@ -186,7 +187,14 @@ class LIBARDOUR_API MidiSource : virtual public Source
 
 	void set_note_mode(const WriterLock& lock, NoteMode mode);
 
-	std::shared_ptr<MidiModel> model() { return _model; }
+	/** @return the model of this source. If loading the model was deferred,
+	 * it is loaded first, so this must not be called with the source lock held.
+	 * Loading emits ModelChanged in the calling thread, so realtime and butler
+	 * code must use has_model() instead.
+	 */
+	std::shared_ptr<MidiModel> model();
+	/** @return true if the model exists, without loading a deferred model */
+	bool has_model() const { return !_model_deferred.load () && _model; }
 	void set_model(const WriterLock& lock, std::shared_ptr<MidiModel>);
 	void drop_model(const WriterLock& lock);
 
@@ -231,6 +239,8 @@ class LIBARDOUR_API MidiSource : virtual public Source
 	                                  timecnt_t const &            cnt) = 0;
 
 	std::shared_ptr<MidiModel> _model;
+	/** true if the model is to be loaded by the first call to model() */
+	std::atomic<bool>            _model_deferred;
 	bool                         _writing;
 
 	/** The total duration of the current capture. */
@@ -33,6 +33,13 @@ extern "C" {
 }
 
 LIBARDOUR_API void x86_sse_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API float x86_sse_resample_filter        (float const* p1, float const* p2, float const* q1, float const* q2, float a, float b, uint32_t hl);
+
+LIBARDOUR_API void x86_sse_kmeter_process          (float const* const* buf, float* z1, float* z2, uint32_t nframes, float omega);
+LIBARDOUR_API void x86_sse_ppm_process             (float const* const* buf, float* z1, float* z2, float* m, uint32_t nframes, float w1, float w2, float w3);
+LIBARDOUR_API void x86_sse_vumeter_process         (float const* const* buf, float* z1, float* z2, float* m, uint32_t nframes, float w);
+LIBARDOUR_API void x86_sse_kweight_process         (float const* const* buf, float* z, float* sum, uint32_t nframes, float const* coeff);
+LIBARDOUR_API float x86_sse_compute_true_peak      (float const* buf, uint32_t nframes, float const* coeff, uint32_t n_phases, float current);
 
 extern "C" {
 /* AVX functions */
@@ -52,6 +59,7 @@ LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint3
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
 LIBARDOUR_API void  x86_fma_mix_buffers_with_gain       (float* dst, float const* src, uint32_t nframes, float gain);
+LIBARDOUR_API float x86_fma_resample_filter             (float const* p1, float const* p2, float const* q1, float const* q2, float a, float b, uint32_t hl);
 #endif
 
 /* AVX512F functions */
@@ -62,6 +70,7 @@ LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain   (float* dst, float const
 LIBARDOUR_API void  x86_avx512f_mix_buffers_no_gain     (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_copy_vector             (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API float x86_avx512f_resample_filter         (float const* p1, float const* p2, float const* q1, float const* q2, float a, float b, uint32_t hl);
 #endif
 
 /* debug wrappers for SSE functions */
@@ -93,7 +102,15 @@ extern "C" {
 	LIBARDOUR_API void  arm_neon_find_peaks            (float const* src, uint32_t nframes, float* minf, float* maxf);
 	LIBARDOUR_API void  arm_neon_mix_buffers_no_gain   (float* dst, float const* src, uint32_t nframes);
 	LIBARDOUR_API void  arm_neon_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain);
+	LIBARDOUR_API float arm_neon_resample_filter       (float const* p1, float const* p2, float const* q1, float const* q2, float a, float b, uint32_t hl);
 }
+#ifdef __aarch64__
+LIBARDOUR_API void arm_neon_kmeter_process         (float const* const* buf, float* z1, float* z2, uint32_t nframes, float omega);
+LIBARDOUR_API void arm_neon_ppm_process            (float const* const* buf, float* z1, float* z2, float* m, uint32_t nframes, float w1, float w2, float w3);
+LIBARDOUR_API void arm_neon_vumeter_process        (float const* const* buf, float* z1, float* z2, float* m, uint32_t nframes, float w);
+LIBARDOUR_API void arm_neon_kweight_process        (float const* const* buf, float* z, float* sum, uint32_t nframes, float const* coeff);
+LIBARDOUR_API float arm_neon_compute_true_peak     (float const* buf, uint32_t nframes, float const* coeff, uint32_t n_phases, float current);
+#endif
 #endif
 
 /* non-optimized functions */
@@ -105,3 +122,10 @@ LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDO
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 
+LIBARDOUR_API void  default_kmeter_process            (ARDOUR::Sample const* const* buf, float* z1, float* z2, ARDOUR::pframes_t nframes, float omega);
+LIBARDOUR_API void  default_ppm_process               (ARDOUR::Sample const* const* buf, float* z1, float* z2, float* m, ARDOUR::pframes_t nframes, float w1, float w2, float w3);
+LIBARDOUR_API void  default_vumeter_process           (ARDOUR::Sample const* const* buf, float* z1, float* z2, float* m, ARDOUR::pframes_t nframes, float w);
+
+LIBARDOUR_API void  default_kweight_process           (ARDOUR::Sample const* const* buf, float* z, float* sum, ARDOUR::pframes_t nframes, float const* coeff);
+LIBARDOUR_API float default_compute_true_peak         (ARDOUR::Sample const* buf, ARDOUR::pframes_t nframes, float const* coeff, uint32_t n_phases, float current);
+
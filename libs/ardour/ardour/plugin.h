@@ -23,6 +23,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <set>
 #include <string>
@@ -87,6 +88,18 @@ public:
 	virtual void set_insert_id (PBD::ID id) {}
 	virtual void set_state_dir (const std::string& d = "") {}
 
+	/** While an instance of this class exists, plugins may restore
+	 * their state on worker threads, concurrently with other plugins.
+	 * This is only used while loading a session, before plugins are
+	 * processed. The destructor waits until all plugins are restored.
+	 */
+	class LIBARDOUR_API ConcurrentRestore
+	{
+	public:
+		ConcurrentRestore ();
+		~ConcurrentRestore ();
+	};
+
 	void set_insert (PlugInsertBase* pib, uint32_t num) {
 		_pib = pib;
 		_num = num;
@@ -417,6 +430,28 @@ protected:
 	 */
 	void state_changed ();
 
+	/** Call @a work on a worker thread if a ConcurrentRestore is
+	 * in progress, and @a done on the thread that started it, once all
+	 * work has completed. Otherwise both are called immediately.
+	 *
+	 * @a work must only access this plugin instance. Work items with
+	 * the same @a library (plugin binary) are not run concurrently.
+	 */
+	void restore_async (std::function<void()> work, std::function<void()> done, std::string const& library = "");
+	/** Wait until queued restore work of plugins loaded from @a library
+	 * has completed. Call before instantiating another plugin from it,
+	 * since plugin standards (e.g. LV2) do not allow to call discovery
+	 * or instantiation functions concurrently with other functions of
+	 * the same library.
+	 */
+	static void wait_for_library_restore (std::string const& library);
+	/** @return true while work queued by restore_async() has not completed */
+	bool restore_pending () const { return _pending_restores.load () > 0; }
+	/** Wait until work queued by restore_async() has completed */
+	void wait_for_restore () const;
+	/** Wait for queued work, and drop the pending done callback (used when destroying the plugin) */
+	void cancel_restore ();
+
 	ARDOUR::AudioEngine& _engine;
 	ARDOUR::Session&     _session;
 	PluginInfoPtr        _info;
@@ -456,6 +491,8 @@ private:
 	PlugInsertBase* _pib;
 	uint32_t        _num;
 
+	std::atomic<int> _pending_restores;
+
 	PBD::ScopedConnection _preset_connection;
 };
 
@@ -50,6 +50,7 @@ namespace ARDOUR {
 class Session;
 class Route;
 class Plugin;
+class RTSubTaskList;
 
 /** Plugin inserts: send data through a plugin
  */
@@ -369,6 +370,7 @@ private:
 
 	bool sanitize_maps ();
 	bool check_inplace ();
+	bool check_parallel_replicas () const;
 	void mapping_changed ();
 
 	void add_plugin (std::shared_ptr<Plugin>);
@@ -390,6 +392,26 @@ private:
 	PBD::TimingStats  _timing_stats;
 	std::atomic<int> _stat_reset;
 	std::atomic<int> _flush;
+
+	/* in-place processing of replicated instances in parallel */
+	struct ReplicaArgs {
+		BufferSet*         bufs;
+		PinMappings const* in_map;
+		PinMappings const* out_map;
+		samplepos_t        start;
+		samplepos_t        end;
+		double             speed;
+		pframes_t          nframes;
+		samplecnt_t        offset;
+	};
+
+	void setup_replica_tasks ();
+	void run_replica (uint32_t pc);
+
+	std::unique_ptr<RTSubTaskList> _replica_tasks;
+	ReplicaArgs                    _replica_args;
+	std::atomic<bool>              _parallel_replicas;
+	std::atomic<bool>              _replica_failed;
 };
 
 } // namespace ARDOUR
@@ -27,10 +27,12 @@
 #include "libardour-config.h"
 #endif
 
+#include <functional>
 #include <list>
 #include <map>
 #include <string>
 #include <set>
+#include <vector>
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -340,14 +342,28 @@ private:
 #endif
 
 	void lv2_plugin (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool);
-	void lv2_refresh ();
+	void lv2_refresh (bool cache_only = false);
+
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+	struct ScannerJob;
+
+	/* path -> scanner result, for modules scanned by vst2_prescan() or vst3_prescan() */
+	std::map<std::string, bool> _scanner_results;
+
+	uint32_t max_concurrent_scans () const;
+	void run_scanner_apps (std::string const& bin_path, std::vector<ScannerJob*> const&,
+	                       std::function<void(std::string const&, PSLEPtr)> prepare,
+	                       std::function<void(std::string const&)> abort);
+	bool prescanned (std::string const& path, bool& ok);
+#endif
 
 	int windows_vst_discover_from_path (std::string path, bool cache_only = false);
 	int mac_vst_discover_from_path (std::string path, std::set<std::string>&, bool cache_only = false);
 	int lxvst_discover_from_path (std::string path, bool cache_only = false);
 #if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
 	bool vst2_plugin (std::string const& module_path, ARDOUR::PluginType, VST2Info const&);
-	bool run_vst2_scanner_app (std::string bundle_path, PSLEPtr) const;
+	bool run_vst2_scanner_app (std::string bundle_path, PSLEPtr);
+	void vst2_prescan (std::vector<std::string> const&, ARDOUR::PluginType);
 	int vst2_discover (std::string path, ARDOUR::PluginType, bool cache_only = false);
 #endif
 
@@ -355,7 +371,8 @@ private:
 	int vst3_discover (std::string const& path, bool cache_only = false);
 #ifdef VST3_SUPPORT
 	void vst3_plugin (std::string const&, std::string const&, VST3Info const&);
-	bool run_vst3_scanner_app (std::string bundle_path, PSLEPtr) const;
+	bool run_vst3_scanner_app (std::string bundle_path, PSLEPtr);
+	void vst3_prescan (std::vector<std::string> const&);
 #endif
 
 	int ladspa_discover (std::string path);
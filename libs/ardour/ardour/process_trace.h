@@ -0,0 +1,126 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include <stdint.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/session_object.h"
+
+namespace ARDOUR {
+
+/** Opt-in recorder of process execution, written as a Chrome/Perfetto
+ * "Trace Event Format" JSON file (open with chrome://tracing or
+ * https://ui.perfetto.dev).
+ *
+ * Every thread that records events must call thread_init() once,
+ * outside of any realtime context. Events are then stored in a
+ * per-thread lock-free ringbuffer, without allocating memory. While
+ * recording, a background thread periodically collects the events
+ * and appends them to the trace file. Events are dropped if a
+ * ringbuffer overflows.
+ *
+ * When recording is not active, Scope only performs a single
+ * relaxed atomic load.
+ */
+class LIBARDOUR_API ProcessTrace
+{
+public:
+	enum Category {
+		Cycle,
+		GraphNode,
+		Processor,
+		Butler,
+		IOTask,
+	};
+
+	/** Register the calling thread, using @a name in the trace */
+	static void thread_init (std::string const& name);
+
+	/** Start recording to the file at @a path */
+	static bool start (std::string const& path);
+	/** Stop recording and complete the trace file */
+	static void stop ();
+
+	static bool active () {
+		return _active.load (std::memory_order_relaxed);
+	}
+
+	/** @return number of events that were dropped since start() */
+	static uint64_t dropped () {
+		return _dropped.load ();
+	}
+
+	static int64_t now ();
+	static void    record (Category, char const* name, int64_t start, int64_t end);
+
+	/** Record the lifetime of this object as an event */
+	class Scope
+	{
+	public:
+		Scope (Category c, char const* name)
+			: _name (0)
+		{
+			if (active ()) {
+				_category = c;
+				_name     = name;
+				_start    = now ();
+			}
+		}
+
+		/** The name of @a obj is copied, since it may be renamed
+		 * while the scope is alive.
+		 */
+		Scope (Category c, SessionObject const& obj)
+			: _name (0)
+		{
+			if (active ()) {
+				obj.copy_name (_buf, sizeof (_buf));
+				_category = c;
+				_name     = _buf;
+				_start    = now ();
+			}
+		}
+
+		~Scope ()
+		{
+			if (_name) {
+				record (_category, _name, _start, now ());
+			}
+		}
+
+	private:
+		Scope (Scope const&);
+		Scope& operator= (Scope const&);
+
+		Category    _category;
+		char const* _name;
+		int64_t     _start;
+		char        _buf[48];
+	};
+
+private:
+	static void writer_thread ();
+
+	static std::atomic<bool>     _active;
+	static std::atomic<uint64_t> _dropped;
+};
+
+} // namespace ARDOUR
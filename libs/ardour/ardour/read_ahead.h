@@ -0,0 +1,79 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <stdint.h>
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+/** Batched, asynchronous read-ahead of file data.
+ *
+ * The butler collects the file ranges that the following refill of all
+ * disk-readers is going to read, and submits them at once. On Linux,
+ * io_uring is used to have all reads in flight at the same time, so that
+ * the refill afterwards is served from the page cache.
+ *
+ * If io_uring is not available, available() is false and the butler reads
+ * synchronously, as before.
+ *
+ * An instance must only be used by a single thread.
+ */
+class LIBARDOUR_API ReadAhead
+{
+public:
+	ReadAhead ();
+	~ReadAhead ();
+
+	bool available () const { return _ring != 0; }
+
+	/** Queue a read of @a len bytes at @a offset of file descriptor @a fd */
+	void add (int fd, int64_t offset, size_t len);
+
+	/** Submit all queued reads and wait for them to complete
+	 * @return number of bytes that were read
+	 */
+	size_t run ();
+
+private:
+	ReadAhead (ReadAhead const&);
+	ReadAhead& operator= (ReadAhead const&);
+
+	struct Request {
+		Request (int f, int64_t o, size_t l)
+			: fd (f)
+			, offset (o)
+			, len (l)
+		{}
+
+		int     fd;
+		int64_t offset;
+		size_t  len;
+	};
+
+	struct Ring;
+
+	Ring*                _ring;
+	std::vector<Request> _queue;
+	char*                _sink;
+};
+
+} // namespace ARDOUR
@@ -436,6 +436,9 @@ public:
 	void set_processor_state (const XMLNode&, int version);
 	virtual bool set_processor_state (XMLNode const & node, int version, XMLProperty const* prop, ProcessorList& new_order, bool& must_configure);
 
+	/** true if plugins of this (inactive) route have not been instantiated yet */
+	bool has_deferred_processors () const { return _deferred_processor_state != 0; }
+
 	std::weak_ptr<Route> weakroute ();
 
 	int save_as_template (const std::string& path, const std::string& name, const std::string& description );
@@ -717,6 +720,9 @@ private:
 	int set_state_2X (const XMLNode&, int);
 	void set_processor_state_2X (XMLNodeList const &, int);
 
+	void load_deferred_processors ();
+	XMLNode* deferred_processor_state (bool save_template) const;
+
 	void input_change_handler (IOChange, void *src);
 	void output_change_handler (IOChange, void *src);
 	void sidechain_change_handler (IOChange, void *src);
@@ -797,6 +803,12 @@ private:
 	bool    _in_sidechain_setup;
 	gain_t  _monitor_gain;
 
+	/* processor state of an inactive route, whose plugins are only
+	 * instantiated when the route is activated.
+	 */
+	XMLNode* _deferred_processor_state;
+	int      _deferred_processor_version;
+
 	void add_well_known_ctrl (WellKnownCtrl, std::shared_ptr<PluginInsert>, int param);
 	void add_well_known_ctrl (WellKnownCtrl);
 
@@ -19,8 +19,11 @@
 #ifndef _ardour_rt_tasklist_h_
 #define _ardour_rt_tasklist_h_
 
+#include <atomic>
 #include <vector>
 
+#include "pbd/semutils.h"
+
 #include "ardour/libardour_visibility.h"
 #include "ardour/rt_task.h"
 
@@ -44,5 +47,34 @@ private:
 	std::shared_ptr<Graph> _graph;
 };
 
+/** A list of tasks that can be processed in parallel from within a
+ * process-graph node (e.g. by a processor of a route), using graph
+ * threads that are idle at the time. Unlike RTTaskList, tasks are
+ * retained, so that the list can be set up once and processed every
+ * cycle without allocating memory.
+ */
+class LIBARDOUR_API RTSubTaskList
+{
+public:
+	RTSubTaskList (Graph*);
+
+	void push_back (std::function<void ()> fn);
+	void clear () { _tasks.clear (); }
+	size_t size () const { return _tasks.size (); }
+
+	/** process tasks in parallel, wait for them to complete */
+	void process ();
+
+private:
+	friend class Graph;
+
+	void run_tasks ();
+
+	std::vector<std::function<void ()> > _tasks;
+	Graph*                                _graph;
+	std::atomic<size_t>                   _next;
+	PBD::Semaphore                        _helpers_done;
+};
+
 } // namespace ARDOUR
 #endif
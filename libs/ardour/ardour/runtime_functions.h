@@ -31,11 +31,25 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 
+	/* meter ballistics, each call processes four channels (see Kmeterdsp::process) */
+	typedef void  (*kmeter_process_t)        (const ARDOUR::Sample * const *, float *, float *, pframes_t, float);
+	typedef void  (*ppm_process_t)           (const ARDOUR::Sample * const *, float *, float *, float *, pframes_t, float, float, float);
+	typedef void  (*vumeter_process_t)       (const ARDOUR::Sample * const *, float *, float *, float *, pframes_t, float);
+
+	/* loudness measurement (see LUFSMeter::process, LUFSMeter::calc_true_peak) */
+	typedef void  (*kweight_process_t)       (const ARDOUR::Sample * const *, float *, float *, pframes_t, const float *);
+	typedef float (*compute_true_peak_t)     (const ARDOUR::Sample *, pframes_t, const float *, uint32_t, float);
+
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
 	LIBARDOUR_API extern apply_gain_to_buffer_t  apply_gain_to_buffer;
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+	LIBARDOUR_API extern kmeter_process_t        kmeter_process;
+	LIBARDOUR_API extern ppm_process_t           ppm_process;
+	LIBARDOUR_API extern vumeter_process_t       vumeter_process;
+	LIBARDOUR_API extern kweight_process_t       kweight_process;
+	LIBARDOUR_API extern compute_true_peak_t     compute_true_peak;
 }
 
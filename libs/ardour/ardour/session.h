@@ -151,6 +151,7 @@ class IOPlug;
 class IOProcessor;
 class IOTaskList;
 class ImportStatus;
+class MeterSnapshot;
 class MidiClockTicker;
 class MidiControlUI;
 class MidiPortManager;
@@ -333,7 +334,9 @@ public:
 	}
 
 	std::shared_ptr<RTTaskList> rt_tasklist () { return _rt_tasklist; }
+	Graph* process_graph () const { return _process_graph.get (); }
 	std::shared_ptr<IOTaskList> io_tasklist () { return _io_tasklist; }
+	std::shared_ptr<MeterSnapshot> meter_snapshot () const { return _meter_snapshot; }
 
 	RouteList get_routelist (bool mixer_order = false, PresentationInfo::Flag fl = PresentationInfo::MixerRoutes) const;
 
@@ -627,6 +630,7 @@ public:
 	int save_template (const std::string& template_name, const std::string& description = "", bool replace_existing = false);
 	int save_history (std::string snapshot_name = "");
 	int restore_history (std::string snapshot_name);
+	PBD::UndoTransaction* undo_transaction_from_state (XMLNode const&);
 	void remove_state (std::string snapshot_name);
 	void rename_state (std::string old_name, std::string new_name);
 	void remove_pending_capture_state ();
@@ -859,6 +863,7 @@ public:
 	std::shared_ptr<ExportStatus> get_export_status ();
 
 	int start_audio_export (samplepos_t position, bool realtime = false, bool region_export = false);
+	void set_export_routes (std::shared_ptr<RouteList const> sinks);
 
 	PBD::Signal<int(samplecnt_t)> ProcessExport;
 	static PBD::Signal<void(std::string, std::string, bool, samplepos_t)> Exported;
@@ -1529,6 +1534,9 @@ private:
 	bool _region_export;
 	samplepos_t _export_preroll;
 
+	std::shared_ptr<RouteList const> _export_routes;
+	std::shared_ptr<GraphChain>      _export_graph_chain;
+
 	std::shared_ptr<ExportHandler> export_handler;
 	std::shared_ptr<ExportStatus>  export_status;
 
@@ -1666,6 +1674,7 @@ private:
 	void remove_empty_sounds ();
 
 	void session_loaded ();
+	void preload_source_cache ();
 
 	void setup_midi_control ();
 	int  midi_read (MIDI::Port *);
@@ -2194,6 +2203,7 @@ private:
 	XMLNode& get_control_protocol_state () const;
 
 	void set_history_depth (uint32_t depth);
+	void set_history_memory_budget (uint32_t megabytes);
 
 	static bool _disable_all_loaded_plugins;
 	static bool _bypass_all_loaded_plugins;
@@ -2314,6 +2324,8 @@ private:
 
 	VCAManager* _vca_manager;
 
+	std::shared_ptr<MeterSnapshot> _meter_snapshot;
+
 	std::shared_ptr<Route> get_midi_nth_route_by_id (PresentationInfo::order_t n) const;
 
 	std::string created_with;
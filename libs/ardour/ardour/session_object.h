@@ -24,6 +24,7 @@
 #include "pbd/statefuldestructible.h"
 #include "pbd/signals.h"
 #include "pbd/properties.h"
+#include "pbd/spinlock.h"
 
 #include "ardour/ardour.h"
 #include "ardour/session_handle.h"
@@ -57,9 +58,21 @@ class LIBARDOUR_API SessionObject : public SessionHandleRef, public PBD::Statefu
 	Session&    session() const { return _session; }
 	std::string name()    const { return _name; }
 
+	/** Copy the name into @a buf of @a len bytes (truncated and
+	 * NUL terminated), without allocating memory. This is safe to use
+	 * in realtime context while set_name() is called in another thread.
+	 */
+	void copy_name (char* buf, size_t len) const {
+		PBD::SpinLock sl (_name_lock);
+		buf[_name.val ().copy (buf, len - 1)] = '\0';
+	}
+
 	virtual bool set_name (const std::string& str) {
 		if (_name != str) {
-			_name = str;
+			{
+				PBD::SpinLock sl (_name_lock);
+				_name = str;
+			}
 			PropertyChanged (PBD::PropertyChange (Properties::name));
 		}
 		return true;
@@ -67,6 +80,7 @@ class LIBARDOUR_API SessionObject : public SessionHandleRef, public PBD::Statefu
 
   protected:
 	PBD::Property<std::string> _name;
+	mutable PBD::spinlock_t    _name_lock;
 };
 
 } // namespace ARDOUR
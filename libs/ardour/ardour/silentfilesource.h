@@ -37,6 +37,7 @@ public:
 	void flush () {}
 
 	bool can_be_analysed() const { return false; }
+	bool cacheable () const { return false; }
 
 	bool clamped_at_unity() const { return false; }
 
@@ -92,10 +92,8 @@ public:
 	bool _open;
 	Temporal::Beats   _last_ev_time_beats;
 	samplepos_t       _last_ev_time_samples;
-	/** end time (start + duration) of last call to read_unlocked */
-	mutable timepos_t _smf_last_read_end;
-	/** time (in SMF ticks, 1 tick per _ppqn) of the last event read by read_unlocked */
-	mutable timepos_t _smf_last_read_time;
+	/** serializes reads from the file by read_unlocked, which only needs a shared source lock */
+	mutable Glib::Threads::Mutex _stream_lock;
 
 	int open_for_write ();
 
@@ -117,6 +115,11 @@ public:
 
 	void load_model_unlocked (bool force_reload=false);
 
+	bool model_can_be_deferred () const;
+	void scan_unlocked ();
+	void update_channel_info (uint8_t const* buf);
+	void set_length_from_file ();
+
 };
 
 }; /* namespace ARDOUR */
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <sndfile.h>
 
 #include "ardour/audiofilesource.h"
@@ -76,6 +78,14 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	static int get_soundfile_info (const std::string& path, SoundFileInfo& _info, std::string& error_msg);
 
+	/** Locate the bytes of the file that hold samples [start, start + cnt).
+	 * This is only possible for uncompressed files that are open for reading.
+	 * @return false if the data cannot be located
+	 */
+	bool file_extent (samplepos_t start, samplecnt_t cnt, int& fd, int64_t& offset, size_t& len) const;
+
+	void mark_streaming_write_completed (const WriterLock& lock, Temporal::timecnt_t const & duration);
+
   protected:
 	void close ();
 
@@ -91,7 +101,20 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	/* see file_extent() */
+	std::atomic<int> _fd;
+	int64_t          _data_offset;
+	int              _bytes_per_frame;
+
+	/* capture files are allocated ahead of the data, see preallocate() */
+	int     _write_fd;
+	bool    _preallocate;
+	int64_t _preallocated;
+
 	void init_sndfile ();
+	void locate_data (int fd);
+	void preallocate (samplepos_t end);
+	void trim_preallocation ();
 	int open();
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
 	void file_closed ();
@@ -0,0 +1,140 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace PBD {
+	class Thread;
+}
+
+namespace ARDOUR {
+
+class AudioSource;
+
+/** Process-wide cache of decoded audio source data.
+ *
+ * Sources are cached in blocks of samples, as they are read, up to a
+ * memory budget. If the budget is exceeded, the least recently used
+ * blocks are evicted. The cache can also be filled in the background,
+ * e.g. with the ranges of all regions of a session, so that playback
+ * and locates do not need to read from disk at all.
+ *
+ * Only immutable sources are cached (see AudioSource::cacheable()).
+ */
+class LIBARDOUR_API SourceCache
+{
+public:
+	static SourceCache& instance ();
+
+	/** Set the memory budget in bytes, 0 disables the cache and
+	 * releases all data
+	 */
+	void set_budget (size_t bytes);
+	bool enabled () const { return _budget.load () > 0; }
+
+	/** @return memory used by cached data, in bytes */
+	size_t used () const;
+
+	/** Data is cached in blocks of this many samples */
+	static const samplecnt_t block_samples = 65536;
+
+	/** Read from @a src, using cached data and caching what is read */
+	samplecnt_t read (AudioSource const& src, Sample* dst, samplepos_t start, samplecnt_t cnt);
+
+	/** Read uncached data: (dst, start, cnt) -> samples read */
+	typedef std::function<samplecnt_t (Sample*, samplepos_t, samplecnt_t)> Reader;
+
+	/** Read from the source with the given @a id and @a length, using
+	 * cached data, and @a reader for data that is not cached yet.
+	 */
+	samplecnt_t read (PBD::ID const& id, samplecnt_t length, Reader const& reader, Sample* dst, samplepos_t start, samplecnt_t cnt);
+
+	struct Range {
+		Range (std::weak_ptr<AudioSource> s, samplepos_t p, samplecnt_t c)
+			: source (s)
+			, start (p)
+			, cnt (c)
+		{}
+
+		std::weak_ptr<AudioSource> source;
+		samplepos_t                start;
+		samplecnt_t                cnt;
+	};
+
+	/** Load the given ranges in a background thread, in order, until
+	 * the cache is full.
+	 */
+	void preload (std::vector<Range> const&);
+	void stop_preload ();
+
+	/** Discard all data of the source with the given ID. Reads of
+	 * this source that are in progress are not cached either.
+	 */
+	void drop (PBD::ID const&);
+	void clear ();
+
+private:
+	SourceCache ();
+	~SourceCache ();
+
+	SourceCache (SourceCache const&);
+	SourceCache& operator= (SourceCache const&);
+
+	typedef std::vector<Sample> Block;
+	typedef std::pair<PBD::ID, samplepos_t> Key;
+
+	struct Entry {
+		std::shared_ptr<Block const> block;
+		std::list<Key>::iterator     lru;
+	};
+
+	std::shared_ptr<Block const> block (PBD::ID const&, Reader const&, samplepos_t index, samplecnt_t len);
+
+	void evict_locked ();
+	void erase_locked (std::map<Key, Entry>::iterator);
+	void preload_thread ();
+
+	mutable Glib::Threads::Mutex _lock;
+	std::map<Key, Entry>         _blocks;
+	std::list<Key>               _lru; /* most recently used first */
+	std::map<PBD::ID, uint64_t>  _generation; /* incremented by drop() */
+	size_t                       _used;
+	std::atomic<size_t>          _budget;
+
+	PBD::Thread*       _preload_thread;
+	std::vector<Range> _preload_ranges;
+	std::atomic<bool>  _stop_preload;
+
+	/* sources that the preload thread would have destroyed,
+	 * released by stop_preload() */
+	std::vector<std::shared_ptr<AudioSource> > _orphans;
+};
+
+} // namespace ARDOUR
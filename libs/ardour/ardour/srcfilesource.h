@@ -47,6 +47,8 @@ public:
 
 	bool can_be_analysed() const { return false; }
 	bool clamped_at_unity() const { return false; }
+	/* the source that is wrapped is cached */
+	bool cacheable () const { return false; }
 
 protected:
 	void close ();
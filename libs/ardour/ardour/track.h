@@ -40,6 +40,7 @@ class Region;
 class DiskReader;
 class DiskWriter;
 class IO;
+class ReadAhead;
 class RecordEnableControl;
 class RecordSafeControl;
 class MidiNoteTracker;
@@ -150,6 +151,7 @@ public:
 	float playback_buffer_load () const;
 	float capture_buffer_load () const;
 	int do_refill ();
+	void prefetch (ReadAhead&);
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (OverwriteReason);
 	int seek (samplepos_t, bool complete_refill = false);
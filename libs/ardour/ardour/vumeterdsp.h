@@ -21,6 +21,8 @@
 #ifndef __VUMETERDSP_H
 #define __VUMETERDSP_H
 
+#include <stdint.h>
+
 #include "ardour/libardour_visibility.h"
 
 class LIBARDOUR_API Vumeterdsp
@@ -36,6 +38,12 @@ public:
 
     static void init (float fsamp);
 
+    /** Process @a n_meters meters, @a p holds one buffer for each.
+     * Four meters are processed at a time, by the runtime selected
+     * (SIMD) ARDOUR::vumeter_process function.
+     */
+    static void process (Vumeterdsp* const* m, float const* const* p, uint32_t n_meters, int n);
+
 private:
 
     float          _z1;          // filter state
@@ -515,4 +515,40 @@ arm_neon_copy_vector(
 	}
 }
 
+C_FUNC float
+arm_neon_resample_filter(const float *p1, const float *p2, const float *q1, const float *q2, float a, float b, uint32_t hl)
+{
+	const int n = hl;
+	int i = 0;
+
+	float32x4_t va  = vdupq_n_f32(a);
+	float32x4_t vb  = vdupq_n_f32(b);
+	// bias each lane to avoid denormals, as the scalar kernel does
+	float32x4_t acc = vdupq_n_f32(1e-25f);
+
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t c1 = vmlaq_f32(vmulq_f32(vb, vld1q_f32(q1 + i + n)), va, vld1q_f32(q1 + i));
+		float32x4_t c2 = vmlaq_f32(vmulq_f32(vb, vld1q_f32(q2 + i - n)), va, vld1q_f32(q2 + i));
+
+		float32x4_t x1 = vld1q_f32(p1 + i);
+		// p2 is read backwards
+		float32x4_t x2 = vrev64q_f32(vld1q_f32(p2 - i - 4));
+		x2 = vcombine_f32(vget_high_f32(x2), vget_low_f32(x2));
+
+		acc = vmlaq_f32(acc, x1, c1);
+		acc = vmlaq_f32(acc, x2, c2);
+	}
+
+	float32x2_t s2 = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+	float s = vget_lane_f32(vpadd_f32(s2, s2), 0);
+
+	for (; i < n; ++i) {
+		const float c1 = a * q1[i] + b * q1[i + n];
+		const float c2 = a * q2[i] + b * q2[i - n];
+		s += p1[i] * c1 + p2[-i - 1] * c2;
+	}
+
+	return s - 4 * 1e-25f;
+}
+
 #endif
@@ -30,6 +30,8 @@
 #include "pbd/error.h"
 #include "pbd/failed_constructor.h"
 
+#include "audiographer/general/loudness_reader.h"
+
 #include "ardour/audioanalyser.h"
 #include "ardour/readable.h"
 
@@ -56,6 +58,7 @@ AudioAnalyser::AudioAnalyser (float sr, AnalysisPluginKey key)
 
 AudioAnalyser::~AudioAnalyser ()
 {
+	Glib::Threads::Mutex::Lock lm (AudioGrapher::LoudnessReader::vamp_lock ());
 	delete plugin;
 }
 
@@ -64,6 +67,9 @@ AudioAnalyser::initialize_plugin (AnalysisPluginKey key, float sr)
 {
 	using namespace Vamp::HostExt;
 
+	/* sources may be analysed by several threads concurrently */
+	Glib::Threads::Mutex::Lock lm (AudioGrapher::LoudnessReader::vamp_lock ());
+
 	PluginLoader* loader (PluginLoader::getInstance());
 
 	plugin = loader->loadPlugin (key, sr, PluginLoader::ADAPT_ALL_SAFE);
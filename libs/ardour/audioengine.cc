@@ -63,6 +63,7 @@
 #include "ardour/mtdm.h"
 #include "ardour/port.h"
 #include "ardour/process_thread.h"
+#include "ardour/process_trace.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 #include "ardour/transport_master_manager.h"
@@ -1435,6 +1436,7 @@ AudioEngine::thread_init_callback (void* arg)
 	SessionEvent::create_per_thread_pool (thread_name, 512);
 	PBD::notify_event_loops_about_thread_creation (pthread_self(), thread_name, 4096);
 	AsyncMIDIPort::set_process_thread (pthread_self());
+	ProcessTrace::thread_init (thread_name);
 
 	Temporal::TempoMap::fetch ();
 
@@ -55,6 +55,7 @@
 #include "ardour/mp3filesource.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/session.h"
+#include "ardour/source_cache.h"
 #include "ardour/filename_extensions.h"
 
 // if these headers come before sigc++ is included
@@ -305,6 +306,8 @@ AudioFileSource::set_gain (float g, bool temporarily)
 		return;
 	}
 	_gain = g;
+	/* cached data has the previous gain applied */
+	SourceCache::instance ().drop (id ());
 	if (temporarily) {
 		return;
 	}
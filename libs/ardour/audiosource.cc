@@ -61,6 +61,7 @@
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
+#include "ardour/source_cache.h"
 
 #include "pbd/i18n.h"
 
@@ -129,6 +130,8 @@ AudioSource::~AudioSource ()
 	}
 
 	delete [] peak_leftovers;
+
+	SourceCache::instance ().drop (id ());
 }
 
 XMLNode&
@@ -313,6 +316,19 @@ AudioSource::read (Sample *dst, samplepos_t start, samplecnt_t cnt, int /*channe
 {
 	assert (cnt >= 0);
 
+	if (cacheable ()) {
+		SourceCache& cache (SourceCache::instance ());
+		if (cache.enabled ()) {
+			return cache.read (*this, dst, start, cnt);
+		}
+	}
+
+	return read_uncached (dst, start, cnt);
+}
+
+samplecnt_t
+AudioSource::read_uncached (Sample *dst, samplepos_t start, samplecnt_t cnt) const
+{
 	/* as odd as it may seem, given that this method is used to *read* the
 	 * source, that we would need a write lock here. The problem is that
 	 * the audio file API we use (libsndfile) does not allow concurrent use
@@ -45,6 +45,9 @@
 #include "ardour/disk_reader.h"
 #include "ardour/io.h"
 #include "ardour/io_tasklist.h"
+#include "ardour/luaproc.h"
+#include "ardour/process_trace.h"
+#include "ardour/read_ahead.h"
 #include "ardour/session.h"
 #include "ardour/track.h"
 
@@ -64,6 +67,7 @@ Butler::Butler (Session& s)
 	, _midi_buffer_size (0)
 	, pool_trash (16)
 	, _xthread (true)
+	, _read_ahead (0)
 {
 	should_do_transport_work.store (0);
 	SessionEvent::pool->set_trash (&pool_trash);
@@ -75,6 +79,7 @@ Butler::Butler (Session& s)
 Butler::~Butler ()
 {
 	terminate_thread ();
+	delete _read_ahead;
 }
 
 void
@@ -171,6 +176,7 @@ void*
 Butler::_thread_work (void* arg)
 {
 	SessionEvent::create_per_thread_pool ("butler events", 4096);
+	ProcessTrace::thread_init ("Butler");
 	/* get thread buffers for RegionFx */
 	ARDOUR::ProcessThread* pt = new ProcessThread ();
 	pt->get_buffers ();
@@ -274,6 +280,10 @@ Butler::thread_work ()
 
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", should_do_transport_work.load ()));
 
+		if (should_run && !transport_work_requested ()) {
+			read_ahead (rl_with_auditioner);
+		}
+
 		std::shared_ptr<IOTaskList> tl = _session.io_tasklist ();
 
 		for (i = rl_with_auditioner.begin (); !transport_work_requested () && should_run && i != rl_with_auditioner.end (); ++i) {
@@ -292,6 +302,7 @@ Butler::thread_work ()
 			}
 
 			tl->push_back ([tr, &disk_work_outstanding]() {
+				ProcessTrace::Scope trace (ProcessTrace::Butler, *tr);
 				switch (tr->do_refill ()) {
 					case 0:
 						//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
@@ -358,11 +369,55 @@ Butler::thread_work ()
 		DEBUG_TRACE (DEBUG::Butler, "butler emptying pool trash\n");
 		empty_pool_trash ();
 		process_delegated_work ();
+
+		LuaProc::collect_garbage_pending ();
 	}
 
 	return (0);
 }
 
+/** Read the file data of the following refill of all tracks in one batch,
+ * so that the refill itself is served from the page cache.
+ */
+void
+Butler::read_ahead (RouteList const& rl)
+{
+	if (!Config->get_async_read_ahead ()) {
+		delete _read_ahead;
+		_read_ahead = 0;
+		return;
+	}
+
+	if (!_read_ahead) {
+		_read_ahead = new ReadAhead;
+	}
+
+	if (!_read_ahead->available ()) {
+		return;
+	}
+
+	ProcessTrace::Scope trace (ProcessTrace::Butler, "read-ahead");
+
+	for (auto const& r : rl) {
+		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
+
+		if (!tr) {
+			continue;
+		}
+
+		std::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active ()) {
+			continue;
+		}
+
+		tr->prefetch (*_read_ahead);
+	}
+
+	size_t const n = _read_ahead->run ();
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("read-ahead of %1 bytes\n", n));
+}
+
 bool
 Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32_t& errors)
 {
@@ -18,6 +18,7 @@
 
 #include <assert.h>
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 
@@ -39,6 +40,36 @@ using namespace ARDOUR;
 using namespace ARDOUR::DSP;
 using namespace ArdourZita;
 
+namespace {
+
+/* Worker threads shared by all Convolution instances. Partition levels
+ * that are not processed in the realtime thread are scheduled on this
+ * pool, rather than each using a dedicated thread.
+ */
+class SharedConvpool : public Convpool
+{
+public:
+	SharedConvpool ()
+	{
+		uint32_t n_threads = std::max<uint32_t> (1, PBD::hardware_concurrency () / 2);
+		n_threads = std::min<uint32_t> (n_threads, Convpool::MAXTHR);
+
+		/* below the process-graph threads, since the pool has slack until the next partition is due */
+		if (start (n_threads, pbd_absolute_rt_priority (PBD_SCHED_FIFO, PBD_RT_PRI_PROC - 1), PBD_SCHED_FIFO)) {
+			PBD::warning << _("Convolution: cannot start shared worker threads") << endmsg;
+		}
+	}
+};
+
+Convpool&
+shared_convpool ()
+{
+	static SharedConvpool pool;
+	return pool;
+}
+
+} // namespace
+
 Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     : SessionHandleRef (session)
     , _n_samples (0)
@@ -169,7 +200,12 @@ Convolution::restart ()
 	}
 
 	if (rv == 0) {
-		rv = _convproc.start_process (pbd_absolute_rt_priority (PBD_SCHED_FIFO, PBD_RT_PRI_PROC), PBD_SCHED_FIFO);
+		Convpool& pool (shared_convpool ());
+		if (pool.nthreads () > 0) {
+			rv = _convproc.start_process (pool, _session.nominal_sample_rate ());
+		} else {
+			rv = _convproc.start_process (pbd_absolute_rt_priority (PBD_SCHED_FIFO, PBD_RT_PRI_PROC), PBD_SCHED_FIFO);
+		}
 	}
 
 	assert (rv == 0); // bail out in debug builds
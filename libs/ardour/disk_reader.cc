@@ -27,6 +27,7 @@
 #include "ardour/audio_buffer.h"
 #include "ardour/audioengine.h"
 #include "ardour/audioplaylist.h"
+#include "ardour/audioregion.h"
 #include "ardour/butler.h"
 #include "ardour/debug.h"
 #include "ardour/disk_reader.h"
@@ -36,8 +37,10 @@
 #include "ardour/pannable.h"
 #include "ardour/playlist.h"
 #include "ardour/playlist_factory.h"
+#include "ardour/read_ahead.h"
 #include "ardour/session.h"
 #include "ardour/session_playlists.h"
+#include "ardour/sndfilesource.h"
 
 #include "pbd/i18n.h"
 
@@ -1282,19 +1285,7 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 		}
 	}
 
-	/* total_space is in samples. We want to optimize read sizes in various sizes using bytes */
-	const size_t bits_per_sample = format_data_width (_session.config.get_native_file_data_format ());
-	size_t       total_bytes     = total_space * bits_per_sample / 8;
-
-	/* chunk size range is 256kB to 4MB. Bigger is faster in terms of MB/sec, but bigger chunk size always takes longer */
-	size_t byte_size_for_read = max ((size_t) (256 * 1024), min ((size_t) (4 * 1048576), total_bytes));
-
-	/* find nearest (lower) multiple of 16384 */
-
-	byte_size_for_read = (byte_size_for_read / 16384) * 16384;
-
-	/* now back to samples */
-	samplecnt_t samples_to_read = byte_size_for_read / (bits_per_sample / 8);
+	samplecnt_t samples_to_read = refill_read_size (total_space);
 
 	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("'%1': will refill %2 channels with %3 samples\n", name (), c->size (), total_space));
 
@@ -1369,6 +1360,111 @@ out:
 	return ret;
 }
 
+samplecnt_t
+DiskReader::refill_read_size (samplecnt_t total_space) const
+{
+	/* total_space is in samples. We want to optimize read sizes in various sizes using bytes */
+	const size_t bits_per_sample = format_data_width (_session.config.get_native_file_data_format ());
+	size_t       total_bytes     = total_space * bits_per_sample / 8;
+
+	/* chunk size range is 256kB to 4MB. Bigger is faster in terms of MB/sec, but bigger chunk size always takes longer */
+	size_t byte_size_for_read = max ((size_t) (256 * 1024), min ((size_t) (4 * 1048576), total_bytes));
+
+	/* find nearest (lower) multiple of 16384 */
+
+	byte_size_for_read = (byte_size_for_read / 16384) * 16384;
+
+	/* now back to samples */
+	return byte_size_for_read / (bits_per_sample / 8);
+}
+
+/** Queue the file ranges that refill_audio() will read next.
+ *
+ * This mirrors the conditions and the read position of refill_audio(),
+ * but only looks at the regions of the playlist, not at their contents.
+ * Fades, gain and layering do not matter, all touched data will be read.
+ */
+void
+DiskReader::prefetch (ReadAhead& ra)
+{
+	if (_session.loading () || !_playlists[DataType::AUDIO]) {
+		return;
+	}
+
+	std::shared_ptr<ChannelList const> c = channels.reader ();
+
+	if (c->empty ()) {
+		return;
+	}
+
+	samplecnt_t const total_space = c->front ()->rbuf->write_space ();
+
+	if (total_space == 0) {
+		return;
+	}
+
+	if ((total_space < _chunk_samples) && fabs (_session.transport_speed ()) < 2.0f) {
+		return;
+	}
+
+	if (_slaved && total_space < (samplecnt_t) (c->front ()->rbuf->bufsize () / 2)) {
+		return;
+	}
+
+	samplepos_t start = file_sample[DataType::AUDIO];
+	samplecnt_t cnt   = min (total_space, refill_read_size (total_space));
+
+	if (!_session.transport_will_roll_forwards ()) {
+		cnt = min (cnt, start);
+		start -= cnt;
+	} else {
+		cnt = min (cnt, max_samplepos - start);
+
+		Location* loc = _loop_location;
+		if (loc) {
+			const Temporal::Range loop_range (loc->start (), loc->end ());
+			start = loop_range.squish (timepos_t (start)).samples ();
+			/* only prefetch up to the loop end */
+			cnt = min (cnt, loc->end_sample () - start);
+		}
+	}
+
+	if (cnt <= 0) {
+		return;
+	}
+
+	samplepos_t const                 end = start + cnt;
+	std::shared_ptr<RegionList> const rl  = audio_playlist ()->regions_touched (timepos_t (start), timepos_t (end));
+
+	for (auto const& r : *rl) {
+		std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (r);
+
+		if (!ar || ar->muted ()) {
+			continue;
+		}
+
+		samplepos_t const rpos = ar->position_sample ();
+		samplepos_t const s    = max (start, rpos);
+		samplepos_t const e    = min (end, rpos + ar->length_samples ());
+
+		if (s >= e) {
+			continue;
+		}
+
+		for (uint32_t n = 0; n < ar->n_channels (); ++n) {
+			std::shared_ptr<SndFileSource> sfs = std::dynamic_pointer_cast<SndFileSource> (ar->audio_source (n));
+
+			int     fd;
+			int64_t offset;
+			size_t  len;
+
+			if (sfs && sfs->file_extent (ar->start_sample () + s - rpos, e - s, fd, offset, len)) {
+				ra.add (fd, offset, len);
+			}
+		}
+	}
+}
+
 void
 DiskReader::playlist_ranges_moved (list<Temporal::RangeMove> const& movements, bool from_undo_or_shift)
 {
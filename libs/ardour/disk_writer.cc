@@ -18,6 +18,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <sstream>
+
 #include <glibmm/datetime.h>
 
 #include "ardour/analyser.h"
@@ -38,6 +40,8 @@
 #include "ardour/smf_source.h"
 
 #include "pbd/atomic.h"
+#include "pbd/microseconds.h"
+
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
@@ -70,6 +74,8 @@ DiskWriter::DiskWriter (Session& s, Track& t, string const & str, DiskIOProcesso
 	_samples_pending_write.store (0);
 	_num_captured_loops.store (0);
 	_reset_last_capture_sources.store (0);
+
+	reset_write_latency ();
 }
 
 DiskWriter::~DiskWriter ()
@@ -1009,7 +1015,7 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 
 		to_write = min (_chunk_samples, (samplecnt_t) vector.len[0]);
 
-		if ((!chan->write_source) || chan->write_source->write (vector.buf[0], to_write) != to_write) {
+		if ((!chan->write_source) || write_audio (chan->write_source, vector.buf[0], to_write) != to_write) {
 			error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
 			return -1;
 		}
@@ -1028,7 +1034,7 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 
                         DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 additional write of %2\n", name(), to_write));
 
-			if (chan->write_source->write (vector.buf[1], to_write) != to_write) {
+			if (write_audio (chan->write_source, vector.buf[1], to_write) != to_write) {
 				error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
 				return -1;
 			}
@@ -1094,6 +1100,79 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 
 }
 
+samplecnt_t
+DiskWriter::write_audio (std::shared_ptr<AudioFileSource> const& src, Sample const* data, samplecnt_t cnt)
+{
+	int64_t const     before = PBD::get_microseconds ();
+	samplecnt_t const rv     = src->write (data, cnt);
+
+	record_write_latency (PBD::get_microseconds () - before);
+	return rv;
+}
+
+void
+DiskWriter::record_write_latency (int64_t usec)
+{
+	size_t bucket = 0;
+
+	for (int64_t ms = usec / 1000; ms > 0 && bucket < write_latency_buckets - 1; ms >>= 1) {
+		++bucket;
+	}
+
+	_write_latency[bucket].fetch_add (1);
+
+	int64_t prev = _max_write_latency.load ();
+	while (usec > prev && !_max_write_latency.compare_exchange_weak (prev, usec)) {
+		;
+	}
+}
+
+std::vector<int32_t>
+DiskWriter::write_latency () const
+{
+	std::vector<int32_t> rv;
+
+	for (size_t n = 0; n < write_latency_buckets; ++n) {
+		rv.push_back (_write_latency[n].load ());
+	}
+
+	return rv;
+}
+
+void
+DiskWriter::reset_write_latency ()
+{
+	for (size_t n = 0; n < write_latency_buckets; ++n) {
+		_write_latency[n].store (0);
+	}
+
+	_max_write_latency.store (0);
+}
+
+std::string
+DiskWriter::write_latency_summary () const
+{
+	std::stringstream ss;
+
+	for (size_t n = 0; n < write_latency_buckets; ++n) {
+		int32_t const cnt = _write_latency[n].load ();
+		if (cnt == 0) {
+			continue;
+		}
+		if (n == 0) {
+			ss << " <1ms:";
+		} else if (n == write_latency_buckets - 1) {
+			ss << " >=" << (1 << (n - 1)) << "ms:";
+		} else {
+			ss << " <" << (1 << n) << "ms:";
+		}
+		ss << cnt;
+	}
+
+	ss << " max: " << _max_write_latency.load () << "us";
+	return ss.str ();
+}
+
 void
 DiskWriter::reset_write_sources (bool mark_write_complete)
 {
@@ -1262,6 +1341,8 @@ DiskWriter::transport_stopped_wallclock (struct tm& when, time_t twhen, bool abo
 		goto out;
 	}
 
+	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: capture write latency%2\n", name (), write_latency_summary ()));
+
 	/* figure out the name for this take */
 
 	for (n = 0, chan = c->begin(); chan != c->end(); ++chan, ++n) {
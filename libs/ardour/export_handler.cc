@@ -40,6 +40,10 @@
 #include "ardour/export_status.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_filename.h"
+#include "ardour/io.h"
+#include "ardour/midi_port.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
 #include "ardour/soundcloud_upload.h"
 #include "ardour/surround_return.h"
 #include "ardour/system_exec.h"
@@ -292,10 +296,71 @@ ExportHandler::start_timespan ()
 		session.surround_master ()->surround_return ()->setup_export (current_timespan->vapor (), current_timespan->get_start (), current_timespan->get_end ());
 	}
 
+	/* Surround exports read from the surround-return of the master-bus,
+	 * which all routes may feed.
+	 */
+	if (!realtime && !region_export && current_timespan->vapor ().empty () && Config->get_export_prune_graph ()) {
+		session.set_export_routes (export_sinks ());
+	} else {
+		session.set_export_routes (std::shared_ptr<RouteList const> ());
+	}
+
 	// TODO check if it's a RegionExport.. set flag to skip  process_without_events()
 	return session.start_audio_export (process_position, realtime, region_export);
 }
 
+/** @return the routes whose output or input ports, or processors are
+ * exported in the current timespan, or null if some channel cannot be
+ * attributed to a route.
+ */
+std::shared_ptr<RouteList const>
+ExportHandler::export_sinks () const
+{
+	std::shared_ptr<RouteList const> routes = session.get_routes ();
+	std::set<std::shared_ptr<Route>> sinks;
+
+	auto route_of_port = [&routes] (std::shared_ptr<Port> p) -> std::shared_ptr<Route> {
+		if (!p) {
+			return std::shared_ptr<Route> ();
+		}
+		for (auto const& r : *routes) {
+			if (r->output ()->has_port (p) || r->input ()->has_port (p)) {
+				return r;
+			}
+		}
+		return std::shared_ptr<Route> ();
+	};
+
+	for (ConfigMap::const_iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
+		for (auto const& c : it->second.channel_config->get_channels ()) {
+			std::shared_ptr<Route> r;
+
+			if (std::shared_ptr<PortExportChannel> pec = std::dynamic_pointer_cast<PortExportChannel> (c)) {
+				for (auto const& wp : pec->get_ports ()) {
+					if (!(r = route_of_port (wp.lock ()))) {
+						return std::shared_ptr<RouteList const> ();
+					}
+					sinks.insert (r);
+				}
+				continue;
+			} else if (std::shared_ptr<PortExportMIDI> pem = std::dynamic_pointer_cast<PortExportMIDI> (c)) {
+				r = route_of_port (pem->port ());
+			} else if (std::shared_ptr<RouteExportChannel> rec = std::dynamic_pointer_cast<RouteExportChannel> (c)) {
+				r = rec->route ();
+			} else if (std::dynamic_pointer_cast<RegionExportChannel> (c)) {
+				continue;
+			}
+
+			if (!r) {
+				return std::shared_ptr<RouteList const> ();
+			}
+			sinks.insert (r);
+		}
+	}
+
+	return std::shared_ptr<RouteList const> (new RouteList (sinks.begin (), sinks.end ()));
+}
+
 void
 ExportHandler::handle_duplicate_format_extensions()
 {
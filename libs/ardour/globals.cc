@@ -135,6 +135,8 @@
 
 #include "audiographer/routines.h"
 
+#include "zita-resampler/vmresampler.h"
+
 #if defined(__APPLE__)
 #include <CoreFoundation/CoreFoundation.h>
 #endif
@@ -157,6 +159,11 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer  = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
+kmeter_process_t        ARDOUR::kmeter_process        = 0;
+ppm_process_t           ARDOUR::ppm_process           = 0;
+vumeter_process_t       ARDOUR::vumeter_process       = 0;
+kweight_process_t       ARDOUR::kweight_process       = 0;
+compute_true_peak_t     ARDOUR::compute_true_peak     = 0;
 
 PBD::Signal<void(std::string)>                    ARDOUR::BootMessage;
 PBD::Signal<void(std::string, std::string, bool)> ARDOUR::PluginScanMessage;
@@ -211,6 +218,13 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 			copy_vector           = x86_avx512f_copy_vector;
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
+			kweight_process       = x86_sse_kweight_process;
+			compute_true_peak     = x86_sse_compute_true_peak;
+
+			ArdourZita::VMResampler::override_filter (x86_avx512f_resample_filter);
 
 			generic_mix_functions = false;
 
@@ -228,6 +242,13 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
+			kweight_process       = x86_sse_kweight_process;
+			compute_true_peak     = x86_sse_compute_true_peak;
+
+			ArdourZita::VMResampler::override_filter (x86_fma_resample_filter);
 
 			generic_mix_functions = false;
 
@@ -243,6 +264,13 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
+			kweight_process       = x86_sse_kweight_process;
+			compute_true_peak     = x86_sse_compute_true_peak;
+
+			ArdourZita::VMResampler::override_filter (x86_sse_resample_filter);
 
 			generic_mix_functions = false;
 
@@ -256,6 +284,13 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			kmeter_process        = x86_sse_kmeter_process;
+			ppm_process           = x86_sse_ppm_process;
+			vumeter_process       = x86_sse_vumeter_process;
+			kweight_process       = x86_sse_kweight_process;
+			compute_true_peak     = x86_sse_compute_true_peak;
+
+			ArdourZita::VMResampler::override_filter (x86_sse_resample_filter);
 
 			generic_mix_functions = false;
 		}
@@ -271,6 +306,21 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = arm_neon_mix_buffers_with_gain;
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
+#ifdef __aarch64__
+			kmeter_process        = arm_neon_kmeter_process;
+			ppm_process           = arm_neon_ppm_process;
+			vumeter_process       = arm_neon_vumeter_process;
+			kweight_process       = arm_neon_kweight_process;
+			compute_true_peak     = arm_neon_compute_true_peak;
+#else
+			kmeter_process        = default_kmeter_process;
+			ppm_process           = default_ppm_process;
+			vumeter_process       = default_vumeter_process;
+			kweight_process       = default_kweight_process;
+			compute_true_peak     = default_compute_true_peak;
+#endif
+
+			ArdourZita::VMResampler::override_filter (arm_neon_resample_filter);
 
 			generic_mix_functions = false;
 		}
@@ -284,6 +334,11 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			kmeter_process        = default_kmeter_process;
+			ppm_process           = default_ppm_process;
+			vumeter_process       = default_vumeter_process;
+			kweight_process       = default_kweight_process;
+			compute_true_peak     = default_compute_true_peak;
 
 			generic_mix_functions = false;
 
@@ -303,6 +358,13 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		kmeter_process        = default_kmeter_process;
+		ppm_process           = default_ppm_process;
+		vumeter_process       = default_vumeter_process;
+		kweight_process       = default_kweight_process;
+		compute_true_peak     = default_compute_true_peak;
+
+		ArdourZita::VMResampler::override_filter (ArdourZita::VMResampler::default_filter);
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
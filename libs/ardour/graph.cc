@@ -35,6 +35,7 @@
 #include "ardour/graph.h"
 #include "ardour/io_plug.h"
 #include "ardour/process_thread.h"
+#include "ardour/process_trace.h"
 #include "ardour/route.h"
 #include "ardour/rt_task.h"
 #include "ardour/rt_tasklist.h"
@@ -47,6 +48,9 @@ using namespace ARDOUR;
 using namespace PBD;
 using namespace std;
 
+/* true while a graph thread processes a node, see process_subtasks() */
+static thread_local bool in_graph_node = false;
+
 #ifdef DEBUG_RT_ALLOC
 static Graph* graph = 0;
 
@@ -214,8 +218,9 @@ Graph::prep ()
 	assert (_trigger_queue_size.load() == 0);
 	assert (_graph_empty != (_graph_chain->_n_terminal_nodes > 0));
 
-	if (_trigger_queue.capacity () < _graph_chain->_nodes_rt.size ()) {
-		_trigger_queue.reserve (_graph_chain->_nodes_rt.size ());
+	/* leave room for subtask helpers, see process_subtasks() */
+	if (_trigger_queue.capacity () < _graph_chain->_nodes_rt.size () + max_subtask_helpers) {
+		_trigger_queue.reserve (_graph_chain->_nodes_rt.size () + max_subtask_helpers);
 	}
 
 	_terminal_refcnt.store (_graph_chain->_n_terminal_nodes);
@@ -227,11 +232,15 @@ Graph::prep ()
 	}
 }
 
-void
+bool
 Graph::trigger (ProcessNode* n)
 {
 	_trigger_queue_size.fetch_add (1);
-	_trigger_queue.push_back (n);
+	if (!_trigger_queue.push_back (n)) {
+		PBD::atomic_dec_and_test (_trigger_queue_size);
+		return false;
+	}
+	return true;
 }
 
 /** Called when a node at the `output' end of the chain (ie one that has no-one to feed)
@@ -245,8 +254,9 @@ Graph::reached_terminal_node ()
 
 		/* We have run all the nodes that are at the `output' end of
 		 * the graph, so there is nothing more to do this time around.
+		 * (withdrawn subtask helpers may still be queued, they are
+		 * consumed before all threads are idle).
 		 */
-		assert (_trigger_queue_size.load() == 0);
 
 		/* Notify caller */
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 cycle done.\n", pthread_name ()));
@@ -341,7 +351,9 @@ Graph::run_one ()
 
 	/* Process the graph-node */
 	PBD::atomic_dec_and_test (_trigger_queue_size);
+	in_graph_node = true;
 	to_run->run (_graph_chain);
+	in_graph_node = false;
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name ()));
 }
@@ -362,6 +374,8 @@ Graph::helper_thread ()
 		PBD::notify_event_loops_about_thread_creation (pthread_self (), name, 64);
 	}
 
+	ProcessTrace::thread_init (string_compose ("RT-%1", id));
+
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 	resume_rt_malloc_checks ();
@@ -394,6 +408,7 @@ Graph::main_thread ()
 		SessionEvent::create_per_thread_pool (name, 64);
 		PBD::notify_event_loops_about_thread_creation (pthread_self (), name, 64);
 	}
+	ProcessTrace::thread_init ("RT-main");
 	resume_rt_malloc_checks ();
 
 	pt->get_buffers ();
@@ -538,6 +553,8 @@ Graph::process_one_route (Route* route)
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 runs route %2\n", pthread_name (), route->name ()));
 
+	ProcessTrace::Scope trace (ProcessTrace::GraphNode, *route);
+
 	switch (_process_mode) {
 		case Roll:
 			retval = route->roll (_process_nframes, _process_start_sample, _process_end_sample, need_butler);
@@ -563,6 +580,7 @@ Graph::process_one_route (Route* route)
 void
 Graph::process_one_ioplug (IOPlug* ioplug)
 {
+	ProcessTrace::Scope trace (ProcessTrace::GraphNode, *ioplug);
 	ioplug->connect_and_run (_process_start_sample, _process_nframes);
 }
 
@@ -599,6 +617,71 @@ Graph::process_tasklist (RTTaskList const& rt)
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
 }
 
+/** Process the tasks of @a tl in parallel, and return when all of them
+ * have completed. This is to be called from within a graph node that is
+ * being processed: the calling thread takes part in processing the
+ * tasks, and other graph threads help out if they are idle.
+ * Otherwise the tasks are processed one after another.
+ */
+void
+Graph::process_subtasks (RTSubTaskList& tl)
+{
+	size_t const n = tl._tasks.size ();
+
+	tl._next.store (0);
+
+	SubTaskHelper* helpers[max_subtask_helpers];
+	uint32_t       n_helpers = 0;
+
+	if (in_graph_node && n > 1) {
+		size_t const want = std::min<size_t> (_idle_thread_cnt.load (), n - 1);
+
+		for (size_t i = 0; i < max_subtask_helpers && n_helpers < want; ++i) {
+			SubTaskHelper& h (_subtask_helpers[i]);
+			bool           expected = false;
+			/* skip helpers that are still queued from a previous call */
+			if (!h.queued.compare_exchange_strong (expected, true)) {
+				continue;
+			}
+			h.list.store (&tl);
+			if (!trigger (&h)) {
+				h.list.store (0);
+				h.queued.store (false);
+				break;
+			}
+			helpers[n_helpers++] = &h;
+		}
+
+		for (uint32_t i = 0; i < n_helpers; ++i) {
+			_execution_sem.signal ();
+		}
+	}
+
+	tl.run_tasks ();
+
+	/* Join. Withdraw helpers that have not started yet (they remain
+	 * queued, but do nothing), and wait for the ones that did.
+	 */
+	for (uint32_t i = 0; i < n_helpers; ++i) {
+		RTSubTaskList* expected = &tl;
+		if (!helpers[i]->list.compare_exchange_strong (expected, 0)) {
+			tl._helpers_done.wait ();
+		}
+	}
+}
+
+void
+Graph::SubTaskHelper::run (GraphChain const*)
+{
+	RTSubTaskList* tl = list.exchange (0);
+	queued.store (false);
+
+	if (tl) {
+		tl->run_tasks ();
+		tl->_helpers_done.signal ();
+	}
+}
+
 /* ****************************************************************************/
 
 GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
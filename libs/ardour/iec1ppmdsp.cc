@@ -18,7 +18,10 @@
  */
 
 #include <math.h>
+#include <algorithm>
+
 #include "ardour/iec1ppmdsp.h"
+#include "ardour/runtime_functions.h"
 
 float Iec1ppmdsp::_w1;
 float Iec1ppmdsp::_w2;
@@ -69,6 +72,38 @@ Iec1ppmdsp::process (float const* p, int n)
 	_m = m;
 }
 
+void
+Iec1ppmdsp::process (Iec1ppmdsp* const* m, float const* const* p, uint32_t n_meters, int n)
+{
+	for (uint32_t c = 0; c < n_meters; c += 4) {
+		/* unused lanes repeat the last meter */
+		const uint32_t last = std::min (c + 3, n_meters - 1);
+
+		float const* buf[4];
+		float        z1[4];
+		float        z2[4];
+		float        mx[4];
+
+		for (uint32_t l = 0; l < 4; ++l) {
+			const uint32_t i = std::min (c + l, last);
+			Iec1ppmdsp const* k = m[i];
+			buf[l] = p[i];
+			z1[l]  = k->_z1 > 20 ? 20 : (k->_z1 < 0 ? 0 : k->_z1);
+			z2[l]  = k->_z2 > 20 ? 20 : (k->_z2 < 0 ? 0 : k->_z2);
+			mx[l]  = k->_res ? 0 : k->_m;
+		}
+
+		ARDOUR::ppm_process (buf, z1, z2, mx, n & ~3, _w1, _w2, _w3);
+
+		for (uint32_t i = c; i <= last; ++i) {
+			m[i]->_z1  = z1[i - c] + 1e-10f;
+			m[i]->_z2  = z2[i - c] + 1e-10f;
+			m[i]->_m   = mx[i - c];
+			m[i]->_res = false;
+		}
+	}
+}
+
 float
 Iec1ppmdsp::read (void)
 {
@@ -24,8 +24,10 @@
 #include "libardour-config.h"
 #endif
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
+#include <functional>
 #include <string>
 #include <climits>
 #include <cerrno>
@@ -42,6 +44,8 @@
 
 #include "pbd/basename.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
+#include "pbd/pthread_utils.h"
 
 #include "evoral/SMF.h"
 
@@ -60,6 +64,7 @@
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
 #include "ardour/session_directory.h"
+#include "ardour/session_event.h"
 #include "ardour/smf_source.h"
 #include "ardour/sndfile_helpers.h"
 #include "ardour/sndfileimportable.h"
@@ -252,23 +257,152 @@ compose_status_message (const string& path,
 	return string_compose (_("Copying %1"), Glib::path_get_basename (path));
 }
 
+namespace {
+
+/** Writes de-interleaved audio data to a set of mono sources.
+ *
+ * Data is passed in a small ring of preallocated blocks to a dedicated
+ * thread, so that reading, decoding and resampling the next block
+ * overlaps with writing the previous one to disk. If the thread cannot
+ * be created, blocks are written synchronously.
+ */
+class ImportWriter
+{
+public:
+	ImportWriter (vector<std::shared_ptr<Source> > const& sources, uint32_t channels, samplecnt_t nframes)
+		: _head (0)
+		, _tail (0)
+		, _queued (0)
+		, _finished (false)
+		, _thread (0)
+	{
+		for (uint32_t chn = 0; chn < channels; ++chn) {
+			_sources.push_back (std::dynamic_pointer_cast<AudioFileSource> (sources[chn]));
+		}
+
+		for (uint32_t b = 0; b < n_blocks; ++b) {
+			_blocks[b].nframes = 0;
+			for (uint32_t chn = 0; chn < channels; ++chn) {
+				_blocks[b].data.push_back (std::shared_ptr<Sample[]> (new Sample[nframes]));
+				_blocks[b].ptr.push_back (_blocks[b].data.back ().get ());
+			}
+		}
+
+		_thread = PBD::Thread::create (std::bind (&ImportWriter::run, this), "ImportWriter");
+	}
+
+	~ImportWriter ()
+	{
+		finish ();
+	}
+
+	/** @return per-channel buffers of the next block to fill, waits until one is available */
+	Sample** get_block ()
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		while (_queued == n_blocks) {
+			_cond.wait (_lock);
+		}
+		return &_blocks[_head].ptr[0];
+	}
+
+	/** Queue the block returned by the last call to get_block() for writing */
+	void push_block (samplecnt_t nframes)
+	{
+		_blocks[_head].nframes = nframes;
+
+		if (!_thread) {
+			write (_blocks[_head]);
+			return;
+		}
+
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_head = (_head + 1) % n_blocks;
+		++_queued;
+		_cond.broadcast ();
+	}
+
+	/** Write all queued blocks and terminate the writer thread */
+	void finish ()
+	{
+		if (!_thread) {
+			return;
+		}
+		{
+			Glib::Threads::Mutex::Lock lm (_lock);
+			_finished = true;
+			_cond.broadcast ();
+		}
+		_thread->join ();
+		delete _thread;
+		_thread = 0;
+	}
+
+private:
+	/* 2 blocks suffice to overlap reading and writing, a 3rd one absorbs jitter */
+	static const uint32_t n_blocks = 3;
+
+	struct Block {
+		vector<std::shared_ptr<Sample[]> > data;
+		vector<Sample*>                    ptr;
+		samplecnt_t                        nframes;
+	};
+
+	void write (Block const& block)
+	{
+		for (size_t chn = 0; chn < _sources.size (); ++chn) {
+			if (_sources[chn]) {
+				_sources[chn]->write (block.ptr[chn], block.nframes);
+			}
+		}
+	}
+
+	void run ()
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		while (true) {
+			while (_queued == 0 && !_finished) {
+				_cond.wait (_lock);
+			}
+			if (_queued == 0) {
+				break;
+			}
+			/* the block remains queued, and hence is not re-used, until it is written */
+			Block const& block (_blocks[_tail]);
+			lm.release ();
+			write (block);
+			lm.acquire ();
+			_tail = (_tail + 1) % n_blocks;
+			--_queued;
+			_cond.broadcast ();
+		}
+	}
+
+	vector<std::shared_ptr<AudioFileSource> > _sources;
+	Block                                     _blocks[n_blocks];
+
+	Glib::Threads::Mutex _lock;
+	Glib::Threads::Cond  _cond;
+	uint32_t             _head;
+	uint32_t             _tail;
+	uint32_t             _queued;
+	bool                 _finished;
+	PBD::Thread*         _thread;
+};
+
+} // namespace
+
 static void
 write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
                                vector<std::shared_ptr<Source> >& newfiles)
 {
 	const samplecnt_t nframes = ResampledImportableSource::blocksize;
-	std::shared_ptr<AudioFileSource> afs;
 	uint32_t channels = source->channels();
 	if (channels == 0) {
 		return;
 	}
 
 	std::unique_ptr<float[]> data(new float[nframes * channels]);
-	vector<std::shared_ptr<Sample[]> > channel_data;
-
-	for (uint32_t n = 0; n < channels; ++n) {
-		channel_data.push_back(std::shared_ptr<Sample[]>(new Sample[nframes]));
-	}
 
 	float gain = 1;
 
@@ -313,6 +447,7 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 	}
 
 	samplecnt_t read_count = 0;
+	ImportWriter writer (newfiles, channels, nframes);
 
 	while (!status.cancel) {
 
@@ -321,14 +456,6 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 		uint32_t chn;
 
 		if ((nread = source->read (data.get(), nframes * channels)) == 0) {
-#ifdef PLATFORM_WINDOWS
-			/* Flush the data once we've finished importing the file. Windows can  */
-			/* cache the data for very long periods of time (perhaps not writing   */
-			/* it to disk until Ardour closes). So let's force it to flush now.    */
-			for (chn = 0; chn < channels; ++chn)
-				if ((afs = std::dynamic_pointer_cast<AudioFileSource>(newfiles[chn])) != 0)
-					afs->flush ();
-#endif
 			break;
 		}
 
@@ -339,7 +466,9 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 
 		nfread = nread / channels;
 
-		/* de-interleave */
+		/* de-interleave, and queue the block to be written to disk */
+
+		Sample** channel_data = writer.get_block ();
 
 		for (chn = 0; chn < channels; ++chn) {
 
@@ -349,17 +478,25 @@ write_audio_data_to_new_files (ImportableSource* source, ImportStatus& status,
 			}
 		}
 
-		/* flush to disk */
-
-		for (chn = 0; chn < channels; ++chn) {
-			if ((afs = std::dynamic_pointer_cast<AudioFileSource>(newfiles[chn])) != 0) {
-				afs->write (channel_data[chn].get(), nfread);
-			}
-		}
+		writer.push_block (nfread);
 
 		read_count += nfread;
 		status.progress = progress_base + progress_multiplier * read_count / progress_length;
 	}
+
+	writer.finish ();
+
+#ifdef PLATFORM_WINDOWS
+	if (!status.cancel) {
+		/* Flush the data once we've finished importing the file. Windows can  */
+		/* cache the data for very long periods of time (perhaps not writing   */
+		/* it to disk until Ardour closes). So let's force it to flush now.    */
+		std::shared_ptr<AudioFileSource> afs;
+		for (uint32_t chn = 0; chn < channels; ++chn)
+			if ((afs = std::dynamic_pointer_cast<AudioFileSource>(newfiles[chn])) != 0)
+				afs->flush ();
+	}
+#endif
 }
 
 static void
@@ -802,161 +939,323 @@ unique_track_names (const vector<string>& n)
 	return rv;
 }
 
-// This function is still unable to cleanly update an existing source, even though
-// it is possible to set the ImportStatus flag accordingly. The functionality
-// is disabled at the GUI until the Source implementations are able to provide
-// the necessary API.
-void
-Session::import_files (ImportStatus& status)
-{
-	typedef vector<std::shared_ptr<Source> > Sources;
-	Sources all_new_sources;
-	std::shared_ptr<AudioFileSource> afs;
-	std::shared_ptr<SMFSource> smfs;
-	uint32_t num_channels = 0;
-	vector<string> smf_names;
-	bool smf_keep_filename = false;
+namespace {
 
-	status.sources.clear ();
+/** A single file of a (multi-file) import */
+struct ImportJob {
+	ImportJob (string const& p, ImportStatus const& s)
+		: path (p)
+		, failed (false)
+		, finished (false)
+	{
+		status.current                 = 0;
+		status.total                   = 1;
+		status.freeze                  = false;
+		status.all_done                = false;
+		status.quality                 = s.quality;
+		status.replace_existing_source = s.replace_existing_source;
+		status.split_midi_channels     = s.split_midi_channels;
+		status.import_markers          = s.import_markers;
+		status.midi_track_name_source  = s.midi_track_name_source;
+	}
 
-	for (vector<string>::const_iterator p = status.paths.begin(); p != status.paths.end() && !status.cancel; ++p) {
+	string            path;
+	ImportStatus      status;   ///< per file progress and cancel flag
+	SourceList        newfiles; ///< sources created for this file
+	bool              failed;   ///< import must be aborted, set by the worker
+	std::atomic<bool> finished;
+};
+
+/** State shared by the threads of a multi-file import */
+struct ImportQueue {
+	ImportQueue () : next (0), n_finished (0), n_running (0), abort (false) {}
+
+	vector<std::unique_ptr<ImportJob> > jobs;
+	std::atomic<size_t>                 next;
+	std::atomic<size_t>                 n_finished;
+	std::atomic<size_t>                 n_running;
+	std::atomic<bool>                   abort;
+
+	/** Serializes calls into the session (source naming, creation,
+	 * SourceFactory signals) and protects ImportJob::status.doing_what.
+	 */
+	Glib::Threads::Mutex session_lock;
+	string               doing_what;
+};
 
-		std::shared_ptr<ImportableSource> source;
+} // namespace
 
-		const DataType type = SMFSource::safe_midi_file_extension (*p) ? DataType::MIDI : DataType::AUDIO;
-		std::unique_ptr<Evoral::SMF> smf_reader;
+static void
+import_one_file (Session& session, ImportJob& job, ImportQueue& queue)
+{
+	ImportStatus&                     status (job.status);
+	std::shared_ptr<ImportableSource> source;
+	std::unique_ptr<Evoral::SMF>      smf_reader;
+	std::shared_ptr<AudioFileSource>  afs;
+	uint32_t                          num_channels = 0;
+	vector<string>                    smf_names;
+	bool                              smf_keep_filename = false;
 
-		if (type == DataType::AUDIO) {
-			try {
-				source = open_importable_source (*p, sample_rate(), status.quality);
-				num_channels = source->channels();
-			} catch (const failed_constructor& err) {
-				error << string_compose(_("Import: cannot open input sound file \"%1\""), (*p)) << endmsg;
-				status.done = status.cancel = true;
-				return;
-			}
+	const DataType type = SMFSource::safe_midi_file_extension (job.path) ? DataType::MIDI : DataType::AUDIO;
 
-		} else {
-			try {
-				smf_reader.reset (new Evoral::SMF());
+	if (type == DataType::AUDIO) {
+		try {
+			source = open_importable_source (job.path, session.sample_rate(), status.quality);
+			num_channels = source->channels();
+		} catch (const failed_constructor& err) {
+			error << string_compose(_("Import: cannot open input sound file \"%1\""), job.path) << endmsg;
+			job.failed = true;
+			return;
+		}
 
-				if (smf_reader->open(*p)) {
-					throw Evoral::SMF::FileError (*p);
-				}
+	} else {
+		try {
+			smf_reader.reset (new Evoral::SMF());
 
-				if (smf_reader->smf_format()==0) {
-					/* Type0: we should prepare filenames for up to 16 channels in the file; we will throw out the empty ones later */
+			if (smf_reader->open(job.path)) {
+				throw Evoral::SMF::FileError (job.path);
+			}
+
+			if (smf_reader->smf_format()==0) {
+				/* Type0: we should prepare filenames for up to 16 channels in the file; we will throw out the empty ones later */
+				if (status.split_midi_channels) {
+					num_channels = 16;
+					for (uint32_t i = 0; i < num_channels; i++) {
+						smf_names.push_back (string_compose ("ch%1", 1+i ) ); //chanX
+					}
+				} else {
+					num_channels = 1;
+					smf_names.push_back("");
+				}
+			} else {
+				/* we should prepare filenames for up to 16 channels in each Track; we will throw out the empty ones later*/
+				num_channels = status.split_midi_channels ? smf_reader->num_tracks()*16 : smf_reader->num_tracks();
+				switch (status.midi_track_name_source) {
+				case SMFTrackNumber:
 					if (status.split_midi_channels) {
-						num_channels = 16;
-						for (uint32_t i = 0; i < num_channels; i++) {
-							smf_names.push_back (string_compose ("ch%1", 1+i ) ); //chanX
+						for (uint32_t i = 0; i<num_channels; i++) {
+							smf_names.push_back( string_compose ("t%1.ch%2", 1+i/16, 1+i%16 ) );  //trackX.chanX
 						}
 					} else {
-						num_channels = 1;
-						smf_names.push_back("");
-					}
-				} else {
-					/* we should prepare filenames for up to 16 channels in each Track; we will throw out the empty ones later*/
-					num_channels = status.split_midi_channels ? smf_reader->num_tracks()*16 : smf_reader->num_tracks();
-					switch (status.midi_track_name_source) {
-					case SMFTrackNumber:
-						if (status.split_midi_channels) {
-							for (uint32_t i = 0; i<num_channels; i++) {
-								smf_names.push_back( string_compose ("t%1.ch%2", 1+i/16, 1+i%16 ) );  //trackX.chanX
-							}
-						} else {
-							for (uint32_t i = 0; i<num_channels;i++) {
-								smf_names.push_back( string_compose ("t%1", i+1 ) );  //trackX
-							}
+						for (uint32_t i = 0; i<num_channels;i++) {
+							smf_names.push_back( string_compose ("t%1", i+1 ) );  //trackX
 						}
-						break;
-					case SMFFileAndTrackName:
-						smf_keep_filename = true;
-						/*FALLTHRU*/
-					case SMFTrackName:
-						if (status.split_midi_channels) {
-							vector<string> temp;
-							smf_reader->track_names (temp);
-							temp = unique_track_names (temp);
-							for (uint32_t i = 0; i<num_channels;i++) {
-								smf_names.push_back( string_compose ("%1.ch%2", temp[i/16], 1+i%16 ) );  //trackname.chanX
-							}
-						} else {
-							vector<string> temp;
-							smf_reader->track_names (temp);
-							smf_names = unique_track_names (temp);
+					}
+					break;
+				case SMFFileAndTrackName:
+					smf_keep_filename = true;
+					/*FALLTHRU*/
+				case SMFTrackName:
+					if (status.split_midi_channels) {
+						vector<string> temp;
+						smf_reader->track_names (temp);
+						temp = unique_track_names (temp);
+						for (uint32_t i = 0; i<num_channels;i++) {
+							smf_names.push_back( string_compose ("%1.ch%2", temp[i/16], 1+i%16 ) );  //trackname.chanX
 						}
-						break;
-					case SMFInstrumentName:
-						if (status.split_midi_channels) {
-							vector<string> temp;
-							smf_reader->instrument_names (temp);
-							for (uint32_t i = 0; i<num_channels;i++) {
-								smf_names.push_back( string_compose ("%1.ch%2", temp[i/16], 1+i%16 ) );  //instrument.chanX
-							}
-						} else {
-							smf_reader->instrument_names (smf_names);
+					} else {
+						vector<string> temp;
+						smf_reader->track_names (temp);
+						smf_names = unique_track_names (temp);
+					}
+					break;
+				case SMFInstrumentName:
+					if (status.split_midi_channels) {
+						vector<string> temp;
+						smf_reader->instrument_names (temp);
+						for (uint32_t i = 0; i<num_channels;i++) {
+							smf_names.push_back( string_compose ("%1.ch%2", temp[i/16], 1+i%16 ) );  //instrument.chanX
 						}
-						break;
+					} else {
+						smf_reader->instrument_names (smf_names);
 					}
+					break;
 				}
-			} catch (...) {
-				error << _("Import: error opening MIDI file") << endmsg;
-				status.done = status.cancel = true;
-				return;
 			}
+		} catch (...) {
+			error << _("Import: error opening MIDI file") << endmsg;
+			job.failed = true;
+			return;
 		}
+	}
 
-		if (num_channels == 0) {
-			error << _("Import: file contains no channels.") << endmsg;
-			continue;
-		}
+	if (num_channels == 0) {
+		error << _("Import: file contains no channels.") << endmsg;
+		return;
+	}
 
-		vector<string> new_paths = get_paths_for_new_sources (status.replace_existing_source, *p, num_channels, smf_names, smf_keep_filename);
-		Sources newfiles;
-		samplepos_t natural_position = source ? source->natural_position() : 0;
+	samplepos_t natural_position = source ? source->natural_position() : 0;
 
+	{
+		/* new source paths must be unique across all files of this import,
+		 * so paths are allocated and the files created in one go.
+		 */
+		Glib::Threads::Mutex::Lock lm (queue.session_lock);
+
+		vector<string> new_paths = session.get_paths_for_new_sources (status.replace_existing_source, job.path, num_channels, smf_names, smf_keep_filename);
 
 		if (status.replace_existing_source) {
 			fatal << "THIS IS NOT IMPLEMENTED YET, IT SHOULD NEVER GET CALLED!!! DYING!" << endmsg;
-			status.cancel = !map_existing_mono_sources (new_paths, *this, sample_rate(), newfiles, this);
+			job.failed = !map_existing_mono_sources (new_paths, session, session.sample_rate(), job.newfiles, &session);
 		} else {
-			status.cancel = !create_mono_sources_for_writing (new_paths, *this, sample_rate(), newfiles, natural_position, true);
+			job.failed = !create_mono_sources_for_writing (new_paths, session, session.sample_rate(), job.newfiles, natural_position, true);
+		}
+
+		if (!job.failed) {
+			if (source) {
+				queue.doing_what = compose_status_message (job.path, source->samplerate(), session.sample_rate(), 0, 0);
+			} else {
+				queue.doing_what = string_compose(_("Loading MIDI file %1"), job.path);
+			}
 		}
+	}
 
-		// copy on cancel/failure so that any files that were created will be removed below
-		std::copy (newfiles.begin(), newfiles.end(), std::back_inserter(all_new_sources));
+	if (job.failed) {
+		return;
+	}
 
-		if (status.cancel) {
-			break;
+	for (SourceList::iterator i = job.newfiles.begin(); i != job.newfiles.end(); ++i) {
+		if ((afs = std::dynamic_pointer_cast<AudioFileSource>(*i)) != 0) {
+			afs->prepare_for_peakfile_writes ();
 		}
+	}
 
-		for (Sources::iterator i = newfiles.begin(); i != newfiles.end(); ++i) {
-			if ((afs = std::dynamic_pointer_cast<AudioFileSource>(*i)) != 0) {
-				afs->prepare_for_peakfile_writes ();
+	if (source) { // audio
+		write_audio_data_to_new_files (source.get(), status, job.newfiles);
+	} else if (smf_reader) { // midi
+		write_midi_data_to_new_files (smf_reader.get(), status, job.newfiles, status.split_midi_channels);
+
+		if (status.import_markers) {
+			smf_reader->load_markers ();
+			for (auto const& m : smf_reader->markers ()) {
+				Temporal::Beats beats = Temporal::Beats::from_double (m.time_pulses / (double) smf_reader->ppqn ());
+				// XXX import to all sources (in case split_midi_channels is set)?
+				job.newfiles.front()->add_cue_marker (CueMarker (m.text, timepos_t (beats)));
 			}
 		}
+	}
+}
 
-		if (source) { // audio
-			status.doing_what = compose_status_message (*p, source->samplerate(),
-			                                            sample_rate(), status.current, status.total);
-			write_audio_data_to_new_files (source.get(), status, newfiles);
-		} else if (smf_reader) { // midi
-			status.doing_what = string_compose(_("Loading MIDI file %1"), *p);
-			write_midi_data_to_new_files (smf_reader.get(), status, newfiles, status.split_midi_channels);
-
-			if (status.import_markers) {
-				smf_reader->load_markers ();
-				for (auto const& m : smf_reader->markers ()) {
-					Temporal::Beats beats = Temporal::Beats::from_double (m.time_pulses / (double) smf_reader->ppqn ());
-					// XXX import to all sources (in case split_midi_channels is set)?
-					newfiles.front()->add_cue_marker (CueMarker (m.text, timepos_t (beats)));
-				}
+static void
+import_worker (Session* session, ImportQueue* queue)
+{
+	SessionEvent::create_per_thread_pool ("import events", 64);
+	Temporal::TempoMap::fetch ();
+
+	while (!queue->abort) {
+		size_t n = queue->next.fetch_add (1);
+		if (n >= queue->jobs.size ()) {
+			break;
+		}
+
+		ImportJob& job (*queue->jobs[n]);
+
+		import_one_file (*session, job, *queue);
+
+		if (job.failed) {
+			queue->abort = true;
+		}
+
+		job.finished = true;
+		++queue->n_finished;
+	}
+
+	--queue->n_running;
+}
+
+// This function is still unable to cleanly update an existing source, even though
+// it is possible to set the ImportStatus flag accordingly. The functionality
+// is disabled at the GUI until the Source implementations are able to provide
+// the necessary API.
+void
+Session::import_files (ImportStatus& status)
+{
+	typedef vector<std::shared_ptr<Source> > Sources;
+	Sources all_new_sources;
+	std::shared_ptr<AudioFileSource> afs;
+	std::shared_ptr<SMFSource> smfs;
+	ImportQueue queue;
+
+	status.sources.clear ();
+	queue.abort = status.cancel;
+
+	for (vector<string>::const_iterator p = status.paths.begin(); p != status.paths.end(); ++p) {
+		queue.jobs.push_back (std::unique_ptr<ImportJob> (new ImportJob (*p, status)));
+	}
+
+	/* Files are imported concurrently. Each worker thread decodes and
+	 * resamples one file at a time, while an ImportWriter thread per
+	 * file writes to disk. The number of workers is limited to bound
+	 * memory use and disk contention.
+	 */
+	const size_t n_workers = std::min<size_t> (queue.jobs.size (), std::min<uint32_t> (8, std::max<uint32_t> (1, hardware_concurrency ())));
+	const uint32_t first = status.current;
+	vector<PBD::Thread*> workers;
+
+	for (size_t i = 0; i < n_workers; ++i) {
+		++queue.n_running;
+		PBD::Thread* t = PBD::Thread::create (std::bind (&import_worker, this, &queue), string_compose ("Import %1", i + 1));
+		if (!t) {
+			--queue.n_running;
+			break;
+		}
+		workers.push_back (t);
+	}
+
+	if (workers.empty () && !queue.jobs.empty ()) {
+		/* no thread could be created, import in this thread */
+		++queue.n_running;
+		import_worker (this, &queue);
+	}
+
+	while (queue.n_running > 0) {
+		Glib::usleep (20000);
+
+		if (status.cancel) {
+			queue.abort = true;
+		}
+
+		float   progress = 0;
+		size_t  active   = 0;
+
+		for (auto const& job : queue.jobs) {
+			if (queue.abort) {
+				job->status.cancel = true;
 			}
+			if (job->finished) {
+				continue;
+			}
+			if (job->status.progress > 0) {
+				progress += job->status.progress;
+				++active;
+			}
+		}
+
+		{
+			Glib::Threads::Mutex::Lock lm (queue.session_lock);
+			status.doing_what = queue.doing_what;
 		}
 
-		++status.current;
-		status.progress = 0;
+		status.current  = first + (uint32_t) queue.n_finished;
+		status.progress = active > 0 ? progress / active : 0;
+	}
+
+	for (auto const& t : workers) {
+		t->join ();
+		delete t;
+	}
+
+	status.current  = first + (uint32_t) queue.n_finished;
+	status.progress = 0;
+
+	/* collect the sources in the order of status.paths; copy on
+	 * cancel/failure so that any files that were created will be removed below
+	 */
+	for (auto const& job : queue.jobs) {
+		if (job->failed) {
+			status.cancel = true;
+		}
+		std::copy (job->newfiles.begin(), job->newfiles.end(), std::back_inserter(all_new_sources));
 	}
 
 	if (!status.cancel) {
@@ -32,6 +32,7 @@
 #include "ardour/disk_reader.h"
 #include "ardour/io_tasklist.h"
 #include "ardour/process_thread.h"
+#include "ardour/process_trace.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/session_event.h"
 
@@ -140,6 +141,7 @@ IOTaskList::_worker_thread (void* me)
 
 	SessionEvent::create_per_thread_pool (name, 64);
 	PBD::notify_event_loops_about_thread_creation (pthread_self (), name, 64);
+	ProcessTrace::thread_init (string_compose ("IO-%1", id));
 
 	DiskReader::allocate_working_buffers ();
 	ARDOUR::ProcessThread* pt = new ProcessThread ();
@@ -170,6 +172,8 @@ IOTaskList::io_thread ()
 
 		Temporal::TempoMap::fetch ();
 
+		ProcessTrace::Scope trace (ProcessTrace::IOTask, "IOTaskList");
+
 		while (1) {
 			std::function<void()> fn;
 			Glib::Threads::Mutex::Lock lm (_tasks_mutex);
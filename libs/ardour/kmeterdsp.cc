@@ -18,7 +18,10 @@
  */
 
 #include <math.h>
+#include <algorithm>
+
 #include "ardour/kmeterdsp.h"
+#include "ardour/runtime_functions.h"
 
 float  Kmeterdsp::_omega;
 
@@ -65,6 +68,41 @@ Kmeterdsp::process (float const* p, int n)
 		z2 += 4 * _omega * (z1 - z2); // Update second filter.
 	}
 
+	store (z1, z2);
+}
+
+void
+Kmeterdsp::process (Kmeterdsp* const* m, float const* const* p, uint32_t n_meters, int n)
+{
+	for (uint32_t c = 0; c < n_meters; c += 4) {
+		/* unused lanes repeat the last meter */
+		const uint32_t last = std::min (c + 3, n_meters - 1);
+
+		float const* buf[4];
+		float        z1[4];
+		float        z2[4];
+
+		for (uint32_t l = 0; l < 4; ++l) {
+			const uint32_t   i = std::min (c + l, last);
+			Kmeterdsp const* k = m[i];
+			buf[l] = p[i];
+			z1[l]  = k->_z1 > 50 ? 50 : (k->_z1 < 0 ? 0 : k->_z1);
+			z2[l]  = k->_z2 > 50 ? 50 : (k->_z2 < 0 ? 0 : k->_z2);
+		}
+
+		ARDOUR::kmeter_process (buf, z1, z2, n & ~3, _omega);
+
+		for (uint32_t i = c; i <= last; ++i) {
+			m[i]->store (z1[i - c], z2[i - c]);
+		}
+	}
+}
+
+void
+Kmeterdsp::store (float z1, float z2)
+{
+	float s;
+
 	if (isnan(z1)) z1 = 0;
 	if (isnan(z2)) z2 = 0;
 
@@ -41,6 +41,8 @@
 #include "ardour/source_factory.h"
 #include "ardour/uri_map.h"
 
+#include "audiographer/general/loudness_reader.h"
+
 #include "LuaBridge/LuaBridge.h"
 
 #include "pbd/i18n.h"
@@ -1037,6 +1039,8 @@ LuaAPI::Vamp::Vamp (const std::string& key, float sample_rate)
 {
 	using namespace ::Vamp::HostExt;
 
+	Glib::Threads::Mutex::Lock lm (AudioGrapher::LoudnessReader::vamp_lock ());
+
 	PluginLoader* loader (PluginLoader::getInstance());
 	_plugin = loader->loadPlugin (key, _sample_rate, PluginLoader::ADAPT_ALL_SAFE);
 
@@ -1056,6 +1060,7 @@ LuaAPI::Vamp::Vamp (const std::string& key, float sample_rate)
 
 LuaAPI::Vamp::~Vamp ()
 {
+	Glib::Threads::Mutex::Lock lm (AudioGrapher::LoudnessReader::vamp_lock ());
 	delete _plugin;
 }
 
@@ -1074,6 +1079,7 @@ LuaAPI::Vamp::initialize ()
 	if (!_plugin || _plugin->getMinChannelCount() > 1) {
 		return false;
 	}
+	Glib::Threads::Mutex::Lock lm (AudioGrapher::LoudnessReader::vamp_lock ());
 	if (!_plugin->initialise (1, _stepsize, _bufsize)) {
 		return false;
 	}
@@ -84,6 +84,7 @@
 #include "ardour/plugin_manager.h"
 #include "ardour/polarity_processor.h"
 #include "ardour/port_manager.h"
+#include "ardour/process_trace.h"
 #include "ardour/raw_midi_parser.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/region.h"
@@ -1928,6 +1929,9 @@ LuaBindings::common (lua_State* L)
 		.endClass ()
 
 		.deriveWSPtrClass <DiskWriter, DiskIOProcessor> ("DiskWriter")
+		.addFunction ("write_latency", &DiskWriter::write_latency)
+		.addFunction ("max_write_latency", &DiskWriter::max_write_latency)
+		.addFunction ("reset_write_latency", &DiskWriter::reset_write_latency)
 		.endClass ()
 
 		.deriveWSPtrClass <IOProcessor, Processor> ("IOProcessor")
@@ -2061,6 +2065,10 @@ LuaBindings::common (lua_State* L)
 		.deriveWSPtrClass <LuaProc, Plugin> ("LuaProc")
 		.addFunction ("shmem", &LuaProc::instance_shm)
 		.addFunction ("table", &LuaProc::instance_ref)
+		.addFunction ("clear_stats", &LuaProc::clear_stats)
+		.addRefFunction ("get_stats", &LuaProc::get_stats)
+		.addFunction ("mem_used", &LuaProc::mem_used)
+		.addFunction ("mem_peak", &LuaProc::mem_peak)
 		.endClass ()
 
 		.deriveWSPtrClass <PluginInsert, Processor> ("PluginInsert")
@@ -3177,6 +3185,13 @@ LuaBindings::common (lua_State* L)
 		.addExtCFunction ("simple_export", &ARDOUR::LuaAPI::simple_export)
 		.endClass ()
 
+		.beginClass <ProcessTrace> ("ProcessTrace")
+		.addStaticFunction ("start", &ProcessTrace::start)
+		.addStaticFunction ("stop", &ProcessTrace::stop)
+		.addStaticFunction ("active", &ProcessTrace::active)
+		.addStaticFunction ("dropped", &ProcessTrace::dropped)
+		.endClass ()
+
 		.beginClass <RegionFactory> ("RegionFactory")
 		.addStaticFunction ("region_by_id", &RegionFactory::region_by_id)
 		.addStaticFunction ("regions", &RegionFactory::regions)
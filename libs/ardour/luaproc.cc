@@ -28,6 +28,7 @@
 
 #include "ardour/audio_buffer.h"
 #include "ardour/buffer_set.h"
+#include "ardour/butler.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/luabindings.h"
 #include "ardour/luaproc.h"
@@ -43,6 +44,14 @@
 using namespace ARDOUR;
 using namespace PBD;
 
+namespace {
+/* instances whose collector is run by the butler */
+Glib::Threads::Mutex  gc_instances_lock;
+std::set<LuaProc*>    gc_instances;
+}
+
+std::atomic<int> LuaProc::_gc_requests (0);
+
 LuaProc::LuaProc (AudioEngine& engine,
                   Session& session,
                   const std::string &script)
@@ -63,6 +72,16 @@ LuaProc::LuaProc (AudioEngine& engine,
 	, _requires_fixed_sized_buffers (false)
 	, _connect_all_audio_outputs (false)
 	, _set_time_info (false)
+	, _lua_time (0)
+	, _lua_in_map (0)
+	, _lua_out_map (0)
+	, _lua_midi_sink (0)
+	, _gc_pending (false)
+	, _gc_mem_kb (0)
+	, _time_looping (false)
+	, _stat_reset (0)
+	, _mem_used (0)
+	, _mem_peak (0)
 	, _designated_bypass_port (UINT32_MAX)
 	, _signal_latency (0)
 	, _control_data (0)
@@ -97,6 +116,16 @@ LuaProc::LuaProc (const LuaProc &other)
 	, _origin (other._origin)
 	, _lua_does_channelmapping (false)
 	, _lua_has_inline_display (false)
+	, _lua_time (0)
+	, _lua_in_map (0)
+	, _lua_out_map (0)
+	, _lua_midi_sink (0)
+	, _gc_pending (false)
+	, _gc_mem_kb (0)
+	, _time_looping (false)
+	, _stat_reset (0)
+	, _mem_used (0)
+	, _mem_peak (0)
 	, _designated_bypass_port (UINT32_MAX)
 	, _signal_latency (0)
 	, _control_data (0)
@@ -132,6 +161,14 @@ LuaProc::~LuaProc () {
 				_stats_max[1] * (float)_stats_cnt / _stats_avg[1]);
 	}
 #endif
+	{
+		Glib::Threads::Mutex::Lock lm (gc_instances_lock);
+		gc_instances.erase (this);
+		if (_gc_pending.load ()) {
+			_gc_requests.fetch_sub (1);
+		}
+	}
+	clear_dsp_args ();
 	lua.collect_garbage ();
 	delete (_lua_dsp);
 	delete (_lua_latency);
@@ -180,6 +217,85 @@ LuaProc::init ()
 	lua.do_command ("for n in pairs(_G) do print(n) end print ('----')"); // print global env
 #endif
 	lua.do_command ("function ardour () end");
+
+	setup_dsp_args ();
+
+	/* memory is only collected by the butler, see connect_and_run().
+	 * Lua still runs an emergency collection if the pool is exhausted.
+	 */
+	lua_gc (L, LUA_GCSTOP, 0);
+
+	Glib::Threads::Mutex::Lock lm (gc_instances_lock);
+	gc_instances.insert (this);
+}
+
+static luabridge::LuaRef*
+new_lua_table (lua_State* L, int narr, int nrec)
+{
+	lua_createtable (L, narr, nrec);
+	luabridge::LuaRef* rv = new luabridge::LuaRef (luabridge::LuaRef::fromStack (L, -1));
+	lua_pop (L, 1);
+	return rv;
+}
+
+void
+LuaProc::setup_dsp_args ()
+{
+	/* Pre-allocate all tables that are passed to the DSP function.
+	 * This is called from non-realtime context (init, reconfigure_io),
+	 * connect_and_run() only updates the values.
+	 */
+	lua_State* L = lua.getState ();
+
+	if (!_lua_time) {
+		_lua_time = new_lua_table (L, 0, 16);
+		luabridge::LuaRef& t (*_lua_time);
+		/* create all keys, so that later assignments don't need to re-hash */
+		t["sample"]          = 0;
+		t["sample_end"]      = 0;
+		t["tempo"]           = 0;
+		t["tempo_end"]       = 0;
+		t["beat"]            = 0;
+		t["beat_end"]        = 0;
+		t["ts_numerator"]    = 0;
+		t["ts_denominator"]  = 0;
+		t["tc_fps"]          = 0;
+		t["tc_dropframe"]    = false;
+		t["looping"]         = false;
+		/* loop_* keys are only present while looping */
+		_time_looping = false;
+	}
+
+	if (!_lua_midi_sink) {
+		_lua_midi_sink = new_lua_table (L, 64, 0);
+	}
+
+	const uint32_t audio_in  = std::max<uint32_t> (1, _configured_in.n_audio ());
+	const uint32_t audio_out = std::max<uint32_t> (1, _configured_out.n_audio ());
+
+	if (!_lua_in_map || _in_map_cache.size () != audio_in) {
+		delete _lua_in_map;
+		_lua_in_map = new_lua_table (L, audio_in, 0);
+		_in_map_cache.assign (audio_in, (float*)0);
+	}
+
+	if (!_lua_out_map || _out_map_cache.size () != audio_out) {
+		delete _lua_out_map;
+		_lua_out_map = new_lua_table (L, audio_out, 0);
+		_out_map_cache.assign (audio_out, (float*)0);
+	}
+}
+
+void
+LuaProc::clear_dsp_args ()
+{
+	delete _lua_time;
+	delete _lua_in_map;
+	delete _lua_out_map;
+	delete _lua_midi_sink;
+	_lua_time = _lua_in_map = _lua_out_map = _lua_midi_sink = 0;
+	_in_map_cache.clear ();
+	_out_map_cache.clear ();
 }
 
 void
@@ -724,6 +840,8 @@ LuaProc::reconfigure_io (ChanCount in, ChanCount aux_in, ChanCount out)
 	_configured_in = in;
 	_configured_out = out;
 
+	setup_dsp_args ();
+
 	return true;
 }
 
@@ -753,6 +871,22 @@ LuaProc::connect_and_run (BufferSet& bufs,
 	int64_t t0 = g_get_monotonic_time ();
 #endif
 
+	/* wait for a collector step that the butler may be running */
+	PBD::SpinLock sl (_dsp_lock);
+
+	int canderef (1);
+	if (_stat_reset.compare_exchange_strong (canderef, 0)) {
+		_timing_stats.reset ();
+		_mem_peak.store (_mem_used.load ());
+	}
+
+	_timing_stats.start ();
+
+	/* Note: except for incoming MIDI events, all tables passed to
+	 * the script are allocated in setup_dsp_args(). Here only values
+	 * are updated, which does not allocate memory unless the script
+	 * itself does so.
+	 */
 	try {
 		lua_State* L = lua.getState ();
 
@@ -762,7 +896,7 @@ LuaProc::connect_and_run (BufferSet& bufs,
 			const TempoMetric&  metric (tmap->metric_at (timepos_t (start)));
 			const TempoMetric&  metric_end (tmap->metric_at (timepos_t (end)));
 
-			luabridge::LuaRef lua_time (luabridge::newTable (L));
+			luabridge::LuaRef& lua_time (*_lua_time);
 
 			lua_time["sample"]     = start;
 			lua_time["sample_end"] = end;
@@ -785,8 +919,15 @@ LuaProc::connect_and_run (BufferSet& bufs,
 				lua_time["loop_end"]        = looploc->end ().samples ();
 				lua_time["loop_beat_start"] = DoubleableBeats (tmap->quarters_at (looploc->start ())).to_double ();
 				lua_time["loop_beat_end"]   = DoubleableBeats (tmap->quarters_at (looploc->end ())).to_double ();
-			} else {
-				lua_time["looping"] = false;
+				_time_looping = true;
+			} else if (_time_looping) {
+				/* remove the loop range once, when looping ends */
+				lua_time["looping"]         = false;
+				lua_time["loop_start"]      = luabridge::Nil ();
+				lua_time["loop_end"]        = luabridge::Nil ();
+				lua_time["loop_beat_start"] = luabridge::Nil ();
+				lua_time["loop_beat_end"]   = luabridge::Nil ();
+				_time_looping = false;
 			}
 
 			luabridge::push (L, lua_time);
@@ -801,40 +942,56 @@ LuaProc::connect_and_run (BufferSet& bufs,
 			BufferSet& silent_bufs  = _session.get_silent_buffers (ChanCount (DataType::AUDIO, 1));
 			BufferSet& scratch_bufs = _session.get_scratch_buffers (ChanCount (DataType::AUDIO, 1));
 
-			luabridge::LuaRef in_map (luabridge::newTable (L));
-			luabridge::LuaRef out_map (luabridge::newTable (L));
+			luabridge::LuaRef& in_map (*_lua_in_map);
+			luabridge::LuaRef& out_map (*_lua_out_map);
 
-			const uint32_t audio_in = _configured_in.n_audio ();
-			const uint32_t audio_out = _configured_out.n_audio ();
+			const uint32_t audio_in = std::min<uint32_t> (_configured_in.n_audio (), _in_map_cache.size ());
+			const uint32_t audio_out = std::min<uint32_t> (_configured_out.n_audio (), _out_map_cache.size ());
 			const uint32_t midi_in = _configured_in.n_midi ();
 
+			/* Pointers are passed as userdata, only update the table
+			 * when a buffer-pointer changes.
+			 */
 			for (uint32_t ap = 0; ap < audio_in; ++ap) {
 				bool valid;
+				float* ptr;
 				const uint32_t buf_index = in.get(DataType::AUDIO, ap, &valid);
 				if (valid) {
-					in_map[ap + 1] = bufs.get_audio (buf_index).data (offset);
+					ptr = bufs.get_audio (buf_index).data (offset);
 				} else {
-					in_map[ap + 1] = silent_bufs.get_audio (0).data (0);
+					ptr = silent_bufs.get_audio (0).data (0);
+				}
+				if (_in_map_cache[ap] != ptr) {
+					_in_map_cache[ap] = ptr;
+					in_map[ap + 1] = ptr;
 				}
 			}
 			for (uint32_t ap = 0; ap < audio_out; ++ap) {
 				bool valid;
+				float* ptr;
 				const uint32_t buf_index = out.get(DataType::AUDIO, ap, &valid);
 				if (valid) {
-					out_map[ap + 1] = bufs.get_audio (buf_index).data (offset);
+					ptr = bufs.get_audio (buf_index).data (offset);
 				} else {
-					out_map[ap + 1] = scratch_bufs.get_audio (0).data (0);
+					ptr = scratch_bufs.get_audio (0).data (0);
+				}
+				if (_out_map_cache[ap] != ptr) {
+					_out_map_cache[ap] = ptr;
+					out_map[ap + 1] = ptr;
 				}
 			}
 
+			/* Events are passed in new tables every cycle, scripts may
+			 * keep references to them.
+			 */
 			luabridge::LuaRef lua_midi_src_tbl (luabridge::newTable (L));
 			int e = 1; // > 1 port, we merge events (unsorted)
-			for (uint32_t mp = 0; mp < midi_in; ++mp) {
+			for (uint32_t mp = 0; mp < midi_in && _has_midi_input; ++mp) {
 				bool valid;
 				const uint32_t idx = in.get(DataType::MIDI, mp, &valid);
 				if (valid) {
 					for (MidiBuffer::iterator m = bufs.get_midi(idx).begin();
-							m != bufs.get_midi(idx).end(); ++m, ++e) {
+							m != bufs.get_midi(idx).end(); ++m) {
 						if ((*m).time() < offset || (*m).time() >= offset + nframes) {
 							continue;
 						}
@@ -850,6 +1007,7 @@ LuaProc::connect_and_run (BufferSet& bufs,
 						lua_midi_event["bytes"] = data;
 						lua_midi_event["size"] = ev.size();
 						lua_midi_src_tbl[e] = lua_midi_event;
+						++e;
 					}
 				}
 			}
@@ -860,7 +1018,7 @@ LuaProc::connect_and_run (BufferSet& bufs,
 				lua_setglobal (L, "midiin");
 			}
 
-			luabridge::LuaRef lua_midi_sink_tbl (luabridge::newTable (L));
+			luabridge::LuaRef& lua_midi_sink_tbl (*_lua_midi_sink);
 			if (_has_midi_output) {
 				luabridge::push (L, lua_midi_sink_tbl);
 				lua_setglobal (L, "midiout");
@@ -901,6 +1059,16 @@ LuaProc::connect_and_run (BufferSet& bufs,
 					}
 
 				}
+				/* empty the table for the next cycle, keep its allocated size */
+				lua_midi_sink_tbl.push (L);
+				lua_pushnil (L);
+				while (lua_next (L, -2)) {
+					lua_pop (L, 1);
+					lua_pushvalue (L, -1);
+					lua_pushnil (L);
+					lua_rawset (L, -4);
+				}
+				lua_pop (L, 1);
 			}
 		}
 
@@ -913,15 +1081,34 @@ LuaProc::connect_and_run (BufferSet& bufs,
 		std::cerr << "LuaException: " << e.what () << "\n";
 #endif
 		PBD::warning << "LuaException: " << e.what () << "\n";
+		_timing_stats.update ();
 		return -1;
 	} catch (...) {
+		_timing_stats.update ();
 		return -1;
 	}
+	_timing_stats.update ();
 #ifdef WITH_LUAPROC_STATS
 	int64_t t1 = g_get_monotonic_time ();
 #endif
 
-	lua.collect_garbage_step ();
+	/* Only collect garbage when the script allocated memory. The
+	 * collector step is run by the butler, not in the process thread.
+	 */
+	lua_State* L  = lua.getState ();
+	int    mem_kb = lua_gc (L, LUA_GCCOUNT, 0);
+	size_t used   = (size_t)mem_kb * 1024 + lua_gc (L, LUA_GCCOUNTB, 0);
+
+	_mem_used.store (used);
+	if (used > _mem_peak.load ()) {
+		_mem_peak.store (used);
+	}
+
+	if (mem_kb != _gc_mem_kb && !_gc_pending.exchange (true)) {
+		_gc_requests.fetch_add (1);
+		_session.butler ()->summon ();
+	}
+
 #ifdef WITH_LUAPROC_STATS
 	if (++_stats_cnt > 0) {
 		int64_t t2 = g_get_monotonic_time ();
@@ -936,6 +1123,46 @@ LuaProc::connect_and_run (BufferSet& bufs,
 	return 0;
 }
 
+bool
+LuaProc::get_stats (PBD::microseconds_t& min, PBD::microseconds_t& max, double& avg, double& dev) const
+{
+	return _timing_stats.get_stats (min, max, avg, dev);
+}
+
+void
+LuaProc::clear_stats ()
+{
+	_stat_reset.store (1);
+}
+
+void
+LuaProc::collect_garbage_step ()
+{
+	if (!_gc_pending.load ()) {
+		return;
+	}
+	/* do not wait for the process thread, retry next time */
+	if (!_dsp_lock.try_lock ()) {
+		return;
+	}
+	lua.collect_garbage_step ();
+	_gc_mem_kb = lua_gc (lua.getState (), LUA_GCCOUNT, 0);
+	_gc_pending.store (false);
+	_gc_requests.fetch_sub (1);
+	_dsp_lock.unlock ();
+}
+
+void
+LuaProc::collect_garbage_pending ()
+{
+	if (_gc_requests.load () == 0) {
+		return;
+	}
+	Glib::Threads::Mutex::Lock lm (gc_instances_lock);
+	for (auto const& p : gc_instances) {
+		p->collect_garbage_step ();
+	}
+}
 
 void
 LuaProc::add_state (XMLNode* root) const
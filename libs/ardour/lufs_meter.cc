@@ -31,9 +31,62 @@
 
 #include "ardour/dB.h"
 #include "ardour/lufs_meter.h"
+#include "ardour/runtime_functions.h"
 
 using namespace ARDOUR;
 
+/* Cosine windowed sinc, 48 taps for each interpolated sample:
+ * 1/4, 1/2 and 3/4 between two samples. This effectively introduces
+ * a latency of 23 samples. 2x upsampling only uses the 1/2 kernel.
+ */
+/* clang-format off */
+static const float tp_coeff[3 * 48] = {
+	/* 1/4 */
+	-2.330790e-05f, +1.321291e-04f, -3.394408e-04f, +6.562235e-04f,
+	-1.094138e-03f, +1.665807e-03f, -2.385230e-03f, +3.268371e-03f,
+	-4.334012e-03f, +5.604985e-03f, -7.109989e-03f, +8.886314e-03f,
+	-1.098403e-02f, +1.347264e-02f, -1.645206e-02f, +2.007155e-02f,
+	-2.456432e-02f, +3.031531e-02f, -3.800644e-02f, +4.896667e-02f,
+	-6.616853e-02f, +9.788141e-02f, -1.788607e-01f, +9.000753e-01f,
+	+2.993829e-01f, -1.269367e-01f, +7.922398e-02f, -5.647748e-02f,
+	+4.295093e-02f, -3.385706e-02f, +2.724946e-02f, -2.218943e-02f,
+	+1.816976e-02f, -1.489313e-02f, +1.217411e-02f, -9.891211e-03f,
+	+7.961470e-03f, -6.326144e-03f, +4.942202e-03f, -3.777065e-03f,
+	+2.805240e-03f, -2.006106e-03f, +1.362416e-03f, -8.592768e-04f,
+	+4.834383e-04f, -2.228007e-04f, +6.607267e-05f, -2.537056e-06f,
+	/* 1/2 */
+	-1.450055e-05f, +1.359163e-04f, -3.928527e-04f, +8.006445e-04f,
+	-1.375510e-03f, +2.134915e-03f, -3.098103e-03f, +4.286860e-03f,
+	-5.726614e-03f, +7.448018e-03f, -9.489286e-03f, +1.189966e-02f,
+	-1.474471e-02f, +1.811472e-02f, -2.213828e-02f, +2.700557e-02f,
+	-3.301023e-02f, +4.062971e-02f, -5.069345e-02f, +6.477499e-02f,
+	-8.625619e-02f, +1.239454e-01f, -2.101678e-01f, +6.359382e-01f,
+	+6.359382e-01f, -2.101678e-01f, +1.239454e-01f, -8.625619e-02f,
+	+6.477499e-02f, -5.069345e-02f, +4.062971e-02f, -3.301023e-02f,
+	+2.700557e-02f, -2.213828e-02f, +1.811472e-02f, -1.474471e-02f,
+	+1.189966e-02f, -9.489286e-03f, +7.448018e-03f, -5.726614e-03f,
+	+4.286860e-03f, -3.098103e-03f, +2.134915e-03f, -1.375510e-03f,
+	+8.006445e-04f, -3.928527e-04f, +1.359163e-04f, -1.450055e-05f,
+	/* 3/4 */
+	-2.537056e-06f, +6.607267e-05f, -2.228007e-04f, +4.834383e-04f,
+	-8.592768e-04f, +1.362416e-03f, -2.006106e-03f, +2.805240e-03f,
+	-3.777065e-03f, +4.942202e-03f, -6.326144e-03f, +7.961470e-03f,
+	-9.891211e-03f, +1.217411e-02f, -1.489313e-02f, +1.816976e-02f,
+	-2.218943e-02f, +2.724946e-02f, -3.385706e-02f, +4.295093e-02f,
+	-5.647748e-02f, +7.922398e-02f, -1.269367e-01f, +2.993829e-01f,
+	+9.000753e-01f, -1.788607e-01f, +9.788141e-02f, -6.616853e-02f,
+	+4.896667e-02f, -3.800644e-02f, +3.031531e-02f, -2.456432e-02f,
+	+2.007155e-02f, -1.645206e-02f, +1.347264e-02f, -1.098403e-02f,
+	+8.886314e-03f, -7.109989e-03f, +5.604985e-03f, -4.334012e-03f,
+	+3.268371e-03f, -2.385230e-03f, +1.665807e-03f, -1.094138e-03f,
+	+6.562235e-04f, -3.394408e-04f, +1.321291e-04f, -2.330790e-05f,
+};
+/* clang-format on */
+
+/* true-peak history, and max. number of samples processed at once */
+static const uint32_t tp_hist  = 47;
+static const uint32_t tp_block = 256;
+
 void
 LUFSMeter::FilterState::reset ()
 {
@@ -58,16 +111,16 @@ LUFSMeter::LUFSMeter (double samplerate, uint32_t n_channels)
 	}
 	_n_fragment = samplerate / 10;
 
-	using std::placeholders::_1;
-	using std::placeholders::_2;
 	if (samplerate > 48000) {
-		upsample = std::bind (&LUFSMeter::upsample_x2, this, _1, _2);
+		_tp_coeff  = &tp_coeff[48];
+		_tp_phases = 1;
 	} else {
-		upsample = std::bind (&LUFSMeter::upsample_x4, this, _1, _2);
+		_tp_coeff  = tp_coeff;
+		_tp_phases = 3;
 	}
 
 	for (uint32_t c = 0; c < 5; ++c) {
-		_z[c] = new float[48];
+		_z[c] = new float[tp_hist + tp_block];
 	}
 
 	init ();
@@ -85,6 +138,7 @@ void
 LUFSMeter::init ()
 {
 	float a, b, c, d, r, u, w1, w2;
+	float a0, a1, a2, b1, b2;
 
 	/* shelf */
 	r  = 1 / tan (4712.3890f / _samplerate);
@@ -98,12 +152,12 @@ LUFSMeter::init ()
 	c = w2 * u;
 	d = w2 * w2;
 
-	r   = 1 + a + b;
-	_a0 = (1 + c + d) / r;
-	_a1 = (2 - 2 * d) / r;
-	_a2 = (1 - c + d) / r;
-	_b1 = (2 - 2 * b) / r;
-	_b2 = (1 - a + b) / r;
+	r  = 1 + a + b;
+	a0 = (1 + c + d) / r;
+	a1 = (2 - 2 * d) / r;
+	a2 = (1 - c + d) / r;
+	b1 = (2 - 2 * b) / r;
+	b2 = (1 - a + b) / r;
 
 	/* HP */
 	r = 48.0f / _samplerate;
@@ -113,14 +167,16 @@ LUFSMeter::init ()
 	a *= 2 / r;
 	b *= 4 / r;
 
-	_c3 = a + b;
-	_c4 = b;
-
 	/* normalize */
 	r = 1.004995f / r;
-	_a0 *= r;
-	_a1 *= r;
-	_a2 *= r;
+
+	_coeff[0] = a0 * r;
+	_coeff[1] = a1 * r;
+	_coeff[2] = a2 * r;
+	_coeff[3] = b1;
+	_coeff[4] = b2;
+	_coeff[5] = a + b;
+	_coeff[6] = b;
 }
 
 void
@@ -128,11 +184,12 @@ LUFSMeter::reset ()
 {
 	for (uint32_t c = 0; c < _n_channels; ++c) {
 		_fst[c].reset ();
-		memset (_z[c], 0, 48 * sizeof (float));
+		memset (_z[c], 0, tp_hist * sizeof (float));
 	}
 	_frag_pos = _n_fragment;
 	_frag_pwr = 1e-30f;
 
+	_momentary_l = -200;
 	_maxloudn_M = -200;
 	_integrated = -200;
 
@@ -218,21 +275,35 @@ float
 LUFSMeter::process (float const** data, const uint32_t n_samples, uint32_t off)
 {
 	float l = 0;
-	for (uint32_t c = 0; c < _n_channels; ++c) {
-		float const* d = data[c];
-		FilterState& z = _fst[c];
-		float        s = 0;
-		for (uint32_t i = 0; i < n_samples; ++i) {
-			float x = d[i + off] - _b1 * z.z1 - _b2 * z.z2 + 1e-15f;
-			float y = _a0 * x + _a1 * z.z1 + _a2 * z.z2 - _c3 * z.z3 - _c4 * z.z4;
-			z.z2    = z.z1;
-			z.z1    = x;
-			z.z4 += z.z3;
-			z.z3 += y;
-			s += y * y;
+
+	/* four channels at a time, unused lanes repeat the last channel */
+	for (uint32_t c = 0; c < _n_channels; c += 4) {
+		const uint32_t last = std::min (c + 3, _n_channels - 1);
+
+		float const* d[4];
+		float        z[16];
+		float        s[4];
+
+		for (uint32_t k = 0; k < 4; ++k) {
+			const uint32_t i = std::min (c + k, last);
+			d[k]      = &data[i][off];
+			z[k]      = _fst[i].z1;
+			z[k + 4]  = _fst[i].z2;
+			z[k + 8]  = _fst[i].z3;
+			z[k + 12] = _fst[i].z4;
+		}
+
+		ARDOUR::kweight_process (d, z, s, n_samples, _coeff);
+
+		for (uint32_t i = c; i <= last; ++i) {
+			FilterState& fs = _fst[i];
+			fs.z1 = z[i - c];
+			fs.z2 = z[i - c + 4];
+			fs.z3 = z[i - c + 8];
+			fs.z4 = z[i - c + 12];
+			fs.sanitize ();
+			l += s[i - c] * _g[i];
 		}
-		l += s * _g[c];
-		z.sanitize ();
 	}
 
 	if (_n_channels == 1) {
@@ -276,104 +347,16 @@ LUFSMeter::dbtp () const
 	return accurate_coefficient_to_dB (_dbtp);
 }
 
-float
-LUFSMeter::upsample_x2 (int chn, float const x)
-{
-	float* r = _z[chn];
-	float  u[2];
-	r[47] = x;
-	/* 2x upsample for true-peak analysis, cosine windowed sinc.  */
-
-	/* clang-format off */
-	u[0] = r[47];
-	u[1] = r[ 0] * -1.450055e-05f + r[ 1] * +1.359163e-04f + r[ 2] * -3.928527e-04f + r[ 3] * +8.006445e-04f
-	     + r[ 4] * -1.375510e-03f + r[ 5] * +2.134915e-03f + r[ 6] * -3.098103e-03f + r[ 7] * +4.286860e-03f
-	     + r[ 8] * -5.726614e-03f + r[ 9] * +7.448018e-03f + r[10] * -9.489286e-03f + r[11] * +1.189966e-02f
-	     + r[12] * -1.474471e-02f + r[13] * +1.811472e-02f + r[14] * -2.213828e-02f + r[15] * +2.700557e-02f
-	     + r[16] * -3.301023e-02f + r[17] * +4.062971e-02f + r[18] * -5.069345e-02f + r[19] * +6.477499e-02f
-	     + r[20] * -8.625619e-02f + r[21] * +1.239454e-01f + r[22] * -2.101678e-01f + r[23] * +6.359382e-01f
-	     + r[24] * +6.359382e-01f + r[25] * -2.101678e-01f + r[26] * +1.239454e-01f + r[27] * -8.625619e-02f
-	     + r[28] * +6.477499e-02f + r[29] * -5.069345e-02f + r[30] * +4.062971e-02f + r[31] * -3.301023e-02f
-	     + r[32] * +2.700557e-02f + r[33] * -2.213828e-02f + r[34] * +1.811472e-02f + r[35] * -1.474471e-02f
-	     + r[36] * +1.189966e-02f + r[37] * -9.489286e-03f + r[38] * +7.448018e-03f + r[39] * -5.726614e-03f
-	     + r[40] * +4.286860e-03f + r[41] * -3.098103e-03f + r[42] * +2.134915e-03f + r[43] * -1.375510e-03f
-	     + r[44] * +8.006445e-04f + r[45] * -3.928527e-04f + r[46] * +1.359163e-04f + r[47] * -1.450055e-05f;
-	/* clang-format on */
-	
-	for (int i = 0; i < 47; ++i) {
-		r[i] = r[i + 1];
-	}
-
-	return std::max (u[0], u[1]);
-}
-
-float
-LUFSMeter::upsample_x4 (int chn, float const x)
-{
-	float* r = _z[chn];
-	float  u[4];
-	r[47] = x;
-	/* 4x upsample for true-peak analysis, cosine windowed sinc.
-	 * This effectively introduces a latency of 23 samples
-	 */
-
-	/* clang-format off */
-	u[0] = r[47];
-	u[1] = r[ 0] * -2.330790e-05f + r[ 1] * +1.321291e-04f + r[ 2] * -3.394408e-04f + r[ 3] * +6.562235e-04f
-	     + r[ 4] * -1.094138e-03f + r[ 5] * +1.665807e-03f + r[ 6] * -2.385230e-03f + r[ 7] * +3.268371e-03f
-	     + r[ 8] * -4.334012e-03f + r[ 9] * +5.604985e-03f + r[10] * -7.109989e-03f + r[11] * +8.886314e-03f
-	     + r[12] * -1.098403e-02f + r[13] * +1.347264e-02f + r[14] * -1.645206e-02f + r[15] * +2.007155e-02f
-	     + r[16] * -2.456432e-02f + r[17] * +3.031531e-02f + r[18] * -3.800644e-02f + r[19] * +4.896667e-02f
-	     + r[20] * -6.616853e-02f + r[21] * +9.788141e-02f + r[22] * -1.788607e-01f + r[23] * +9.000753e-01f
-	     + r[24] * +2.993829e-01f + r[25] * -1.269367e-01f + r[26] * +7.922398e-02f + r[27] * -5.647748e-02f
-	     + r[28] * +4.295093e-02f + r[29] * -3.385706e-02f + r[30] * +2.724946e-02f + r[31] * -2.218943e-02f
-	     + r[32] * +1.816976e-02f + r[33] * -1.489313e-02f + r[34] * +1.217411e-02f + r[35] * -9.891211e-03f
-	     + r[36] * +7.961470e-03f + r[37] * -6.326144e-03f + r[38] * +4.942202e-03f + r[39] * -3.777065e-03f
-	     + r[40] * +2.805240e-03f + r[41] * -2.006106e-03f + r[42] * +1.362416e-03f + r[43] * -8.592768e-04f
-	     + r[44] * +4.834383e-04f + r[45] * -2.228007e-04f + r[46] * +6.607267e-05f + r[47] * -2.537056e-06f;
-	u[2] = r[ 0] * -1.450055e-05f + r[ 1] * +1.359163e-04f + r[ 2] * -3.928527e-04f + r[ 3] * +8.006445e-04f
-	     + r[ 4] * -1.375510e-03f + r[ 5] * +2.134915e-03f + r[ 6] * -3.098103e-03f + r[ 7] * +4.286860e-03f
-	     + r[ 8] * -5.726614e-03f + r[ 9] * +7.448018e-03f + r[10] * -9.489286e-03f + r[11] * +1.189966e-02f
-	     + r[12] * -1.474471e-02f + r[13] * +1.811472e-02f + r[14] * -2.213828e-02f + r[15] * +2.700557e-02f
-	     + r[16] * -3.301023e-02f + r[17] * +4.062971e-02f + r[18] * -5.069345e-02f + r[19] * +6.477499e-02f
-	     + r[20] * -8.625619e-02f + r[21] * +1.239454e-01f + r[22] * -2.101678e-01f + r[23] * +6.359382e-01f
-	     + r[24] * +6.359382e-01f + r[25] * -2.101678e-01f + r[26] * +1.239454e-01f + r[27] * -8.625619e-02f
-	     + r[28] * +6.477499e-02f + r[29] * -5.069345e-02f + r[30] * +4.062971e-02f + r[31] * -3.301023e-02f
-	     + r[32] * +2.700557e-02f + r[33] * -2.213828e-02f + r[34] * +1.811472e-02f + r[35] * -1.474471e-02f
-	     + r[36] * +1.189966e-02f + r[37] * -9.489286e-03f + r[38] * +7.448018e-03f + r[39] * -5.726614e-03f
-	     + r[40] * +4.286860e-03f + r[41] * -3.098103e-03f + r[42] * +2.134915e-03f + r[43] * -1.375510e-03f
-	     + r[44] * +8.006445e-04f + r[45] * -3.928527e-04f + r[46] * +1.359163e-04f + r[47] * -1.450055e-05f;
-	u[3] = r[ 0] * -2.537056e-06f + r[ 1] * +6.607267e-05f + r[ 2] * -2.228007e-04f + r[ 3] * +4.834383e-04f
-	     + r[ 4] * -8.592768e-04f + r[ 5] * +1.362416e-03f + r[ 6] * -2.006106e-03f + r[ 7] * +2.805240e-03f
-	     + r[ 8] * -3.777065e-03f + r[ 9] * +4.942202e-03f + r[10] * -6.326144e-03f + r[11] * +7.961470e-03f
-	     + r[12] * -9.891211e-03f + r[13] * +1.217411e-02f + r[14] * -1.489313e-02f + r[15] * +1.816976e-02f
-	     + r[16] * -2.218943e-02f + r[17] * +2.724946e-02f + r[18] * -3.385706e-02f + r[19] * +4.295093e-02f
-	     + r[20] * -5.647748e-02f + r[21] * +7.922398e-02f + r[22] * -1.269367e-01f + r[23] * +2.993829e-01f
-	     + r[24] * +9.000753e-01f + r[25] * -1.788607e-01f + r[26] * +9.788141e-02f + r[27] * -6.616853e-02f
-	     + r[28] * +4.896667e-02f + r[29] * -3.800644e-02f + r[30] * +3.031531e-02f + r[31] * -2.456432e-02f
-	     + r[32] * +2.007155e-02f + r[33] * -1.645206e-02f + r[34] * +1.347264e-02f + r[35] * -1.098403e-02f
-	     + r[36] * +8.886314e-03f + r[37] * -7.109989e-03f + r[38] * +5.604985e-03f + r[39] * -4.334012e-03f
-	     + r[40] * +3.268371e-03f + r[41] * -2.385230e-03f + r[42] * +1.665807e-03f + r[43] * -1.094138e-03f
-	     + r[44] * +6.562235e-04f + r[45] * -3.394408e-04f + r[46] * +1.321291e-04f + r[47] * -2.330790e-05f;
-	/* clang-format on */
-
-	for (int i = 0; i < 47; ++i) {
-		r[i] = r[i + 1];
-	}
-
-	float p1 = std::max (fabsf (u[0]), fabsf (u[1]));
-	float p2 = std::max (fabsf (u[2]), fabsf (u[3]));
-	return std::max (p1, p2);
-}
-
 void
 LUFSMeter::calc_true_peak (float const** data, const uint32_t n_samples)
 {
 	for (uint32_t c = 0; c < _n_channels; ++c) {
-		float const* d = data[c];
-		for (uint32_t i = 0; i < n_samples; ++i) {
-			float peak = upsample (c, d[i]);
-			_dbtp      = std::max (_dbtp, peak);
+		float* z = _z[c];
+		for (uint32_t off = 0; off < n_samples; off += tp_block) {
+			const uint32_t n = std::min (tp_block, n_samples - off);
+			memcpy (&z[tp_hist], &data[c][off], n * sizeof (float));
+			_dbtp = ARDOUR::compute_true_peak (z, n, _tp_coeff, _tp_phases, _dbtp);
+			memmove (z, &z[n], tp_hist * sizeof (float));
 		}
 	}
 }
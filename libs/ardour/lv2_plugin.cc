@@ -43,6 +43,7 @@
 #include "pbd/compose.h"
 #include "pbd/error.h"
 #include "pbd/locale_guard.h"
+#include "pbd/pathexpand.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/replace_all.h"
 #include "pbd/xml++.h"
@@ -62,9 +63,13 @@
 #include "ardour/audioengine.h"
 #include "ardour/directory_names.h"
 #include "ardour/debug.h"
+#include "ardour/filesystem_paths.h"
 #include "ardour/lv2_evbuf.h"
 #include "ardour/lv2_plugin.h"
 #include "ardour/midi_patch_manager.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/revision.h"
 #include "ardour/session.h"
 #include "ardour/tempo.h"
 #include "ardour/types.h"
@@ -423,6 +428,7 @@ struct LV2Plugin::Impl {
 	const LilvPort* designated_input (const char* uri, void** bufptrs[], void** bufptr);
 
 	const LilvPlugin*            plugin;
+	std::string                  library; ///< URI of the plugin binary
 	const LilvUI*                ui;
 	const LilvNode*              ui_type;
 	LilvNode*                    name;
@@ -520,6 +526,8 @@ LV2Plugin::init(const void* c_plugin, samplecnt_t rate)
 	_seq_size               = _engine.raw_buffer_size(DataType::MIDI);
 	_state_version          = 0;
 	_was_activated          = false;
+	_activation_deferred    = false;
+	_activate_after_restore = false;
 	_has_state_interface    = false;
 	_can_write_automation   = false;
 #ifdef LV2_EXTENDED
@@ -696,6 +704,17 @@ LV2Plugin::init(const void* c_plugin, samplecnt_t rate)
 		_state_worker = new Worker(this, ring_size, false);
 	}
 
+	const LilvNode* library = lilv_plugin_get_library_uri (plugin);
+	if (library) {
+		_impl->library = lilv_node_as_uri (library);
+	}
+
+	/* other instances of this binary may be restoring their state
+	 * concurrently (see ::set_state). LV2 does not allow to call
+	 * discovery and instantiation functions meanwhile.
+	 */
+	wait_for_library_restore (_impl->library);
+
 	_impl->instance = lilv_plugin_instantiate(plugin, rate, _features);
 	_impl->name     = lilv_plugin_get_name(plugin);
 	_impl->author   = lilv_plugin_get_author_name(plugin);
@@ -1073,6 +1092,7 @@ LV2Plugin::~LV2Plugin ()
 {
 	DEBUG_TRACE(DEBUG::LV2, string_compose("%1 destroy\n", name()));
 
+	cancel_restore ();
 	deactivate();
 	cleanup();
 
@@ -1478,6 +1498,8 @@ LV2Plugin::add_state(XMLNode* root) const
 {
 	assert(_insert_id != PBD::ID("0"));
 
+	wait_for_restore ();
+
 	XMLNode*    child;
 	LocaleGuard lg;
 
@@ -2299,6 +2321,8 @@ LV2Plugin::set_state(const XMLNode& node, int version)
 		return -1;
 	}
 
+	wait_for_restore ();
+
 	if (version < 3000) {
 		nodes = node.children("port");
 	} else {
@@ -2356,9 +2380,23 @@ LV2Plugin::set_state(const XMLNode& node, int version)
 		LilvState* state = lilv_state_new_from_file(
 			_world.world, _uri_map.urid_map(), NULL, state_file.c_str());
 
-		lilv_state_restore(state, _impl->instance, NULL, NULL, 0, NULL);
 		lilv_state_free(_impl->state);
 		_impl->state = state;
+
+		if (_plugin_state_dir.empty ()) {
+			/* Plugins may load samples or IRs when restoring their state,
+			 * which can run concurrently with other plugins during session load.
+			 * Only the instance is used here, lilv's world is not thread-safe.
+			 * Restores of plugins from the same binary are serialized.
+			 */
+			restore_async (
+				[this, state] () { lilv_state_restore(state, _impl->instance, NULL, NULL, 0, NULL); },
+				[this] () { restore_done (); },
+				_impl->library);
+			return Plugin::set_state(node, version);
+		}
+
+		lilv_state_restore(state, _impl->instance, NULL, NULL, 0, NULL);
 	}
 
 	if (!_plugin_state_dir.empty ()) {
@@ -2633,11 +2671,36 @@ LV2Plugin::get_automation_control (uint32_t i)
 	return _ctrl_map[i];
 }
 
+void
+LV2Plugin::restore_done ()
+{
+	/* apply (de)activation that was requested while restoring */
+	if (_activation_deferred) {
+		_activation_deferred = false;
+		if (_activate_after_restore) {
+			activate ();
+		} else {
+			deactivate ();
+		}
+	}
+	if (_session.loading ()) {
+		latency_compute_run();
+	}
+}
+
 void
 LV2Plugin::activate()
 {
 	DEBUG_TRACE(DEBUG::LV2, string_compose("%1 activate\n", name()));
 
+	if (restore_pending ()) {
+		/* do not block session load, see ::restore_done */
+		_activation_deferred    = true;
+		_activate_after_restore = true;
+		return;
+	}
+	_activation_deferred = false;
+
 	if (!_was_activated) {
 		lilv_instance_activate(_impl->instance);
 		_was_activated = true;
@@ -2649,6 +2712,13 @@ LV2Plugin::deactivate()
 {
 	DEBUG_TRACE(DEBUG::LV2, string_compose("%1 deactivate\n", name()));
 
+	if (restore_pending ()) {
+		_activation_deferred    = true;
+		_activate_after_restore = false;
+		return;
+	}
+	_activation_deferred = false;
+
 	if (_was_activated) {
 		lilv_instance_deactivate(_impl->instance);
 		_was_activated = false;
@@ -2659,6 +2729,7 @@ void
 LV2Plugin::cleanup()
 {
 	DEBUG_TRACE(DEBUG::LV2, string_compose("%1 cleanup\n", name()));
+	wait_for_restore ();
 
 	deactivate();
 	lilv_instance_free(_impl->instance);
@@ -3676,6 +3747,9 @@ LV2World::load_bundled_plugins(bool verbose)
 }
 
 LV2PluginInfo::LV2PluginInfo (const char* plugin_uri)
+	: _is_instrument (false)
+	, _is_utility (false)
+	, _is_analyzer (false)
 {
 	type = ARDOUR::LV2;
 	_plugin_uri = strdup(plugin_uri);
@@ -3690,6 +3764,8 @@ LV2PluginInfo::~LV2PluginInfo()
 PluginPtr
 LV2PluginInfo::load(Session& session)
 {
+	_world.load_bundled_plugins (true);
+
 	try {
 		PluginPtr plugin;
 		const LilvPlugins* plugins = lilv_world_get_all_plugins(_world.world);
@@ -3713,6 +3789,8 @@ LV2PluginInfo::get_presets (bool user_only) const
 {
 	std::vector<Plugin::PresetRecord> p;
 
+	_world.load_bundled_plugins (true);
+
 	const LilvPlugin* lp = NULL;
 	try {
 		PluginPtr plugin;
@@ -3791,14 +3869,345 @@ LV2PluginInfo::get_presets (bool user_only) const
 	return p;
 }
 
+/* Persistent index of discovered LV2 plugins.
+ *
+ * lilv_world_load_all() parses the TTL of every installed bundle, which can
+ * take several seconds. The plugin list and the scan log are cached, along
+ * with a hash of the files of every bundle in the LV2 search path. As long as
+ * no bundle is added, removed or modified, the list is read from the index
+ * and the lilv world is only loaded when a plugin is instantiated or its
+ * presets are queried.
+ */
+
+#define LV2_INDEX_VERSION 2
+
+typedef std::map<std::string, std::string> LV2BundleMap;
+
+static std::string
+lv2_index_file ()
+{
+	return Glib::build_filename (ARDOUR::user_cache_directory (), "lv2_index.xml");
+}
+
+static std::string
+lv2_path_env ()
+{
+	return Glib::getenv ("LV2_PATH");
+}
+
+static std::string
+strip_dir_separator (std::string path)
+{
+	while (path.size () > 1 && (path[path.size () - 1] == '/' || path[path.size () - 1] == G_DIR_SEPARATOR)) {
+		path.erase (path.size () - 1);
+	}
+	return path;
+}
+
+/* directories that lilv_world_load_all() and LV2World::load_bundled_plugins() use,
+ * see also lilv's LILV_DEFAULT_LV2_PATH
+ */
+static vector<string>
+lv2_index_search_dirs ()
+{
+	string lv2_path = lv2_path_env ();
+
+	if (lv2_path.empty ()) {
+#if defined PLATFORM_WINDOWS
+		lv2_path = Glib::build_filename (Glib::getenv ("APPDATA"), "LV2")
+			+ G_SEARCHPATH_SEPARATOR_S
+			+ Glib::build_filename (Glib::getenv ("COMMONPROGRAMFILES"), "LV2");
+#elif defined __APPLE__
+		lv2_path = "~/Library/Audio/Plug-Ins/LV2:~/.lv2:/usr/local/lib/lv2:/usr/lib/lv2:/Library/Audio/Plug-Ins/LV2";
+#else
+		lv2_path = "~/.lv2:/usr/local/lib/lv2:/usr/lib/lv2";
+#endif
+	}
+
+	Searchpath sp (lv2_path);
+	sp += ARDOUR::lv2_bundled_search_path ();
+
+	vector<string> dirs;
+	for (vector<string>::const_iterator i = sp.begin (); i != sp.end (); ++i) {
+		string const d = strip_dir_separator (path_expand (*i));
+		if (!d.empty () && find (dirs.begin (), dirs.end (), d) == dirs.end ()) {
+			dirs.push_back (d);
+		}
+	}
+	return dirs;
+}
+
+/* collect name, modification time and size of all files in a bundle */
+static void
+lv2_bundle_files (string const& dir, string const& rel, vector<string>& files, int depth)
+{
+	if (depth > 8) {
+		/* guard against symlink loops */
+		return;
+	}
+
+	try {
+		Glib::Dir d (dir);
+		for (Glib::DirIterator i = d.begin (); i != d.end (); ++i) {
+			string const f = Glib::build_filename (dir, *i);
+			string const r = rel.empty () ? *i : Glib::build_filename (rel, *i);
+			GStatBuf     sb;
+			if (g_stat (f.c_str (), &sb)) {
+				continue;
+			}
+			files.push_back (string_compose ("%1 %2 %3", r, (int64_t) sb.st_mtime, (int64_t) sb.st_size));
+			if (Glib::file_test (f, Glib::FILE_TEST_IS_DIR)) {
+				lv2_bundle_files (f, r, files, depth + 1);
+			}
+		}
+	} catch (Glib::FileError const&) { }
+}
+
+/* hash of the bundle's directory tree, changes when any file in it is modified */
+static string
+lv2_bundle_hash (string const& bundle)
+{
+	GStatBuf sb;
+	if (g_stat (bundle.c_str (), &sb)) {
+		return "";
+	}
+
+	vector<string> files;
+	files.push_back (string_compose (". %1", (int64_t) sb.st_mtime));
+	lv2_bundle_files (bundle, "", files, 0);
+	sort (files.begin (), files.end ());
+
+	string s;
+	for (vector<string>::const_iterator i = files.begin (); i != files.end (); ++i) {
+		s += *i + "\n";
+	}
+	return Glib::Checksum::compute_checksum (Glib::Checksum::CHECKSUM_SHA1, s);
+}
+
+/* lilv loads every sub-directory that has a manifest.ttl */
+static void
+lv2_find_bundles (string const& dir, LV2BundleMap& bundles)
+{
+	if (!Glib::file_test (dir, Glib::FILE_TEST_IS_DIR)) {
+		return;
+	}
+
+	try {
+		Glib::Dir d (dir);
+		for (Glib::DirIterator i = d.begin (); i != d.end (); ++i) {
+			string const bundle = Glib::build_filename (dir, *i);
+			if (Glib::file_test (Glib::build_filename (bundle, "manifest.ttl"), Glib::FILE_TEST_EXISTS)) {
+				bundles[bundle] = lv2_bundle_hash (bundle);
+			}
+		}
+	} catch (Glib::FileError const&) { }
+}
+
+/** Read the plugin list from the index, if it is still valid.
+ * Additional directories that are listed in the index are added to @a dirs.
+ * The scan log that was saved with the index is passed to @a cb.
+ * @return the plugin list, or NULL if the LV2 world needs to be loaded.
+ */
 PluginInfoList*
-LV2PluginInfo::discover (std::function <void (std::string const&, PluginScanLogEntry::PluginScanResult, std::string const&, bool)> cb)
+LV2PluginInfo::read_index (vector<string>& dirs, ScanLogCallback cb)
 {
+	string const fn = lv2_index_file ();
+
+	if (!Glib::file_test (fn, Glib::FILE_TEST_EXISTS)) {
+		return NULL;
+	}
+
+	XMLTree tree;
+	if (!tree.read (fn) || tree.root ()->name () != X_("LV2Index")) {
+		return NULL;
+	}
+
+	XMLNode const* root = tree.root ();
+
+	int      version = 0;
+	uint32_t cache_version;
+	string   ardour_version;
+	string   lv2_path;
+	if (!root->get_property ("version", version) || version != LV2_INDEX_VERSION) {
+		return NULL;
+	}
+	if (!root->get_property ("ardour-version", ardour_version) || ardour_version != ARDOUR::revision) {
+		return NULL;
+	}
+	/* the plugin cache was cleared, or is outdated */
+	if (!root->get_property ("cache-version", cache_version) || cache_version != PluginManager::cache_version () || Config->get_plugin_cache_version () < cache_version) {
+		return NULL;
+	}
+	if (!root->get_property ("lv2-path", lv2_path) || lv2_path != lv2_path_env ()) {
+		return NULL;
+	}
+
+	LV2BundleMap indexed;
+
+	for (XMLNodeConstIterator i = root->children ().begin (); i != root->children ().end (); ++i) {
+		string path;
+		string hash;
+		if ((*i)->name () == X_("Directory") && (*i)->get_property ("path", path)) {
+			if (find (dirs.begin (), dirs.end (), path) == dirs.end ()) {
+				dirs.push_back (path);
+			}
+		} else if ((*i)->name () == X_("Bundle") && (*i)->get_property ("path", path) && (*i)->get_property ("hash", hash)) {
+			indexed[path] = hash;
+		}
+	}
+
+	LV2BundleMap bundles;
+	for (vector<string>::const_iterator i = dirs.begin (); i != dirs.end (); ++i) {
+		lv2_find_bundles (*i, bundles);
+	}
+
+	if (bundles != indexed) {
+		DEBUG_TRACE (DEBUG::LV2, "LV2 index is out of date\n");
+		return NULL;
+	}
+
+	XMLNode const* scan_log = root->child (X_("ScanLog"));
+	if (scan_log) {
+		for (XMLNodeConstIterator i = scan_log->children ().begin (); i != scan_log->children ().end (); ++i) {
+			string uri;
+			string msg;
+			int    result = PluginScanLogEntry::OK;
+			bool   reset  = false;
+			if (!(*i)->get_property ("uri", uri)) {
+				continue;
+			}
+			(*i)->get_property ("msg", msg);
+			(*i)->get_property ("result", result);
+			(*i)->get_property ("reset", reset);
+			cb (uri, (PluginScanLogEntry::PluginScanResult) result, msg, reset);
+		}
+	}
+
+	PluginInfoList* plugs = new PluginInfoList;
+
+	for (XMLNodeConstIterator i = root->children ().begin (); i != root->children ().end (); ++i) {
+		if ((*i)->name () != X_("Plugin")) {
+			continue;
+		}
+
+		string uri;
+		if (!(*i)->get_property ("uri", uri)) {
+			continue;
+		}
+
+		LV2PluginInfoPtr info (new LV2PluginInfo (uri.c_str ()));
+
+		(*i)->get_property ("name", info->name);
+		(*i)->get_property ("category", info->category);
+		(*i)->get_property ("creator", info->creator);
+		(*i)->get_property ("instrument", info->_is_instrument);
+		(*i)->get_property ("utility", info->_is_utility);
+		(*i)->get_property ("analyzer", info->_is_analyzer);
+		(*i)->get_property ("internal", info->internal);
+
+		XMLNode const* n;
+		if ((n = (*i)->child (X_("Inputs")))) {
+			info->n_inputs = ChanCount (*n);
+		}
+		if ((n = (*i)->child (X_("Outputs")))) {
+			info->n_outputs = ChanCount (*n);
+		}
+
+		info->path      = "/NOPATH"; // Meaningless for LV2
+		info->unique_id = uri;
+		info->index     = 0; // Meaningless for LV2
+
+		plugs->push_back (info);
+	}
+
+	DEBUG_TRACE (DEBUG::LV2, string_compose ("Listed %1 LV2 plugins from index\n", plugs->size ()));
+	return plugs;
+}
+
+void
+LV2PluginInfo::write_index (PluginInfoList const& plugs, vector<string> const& dirs, LV2BundleMap const& bundles, XMLNode* scan_log)
+{
+	XMLNode* root = new XMLNode (X_("LV2Index"));
+	root->set_property ("version", LV2_INDEX_VERSION);
+	root->set_property ("ardour-version", std::string (ARDOUR::revision));
+	root->set_property ("cache-version", PluginManager::cache_version ());
+	root->set_property ("lv2-path", lv2_path_env ());
+
+	for (vector<string>::const_iterator i = dirs.begin (); i != dirs.end (); ++i) {
+		XMLNode* n = root->add_child (X_("Directory"));
+		n->set_property ("path", *i);
+	}
+
+	for (LV2BundleMap::const_iterator i = bundles.begin (); i != bundles.end (); ++i) {
+		XMLNode* n = root->add_child (X_("Bundle"));
+		n->set_property ("path", i->first);
+		n->set_property ("hash", i->second);
+	}
+
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		LV2PluginInfoPtr info = std::dynamic_pointer_cast<LV2PluginInfo> (*i);
+		XMLNode* n = root->add_child (X_("Plugin"));
+		n->set_property ("uri", info->unique_id);
+		n->set_property ("name", info->name);
+		n->set_property ("category", info->category);
+		n->set_property ("creator", info->creator);
+		n->set_property ("instrument", info->_is_instrument);
+		n->set_property ("utility", info->_is_utility);
+		n->set_property ("analyzer", info->_is_analyzer);
+		n->set_property ("internal", info->internal);
+		n->add_child_nocopy (*info->n_inputs.state (X_("Inputs")));
+		n->add_child_nocopy (*info->n_outputs.state (X_("Outputs")));
+	}
+
+	root->add_child_nocopy (*scan_log);
+
+	XMLTree tree;
+	tree.set_root (root);
+	if (!tree.write (lv2_index_file ())) {
+		warning << string_compose (_("Could not save LV2 plugin index to '%1'"), lv2_index_file ()) << endmsg;
+		::g_unlink (lv2_index_file ().c_str ());
+	}
+}
+
+PluginInfoList*
+LV2PluginInfo::discover (ScanLogCallback report, bool use_index)
+{
+	vector<string>  dirs  = lv2_index_search_dirs ();
+	PluginInfoList* plugs = NULL;
+
+	if (use_index) {
+		plugs = read_index (dirs, report);
+	} else {
+		::g_unlink (lv2_index_file ().c_str ());
+	}
+
+	if (plugs) {
+		return plugs;
+	}
+
+	/* the scan log is saved with the index, and replayed when the index is used */
+	XMLNode* scan_log = new XMLNode (X_("ScanLog"));
+
+	auto cb = [&] (std::string const& uri, PluginScanLogEntry::PluginScanResult sr, std::string const& msg, bool reset) {
+		XMLNode* n = scan_log->add_child (X_("Log"));
+		n->set_property ("uri", uri);
+		n->set_property ("result", (int) sr);
+		n->set_property ("msg", msg);
+		n->set_property ("reset", reset);
+		report (uri, sr, msg, reset);
+	};
+
+	/* hash bundles before loading, a bundle
+	 * that is modified meanwhile is re-scanned next time */
+	LV2BundleMap bundles;
+	for (vector<string>::const_iterator i = dirs.begin (); i != dirs.end (); ++i) {
+		lv2_find_bundles (*i, bundles);
+	}
+
 	LV2World world;
 	world.load_bundled_plugins();
-	_world.load_bundled_plugins(true);
 
-	PluginInfoList*    plugs   = new PluginInfoList;
+	plugs = new PluginInfoList;
 	const LilvPlugins* plugins = lilv_world_get_all_plugins(world.world);
 
 	LILV_FOREACH(plugins, i, plugins) {
@@ -3809,6 +4218,17 @@ LV2PluginInfo::discover (std::function <void (std::string const&, PluginScanLogE
 		cb (uri, PluginScanLogEntry::OK, string_compose (_("URI: %1"), uri), true);
 		cb (uri, PluginScanLogEntry::OK, string_compose (_("Bundle: %1"), lilv_node_as_uri (lilv_plugin_get_bundle_uri (p))), false);
 
+		/* lilv may search directories that are not known to lv2_index_search_dirs () */
+		char* bundle_path = lilv_file_uri_parse (lilv_node_as_uri (lilv_plugin_get_bundle_uri (p)), NULL);
+		if (bundle_path) {
+			string const dir = Glib::path_get_dirname (strip_dir_separator (bundle_path));
+			lilv_free (bundle_path);
+			if (find (dirs.begin (), dirs.end (), dir) == dirs.end ()) {
+				dirs.push_back (dir);
+				lv2_find_bundles (dir, bundles);
+			}
+		}
+
 		LV2PluginInfoPtr info(new LV2PluginInfo(lilv_node_as_string(pun)));
 
 		LilvNode* name = lilv_plugin_get_name(p);
@@ -4031,6 +4451,8 @@ LV2PluginInfo::discover (std::function <void (std::string const&, PluginScanLogE
 		plugs->push_back(info);
 	}
 
+	write_index (*plugs, dirs, bundles, scan_log);
+
 	return plugs;
 }
 
@@ -30,6 +30,7 @@
 #include "ardour/buffer_set.h"
 #include "ardour/dB.h"
 #include "ardour/meter.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
@@ -43,6 +44,13 @@ using namespace ARDOUR;
 
 PeakMeter::PeakMeter (Session& s, const std::string& name)
 	: Processor (s, string_compose ("meter-%1", name), Temporal::TimeDomainProvider (Temporal::AudioTime))
+	, _snapshot (s.meter_snapshot ())
+	, _snapshot_slot (-1)
+	, _snapshot_channels (0)
+	, _snapshot_reset (true)
+	, _level_readers (0)
+	, _levels_read (0)
+	, _hold_samples (0)
 {
 	Kmeterdsp::init  (s.nominal_sample_rate ());
 	Iec1ppmdsp::init (s.nominal_sample_rate ());
@@ -59,6 +67,8 @@ PeakMeter::PeakMeter (Session& s, const std::string& name)
 
 PeakMeter::~PeakMeter ()
 {
+	_snapshot->release (_snapshot_slot, _snapshot_channels);
+
 	while (_kmeter.size () > 0) {
 		delete _kmeter.back ();
 		delete _iec1meter.back ();
@@ -175,17 +185,22 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 			}
 		}
 
+		_audio_data[i] = bufs.get_audio (i).data ();
+	}
+
+	/* ballistics meters process four channels at a time */
+	if (n_audio > 0) {
 		if (_meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
-			_kmeter[i]->process (bufs.get_audio (i).data (), nframes);
+			Kmeterdsp::process (&_kmeter[0], &_audio_data[0], n_audio, nframes);
 		}
 		if (_meter_type & (MeterIEC1DIN | MeterIEC1NOR)) {
-			_iec1meter[i]->process (bufs.get_audio (i).data (), nframes);
+			Iec1ppmdsp::process (&_iec1meter[0], &_audio_data[0], n_audio, nframes);
 		}
 		if (_meter_type & (MeterIEC2BBC | MeterIEC2EBU)) {
-			_iec2meter[i]->process (bufs.get_audio (i).data (), nframes);
+			Iec2ppmdsp::process (&_iec2meter[0], &_audio_data[0], n_audio, nframes);
 		}
 		if (_meter_type & MeterVU) {
-			_vumeter[i]->process (bufs.get_audio (i).data (), nframes);
+			Vumeterdsp::process (&_vumeter[0], &_audio_data[0], n_audio, nframes);
 		}
 	}
 
@@ -198,6 +213,164 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 	if (_bufcnt > zoh) {
 		_bufcnt = 0;
 	}
+
+	_hold_samples += nframes;
+	write_snapshot ();
+}
+
+/** Copy the current levels to this meter's slot of the session's
+ * meter snapshot. Called in the process thread, or when the meter
+ * is not active.
+ */
+void
+PeakMeter::write_snapshot ()
+{
+	if (_snapshot_slot < 0) {
+		return;
+	}
+
+	float* v = _snapshot->back (_snapshot_slot);
+
+	const uint32_t n_midi  = current_meters.n_midi ();
+	const uint32_t n_chan  = min (_snapshot_channels, (uint32_t)_peak_power.size ());
+	const bool     kmeter  = _meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12);
+	const bool     iec1    = _meter_type & (MeterIEC1DIN | MeterIEC1NOR);
+	const bool     iec2    = _meter_type & (MeterIEC2BBC | MeterIEC2EBU);
+	const bool     vumeter = _meter_type & MeterVU;
+
+	/* The DSPs report the maximum since their last read, which happens
+	 * every cycle. Keep the maximum across cycles, until the levels were
+	 * read by all consumers (see ::levels_read).
+	 */
+	bool restart = _snapshot_reset.exchange (false);
+
+	/* a registered reader that stopped reading (e.g. a hidden meter)
+	 * must not hold the maxima of all others forever */
+	if (restart || _hold_samples > _session.nominal_sample_rate ()) {
+		restart       = true;
+		_hold_samples = 0;
+	}
+
+	auto hold = [restart] (float& dst, float val) {
+		dst = restart ? val : max (dst, val);
+	};
+
+	for (uint32_t n = 0; n < n_chan; ++n, v += MeterSnapshot::NValues) {
+		v[MeterSnapshot::Peak]    = _peak_power[n];
+		v[MeterSnapshot::MaxPeak] = _max_peak_signal[n];
+
+		if (n < n_midi || n - n_midi >= _kmeter.size ()) {
+			continue;
+		}
+
+		const uint32_t i = n - n_midi;
+		if (kmeter) {
+			hold (v[MeterSnapshot::KRms], _kmeter[i]->read ());
+		}
+		if (iec1) {
+			hold (v[MeterSnapshot::IEC1], _iec1meter[i]->read ());
+		}
+		if (iec2) {
+			hold (v[MeterSnapshot::IEC2], _iec2meter[i]->read ());
+		}
+		if (vumeter) {
+			hold (v[MeterSnapshot::VU], _vumeter[i]->read ());
+		}
+	}
+}
+
+bool
+PeakMeter::read_levels (std::vector<float>& levels, uint64_t& seq, int reader)
+{
+	if (_snapshot_slot < 0) {
+		levels.clear ();
+		return false;
+	}
+
+	const size_t n_values = _snapshot_channels * MeterSnapshot::NValues;
+
+	if (seq != 0 && seq == _snapshot->sequence () && levels.size () == n_values) {
+		return false;
+	}
+
+	/* an inconsistent read may leave partial data, keep the
+	 * previous levels in that case. */
+	static thread_local std::vector<float> scratch;
+
+	scratch.resize (n_values);
+	if (!_snapshot->read (_snapshot_slot, n_values, &scratch[0], &seq)) {
+		return false;
+	}
+
+	levels.swap (scratch);
+	levels_read (reader);
+	return true;
+}
+
+bool
+PeakMeter::read_channel (uint32_t n, float* v) const
+{
+	if (_snapshot_slot < 0 || n >= _snapshot_channels) {
+		return false;
+	}
+	return _snapshot->read (_snapshot_slot + n * MeterSnapshot::NValues, MeterSnapshot::NValues, v);
+}
+
+int
+PeakMeter::add_level_reader ()
+{
+	uint32_t readers = _level_readers.load ();
+	for (int r = 0; r < 32; ++r) {
+		uint32_t const bit = 1u << r;
+		if (readers & bit) {
+			continue;
+		}
+		if (_level_readers.compare_exchange_strong (readers, readers | bit)) {
+			_levels_read.fetch_and (~bit);
+			return r;
+		}
+		/* readers was updated, retry */
+		r = -1;
+	}
+	return -1;
+}
+
+void
+PeakMeter::remove_level_reader (int reader)
+{
+	if (reader < 0) {
+		return;
+	}
+	uint32_t const bit = 1u << reader;
+	_level_readers.fetch_and (~bit);
+	_levels_read.fetch_and (~bit);
+	/* the remaining readers may all have read already */
+	levels_read (-1);
+}
+
+/** Called when @a reader read the levels. Restart the K/IEC/VU hold once
+ * every registered reader has seen the held maxima, or on every read if
+ * no readers are registered.
+ */
+void
+PeakMeter::levels_read (int reader)
+{
+	uint32_t const readers = _level_readers.load ();
+
+	if (readers == 0) {
+		_snapshot_reset.store (true);
+		return;
+	}
+
+	uint32_t read = _levels_read.load ();
+	if (reader >= 0) {
+		read = _levels_read.fetch_or (1u << reader) | (1u << reader);
+	}
+
+	/* only one of concurrent readers restarts */
+	if ((read & readers) == readers && _levels_read.compare_exchange_strong (read, 0)) {
+		_snapshot_reset.store (true);
+	}
 }
 
 void
@@ -214,6 +387,7 @@ PeakMeter::reset ()
 		for (size_t i = 0; i < n_midi; ++i) {
 			_peak_power[i] = 0;
 		}
+		write_snapshot ();
 	}
 
 	/* these are handled async just fine. */
@@ -223,6 +397,7 @@ PeakMeter::reset ()
 		_iec2meter[n]->reset ();
 		_vumeter[n]->reset ();
 	}
+	_snapshot_reset.store (true);
 }
 
 void
@@ -236,6 +411,7 @@ PeakMeter::reset_max ()
 		_max_peak_signal[i] = 0;
 		_peak_buffer[i]     = 0;
 	}
+	write_snapshot ();
 }
 
 bool
@@ -327,6 +503,12 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	assert (_peak_power.size () == limit);
 	assert (_max_peak_signal.size () == limit);
 
+	if (_snapshot_channels != limit) {
+		_snapshot->release (_snapshot_slot, _snapshot_channels);
+		_snapshot_slot     = _snapshot->allocate (limit);
+		_snapshot_channels = limit;
+	}
+
 	/* alloc/free other audio-only meter types. */
 	while (_kmeter.size () > n_audio) {
 		delete _kmeter.back ();
@@ -349,6 +531,8 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	assert (_iec2meter.size () == n_audio);
 	assert (_vumeter.size () == n_audio);
 
+	_audio_data.resize (n_audio);
+
 	reset ();
 	reset_max ();
 }
@@ -363,6 +547,37 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 float
 PeakMeter::meter_level (uint32_t n, MeterType type)
 {
+	/* only read the required channel(s), one at a time */
+	float v[MeterSnapshot::NValues];
+
+	float const l = level (n, type, [this, &v] (uint32_t c) -> float const* {
+		return read_channel (c, v) ? v : 0;
+	});
+
+	levels_read (-1);
+	return l;
+}
+
+float
+PeakMeter::level_of (std::vector<float> const& levels, uint32_t n, MeterType type) const
+{
+	return level (n, type, [&levels] (uint32_t c) -> float const* {
+		size_t const i = c * MeterSnapshot::NValues;
+		return i + MeterSnapshot::NValues <= levels.size () ? &levels[i] : 0;
+	});
+}
+
+/** @param channel returns the MeterSnapshot::NValues values of a
+ * channel, or NULL if they are not available.
+ */
+template <typename ChannelValues>
+float
+PeakMeter::level (uint32_t n, MeterType type, ChannelValues const& channel) const
+{
+	auto value = [] (float const* v, int i, float dflt) {
+		return v ? v[i] : dflt;
+	};
+
 	if (_reset_max.load ()) {
 		if (n < current_meters.n_midi () && type != MeterMaxPeak) {
 			return 0;
@@ -371,48 +586,38 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 		}
 	}
 
+	const uint32_t n_midi = current_meters.n_midi ();
+
 	switch (type) {
 		case MeterKrms:
 		case MeterK20:
 		case MeterK14:
 		case MeterK12:
-			{
-				const uint32_t n_midi = current_meters.n_midi ();
-				if (CHECKSIZE (_kmeter)) {
-					return accurate_coefficient_to_dB (_kmeter[n - n_midi]->read ());
-				}
+			if (CHECKSIZE (_kmeter)) {
+				return accurate_coefficient_to_dB (value (channel (n), MeterSnapshot::KRms, 0));
 			}
 			break;
 		case MeterIEC1DIN:
 		case MeterIEC1NOR:
-			{
-				const uint32_t n_midi = current_meters.n_midi ();
-				if (CHECKSIZE (_iec1meter)) {
-					return accurate_coefficient_to_dB (_iec1meter[n - n_midi]->read ());
-				}
+			if (CHECKSIZE (_iec1meter)) {
+				return accurate_coefficient_to_dB (value (channel (n), MeterSnapshot::IEC1, 0));
 			}
 			break;
 		case MeterIEC2BBC:
 		case MeterIEC2EBU:
-			{
-				const uint32_t n_midi = current_meters.n_midi ();
-				if (CHECKSIZE (_iec2meter)) {
-					return accurate_coefficient_to_dB (_iec2meter[n - n_midi]->read ());
-				}
+			if (CHECKSIZE (_iec2meter)) {
+				return accurate_coefficient_to_dB (value (channel (n), MeterSnapshot::IEC2, 0));
 			}
 			break;
 		case MeterVU:
-			{
-				const uint32_t n_midi = current_meters.n_midi ();
-				if (CHECKSIZE (_vumeter)) {
-					return accurate_coefficient_to_dB (_vumeter[n - n_midi]->read ());
-				}
+			if (CHECKSIZE (_vumeter)) {
+				return accurate_coefficient_to_dB (value (channel (n), MeterSnapshot::VU, 0));
 			}
 			break;
 		case MeterPeak:
 		case MeterPeak0dB:
 			if (n < _peak_power.size ()) {
-				return _peak_power[n];
+				return value (channel (n), MeterSnapshot::Peak, minus_infinity ());
 			}
 			break;
 		case MeterMCP:
@@ -420,13 +625,13 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 				float mcptmp = -std::numeric_limits<float>::infinity ();
 				/* prefer to report audio only on mixed tracks */
 				if (current_meters.n_audio ()) {
-					for (uint32_t i = current_meters.n_midi (); i < _peak_power.size (); ++i) {
-						mcptmp = std::max (mcptmp, _peak_power[i]);
+					for (uint32_t i = n_midi; i < _peak_power.size (); ++i) {
+						mcptmp = std::max (mcptmp, value (channel (i), MeterSnapshot::Peak, minus_infinity ()));
 					}
 				}
 				else {
-					for (uint32_t i = 0; i < current_meters.n_midi () && i < _peak_power.size (); ++i) {
-						mcptmp = std::max (mcptmp, accurate_coefficient_to_dB (_peak_power[i]));
+					for (uint32_t i = 0; i < n_midi && i < _peak_power.size (); ++i) {
+						mcptmp = std::max (mcptmp, accurate_coefficient_to_dB (value (channel (i), MeterSnapshot::Peak, 0)));
 					}
 				}
 				return mcptmp;
@@ -437,7 +642,7 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 		default:
 		case MeterMaxPeak:
 			if (n < _max_peak_signal.size ()) {
-				return accurate_coefficient_to_dB (_max_peak_signal[n]);
+				return accurate_coefficient_to_dB (value (channel (n), MeterSnapshot::MaxPeak, 0));
 			}
 			break;
 	}
@@ -0,0 +1,175 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "ardour/meter_snapshot.h"
+
+using namespace ARDOUR;
+
+/* room for 64 stereo meters, before growing */
+static const uint32_t initial_capacity = 64 * 2 * MeterSnapshot::NValues;
+
+MeterSnapshot::MeterSnapshot ()
+	: _storage (new Storage (initial_capacity))
+	, _used (0)
+	, _sequence (0)
+{
+}
+
+MeterSnapshot::~MeterSnapshot ()
+{
+	delete _storage.load ();
+	for (auto const& s : _retired) {
+		delete s;
+	}
+}
+
+int32_t
+MeterSnapshot::allocate (uint32_t n_channels)
+{
+	if (n_channels == 0) {
+		return -1;
+	}
+
+	uint32_t const size = n_channels * NValues;
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	for (auto i = _free.begin (); i != _free.end (); ++i) {
+		if (i->second < size) {
+			continue;
+		}
+		uint32_t const offset = i->first;
+		if (i->second > size) {
+			_free[offset + size] = i->second - size;
+		}
+		_free.erase (i);
+		reset_slot (_storage.load (), offset, size);
+		return offset;
+	}
+
+	uint32_t const offset = _used.load ();
+	Storage*       s      = _storage.load ();
+
+	if (offset + size > s->capacity) {
+		Storage* ns = new Storage (std::max (2 * s->capacity, offset + size));
+		std::copy (s->back.begin (), s->back.begin () + offset, ns->back.begin ());
+		std::copy (s->front.begin (), s->front.begin () + offset, ns->front.begin ());
+		_storage.store (ns, std::memory_order_release);
+		_retired.push_back (s);
+		s = ns;
+	}
+
+	reset_slot (s, offset, size);
+	_used.store (offset + size);
+
+	return offset;
+}
+
+void
+MeterSnapshot::release (int32_t slot, uint32_t n_channels)
+{
+	if (slot < 0 || n_channels == 0) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	uint32_t offset = slot;
+	uint32_t size   = n_channels * NValues;
+
+	/* merge with adjacent free blocks */
+	auto next = _free.find (offset + size);
+	if (next != _free.end ()) {
+		size += next->second;
+		_free.erase (next);
+	}
+
+	auto prev = _free.lower_bound (offset);
+	if (prev != _free.begin ()) {
+		--prev;
+		if (prev->first + prev->second == offset) {
+			offset = prev->first;
+			size  += prev->second;
+			_free.erase (prev);
+		}
+	}
+
+	if (offset + size == _used.load ()) {
+		_used.store (offset);
+	} else {
+		_free[offset] = size;
+	}
+}
+
+void
+MeterSnapshot::reset_slot (Storage* s, uint32_t offset, uint32_t size)
+{
+	for (uint32_t i = offset; i < offset + size; ++i) {
+		float const v = ((i - offset) % NValues) == Peak ? -std::numeric_limits<float>::infinity () : 0.f;
+		s->back[i]  = v;
+		s->front[i] = v;
+	}
+}
+
+void
+MeterSnapshot::publish ()
+{
+	Storage*       s = _storage.load (std::memory_order_acquire);
+	uint32_t const n = std::min (_used.load (), s->capacity);
+
+	uint64_t const seq = _sequence.load (std::memory_order_relaxed);
+
+	_sequence.store (seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence (std::memory_order_release);
+
+	memcpy (s->front.data (), s->back.data (), n * sizeof (float));
+
+	_sequence.store (seq + 2, std::memory_order_release);
+}
+
+bool
+MeterSnapshot::read (uint32_t offset, uint32_t n, float* dst, uint64_t* seq) const
+{
+	Storage* s = _storage.load (std::memory_order_acquire);
+
+	if (offset + n > s->capacity) {
+		return false;
+	}
+
+	/* publish() only copies a few kB, so this should rarely retry */
+	for (int retry = 0; retry < 64; ++retry) {
+		uint64_t const s1 = _sequence.load (std::memory_order_acquire);
+		if (s1 & 1) {
+			continue;
+		}
+
+		memcpy (dst, &s->front[offset], n * sizeof (float));
+
+		std::atomic_thread_fence (std::memory_order_acquire);
+		if (_sequence.load (std::memory_order_relaxed) == s1) {
+			if (seq) {
+				*seq = s1;
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
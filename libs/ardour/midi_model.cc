@@ -738,6 +738,21 @@ MidiModel::NoteDiffCommand::get_state () const
 	return *diff_command;
 }
 
+size_t
+MidiModel::NoteDiffCommand::memory_size () const
+{
+	/* list/set nodes add (at least) two pointers per element. Added and
+	 * removed notes are only referenced by this command once the
+	 * command is undone or redone, so count the notes themselves.
+	 */
+	size_t const node = 2 * sizeof (void*);
+	size_t const note = node + sizeof (NotePtr) + sizeof (Evoral::Note<TimeType>);
+
+	return sizeof (*this)
+		+ _changes.size () * (node + sizeof (NoteChange))
+		+ (_added_notes.size () + _removed_notes.size () + side_effect_removals.size ()) * note;
+}
+
 MidiModel::SysExDiffCommand::SysExDiffCommand (std::shared_ptr<MidiModel> m, const XMLNode& node)
 	: DiffCommand (m, "")
 {
@@ -915,6 +930,20 @@ MidiModel::SysExDiffCommand::get_state () const
 	return *diff_command;
 }
 
+size_t
+MidiModel::SysExDiffCommand::memory_size () const
+{
+	size_t const node = 2 * sizeof (void*);
+	size_t       s    = sizeof (*this) + _changes.size () * (node + sizeof (Change));
+
+	/* removed sys-ex events are only referenced by this command */
+	for (std::list<SysExPtr>::const_iterator i = _removed.begin (); i != _removed.end (); ++i) {
+		s += node + sizeof (SysExPtr) + sizeof (Evoral::Event<TimeType>) + (*i)->size ();
+	}
+
+	return s;
+}
+
 MidiModel::PatchChangeDiffCommand::PatchChangeDiffCommand (std::shared_ptr<MidiModel> m, const string& name)
 	: DiffCommand (m, name)
 {
@@ -1278,6 +1307,17 @@ MidiModel::PatchChangeDiffCommand::get_state () const
 	return *diff_command;
 }
 
+size_t
+MidiModel::PatchChangeDiffCommand::memory_size () const
+{
+	size_t const node  = 2 * sizeof (void*);
+	size_t const patch = node + sizeof (PatchChangePtr) + sizeof (Evoral::PatchChange<TimeType>);
+
+	return sizeof (*this)
+		+ _changes.size () * (node + sizeof (Change))
+		+ (_added.size () + _removed.size ()) * patch;
+}
+
 /** Write all of the model to a MidiSource (i.e. save the model).
  * This is different from manually using read to write to a source in that
  * note off events are written regardless of the track mode.  This is so the
@@ -145,6 +145,9 @@ MidiRegion::do_export (string const& path) const
 	newsrc = std::dynamic_pointer_cast<MidiSource> (SourceFactory::createWritable (DataType::MIDI, _session, path, _session.sample_rate (), false, true));
 
 	{
+		/* load the model, if that was deferred, before locking the source */
+		midi_source(0)->model();
+
 		/* Lock our source since we'll be reading from it.  write_to() will
 		 * take a lock on newsrc.
 		 */
@@ -187,6 +190,9 @@ MidiRegion::clone (std::shared_ptr<MidiSource> newsrc, ThawList* tl) const
 		node.set_property (X_("flags"), newsrc->flags ());
 		node.set_property (X_("take-id"), newsrc->take_id());
 
+		/* load the model, if that was deferred, before locking the source */
+		ms->model();
+
 		/* Lock our source since we'll be reading from it.  write_to() will
 		   take a lock on newsrc.
 		*/
@@ -468,7 +474,8 @@ MidiRegion::midi_source (uint32_t n) const
 void
 MidiRegion::model_changed ()
 {
-	if (!model()) {
+	/* do not load a deferred model, ModelChanged is emitted when it is loaded */
+	if (!midi_source()->has_model()) {
 		return;
 	}
 
@@ -67,6 +67,7 @@ using namespace PBD;
 
 MidiSource::MidiSource (Session& s, string name, Source::Flag flags)
 	: Source(s, DataType::MIDI, name, flags)
+	, _model_deferred(false)
 	, _writing(false)
 	, _capture_length(0)
 {
@@ -74,6 +75,7 @@ MidiSource::MidiSource (Session& s, string name, Source::Flag flags)
 
 MidiSource::MidiSource (Session& s, const XMLNode& node)
 	: Source(s, node)
+	, _model_deferred(false)
 	, _writing(false)
 	, _capture_length(0)
 {
@@ -485,9 +487,41 @@ MidiSource::session_saved()
 	}
 }
 
+std::shared_ptr<MidiModel>
+MidiSource::model ()
+{
+	/* _model is only assigned under the source lock, before the flag is
+	 * cleared, so it is safe to return once the flag is clear.
+	 */
+	if (!_model_deferred.load ()) {
+		return _model;
+	}
+
+	bool loaded = false;
+
+	{
+		WriterLock lm (_lock);
+		/* another thread may have loaded the model meanwhile */
+		if (_model_deferred.load ()) {
+			if (!_model) {
+				load_model (lm);
+			}
+			_model_deferred.store (false);
+			loaded = true;
+		}
+	}
+
+	if (loaded) {
+		ModelChanged (); /* EMIT SIGNAL */
+	}
+
+	return _model;
+}
+
 void
 MidiSource::drop_model (const WriterLock& lock)
 {
+	_model_deferred = false;
 	_model.reset();
 	invalidate(lock);
 	ModelChanged (); /* EMIT SIGNAL */
@@ -496,6 +530,7 @@ MidiSource::drop_model (const WriterLock& lock)
 void
 MidiSource::set_model (const WriterLock& lock, std::shared_ptr<MidiModel> m)
 {
+	_model_deferred = false;
 	_model = m;
 	std::cerr << "Source " << name() << " switched to model " << _model << std::endl;
 	invalidate(lock);
@@ -75,9 +75,10 @@ MidiStretch::run (std::shared_ptr<Region> r, Progress*)
 	}
 
 	std::shared_ptr<MidiSource> src = region->midi_source(0);
+	std::shared_ptr<MidiModel> old_model = src->model();
+
 	Source::ReaderLock lock (src->mutex());
 
-	std::shared_ptr<MidiModel> old_model = src->model();
 	std::shared_ptr<MidiSource> new_src = std::dynamic_pointer_cast<MidiSource>(nsrcs[0]);
 
 	if (!new_src) {
@@ -437,8 +437,10 @@ MidiTrack::non_realtime_locate (samplepos_t spos)
 		return;
 	}
 
-	/* the source may be missing, but the control still referenced in the GUI */
-	if (!region->midi_source() || !region->model()) {
+	/* the source may be missing, but the control still referenced in the GUI.
+	 * This runs in the butler, which must not load a deferred model.
+	 */
+	if (!region->midi_source() || !region->midi_source()->has_model()) {
 		return;
 	}
 
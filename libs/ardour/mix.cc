@@ -145,6 +145,147 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+/* Meter ballistics for four channels, @a buf holds one pointer per channel.
+ * Filter states are updated in place, @a nframes must be a multiple of four.
+ * These are the reference implementations of Kmeterdsp::process,
+ * Iec1ppmdsp::process, Iec2ppmdsp::process and Vumeterdsp::process.
+ */
+
+void
+default_kmeter_process (const ARDOUR::Sample * const * buf, float * z1, float * z2, pframes_t nframes, float omega)
+{
+	for (int c = 0; c < 4; ++c) {
+		const ARDOUR::Sample* p = buf[c];
+		float a = z1[c];
+		float b = z2[c];
+		for (pframes_t i = 0; i < nframes; i += 4) {
+			for (int j = 0; j < 4; ++j) {
+				const float s = p[i + j] * p[i + j];
+				a += omega * (s - a);
+			}
+			b += 4 * omega * (a - b);
+		}
+		z1[c] = a;
+		z2[c] = b;
+	}
+}
+
+void
+default_ppm_process (const ARDOUR::Sample * const * buf, float * z1, float * z2, float * m, pframes_t nframes, float w1, float w2, float w3)
+{
+	for (int c = 0; c < 4; ++c) {
+		const ARDOUR::Sample* p = buf[c];
+		float a  = z1[c];
+		float b  = z2[c];
+		float mx = m[c];
+		for (pframes_t i = 0; i < nframes; i += 4) {
+			a *= w3;
+			b *= w3;
+			for (int j = 0; j < 4; ++j) {
+				const float t = fabsf (p[i + j]);
+				if (t > a) a += w1 * (t - a);
+				if (t > b) b += w2 * (t - b);
+			}
+			const float t = a + b;
+			if (t > mx) mx = t;
+		}
+		z1[c] = a;
+		z2[c] = b;
+		m[c]  = mx;
+	}
+}
+
+void
+default_vumeter_process (const ARDOUR::Sample * const * buf, float * z1, float * z2, float * m, pframes_t nframes, float w)
+{
+	for (int c = 0; c < 4; ++c) {
+		const ARDOUR::Sample* p = buf[c];
+		float a  = z1[c];
+		float b  = z2[c];
+		float mx = m[c];
+		for (pframes_t i = 0; i < nframes; i += 4) {
+			const float t2 = b / 2;
+			for (int j = 0; j < 4; ++j) {
+				const float t1 = fabsf (p[i + j]) - t2;
+				a += w * (t1 - a);
+			}
+			b += 4 * w * (a - b);
+			if (b > mx) mx = b;
+		}
+		z1[c] = a;
+		z2[c] = b;
+		m[c]  = mx;
+	}
+}
+
+/* K-weighting filter (ITU-R BS.1770) for four channels, @a buf holds one
+ * pointer per channel. @a z holds the filter states, four values (one per
+ * channel) each of z1, z2, z3 and z4, which are updated in place.
+ * @a coeff are a0, a1, a2, b1, b2, c3, c4. On return @a sum holds
+ * the sum of the squared filter output of each channel.
+ * This is the reference implementation of LUFSMeter::process.
+ */
+
+void
+default_kweight_process (const ARDOUR::Sample * const * buf, float * z, float * sum, pframes_t nframes, const float * coeff)
+{
+	const float a0 = coeff[0];
+	const float a1 = coeff[1];
+	const float a2 = coeff[2];
+	const float b1 = coeff[3];
+	const float b2 = coeff[4];
+	const float c3 = coeff[5];
+	const float c4 = coeff[6];
+
+	for (int c = 0; c < 4; ++c) {
+		const ARDOUR::Sample* p = buf[c];
+		float z1 = z[c];
+		float z2 = z[c + 4];
+		float z3 = z[c + 8];
+		float z4 = z[c + 12];
+		float s  = 0;
+		for (pframes_t i = 0; i < nframes; ++i) {
+			const float x = p[i] - b1 * z1 - b2 * z2 + 1e-15f;
+			const float y = a0 * x + a1 * z1 + a2 * z2 - c3 * z3 - c4 * z4;
+			z2  = z1;
+			z1  = x;
+			z4 += z3;
+			z3 += y;
+			s  += y * y;
+		}
+		z[c]      = z1;
+		z[c + 4]  = z2;
+		z[c + 8]  = z3;
+		z[c + 12] = z4;
+		sum[c]    = s;
+	}
+}
+
+/* True-peak of an upsampled signal. @a buf holds 47 samples of history
+ * followed by @a nframes new samples. @a coeff are @a n_phases FIR kernels
+ * of 48 taps each, which interpolate between samples. For every new
+ * sample, the sample itself and its interpolated neighbours are compared.
+ * @return the maximum of @a current and the absolute value of all samples
+ */
+
+float
+default_compute_true_peak (const ARDOUR::Sample * buf, pframes_t nframes, const float * coeff, uint32_t n_phases, float current)
+{
+	for (pframes_t i = 0; i < nframes; ++i) {
+		const ARDOUR::Sample* r = &buf[i];
+		current = max (current, fabsf (r[47]));
+		for (uint32_t p = 0; p < n_phases; ++p) {
+			const float* h = &coeff[48 * p];
+			float u = r[0] * h[0];
+			for (int k = 1; k < 48; ++k) {
+				u += r[k] * h[k];
+			}
+			current = max (current, fabsf (u));
+		}
+	}
+	return current;
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -27,6 +27,9 @@
 #include "libardour-config.h"
 #endif
 
+#include <deque>
+#include <map>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -44,8 +47,12 @@
 #include <lrdf.h>
 #endif
 
+#include <glibmm/threads.h>
+
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
+#include "pbd/pthread_utils.h"
 #include "pbd/xml++.h"
 
 #include "ardour/buffer_set.h"
@@ -98,6 +105,7 @@ Plugin::Plugin (AudioEngine& e, Session& s)
 	, _resolve_midi (false)
 	, _pib (0)
 	, _num (0)
+	, _pending_restores (0)
 {
 	_pending_stop_events.ensure_buffers (DataType::MIDI, 1, 4096);
 	PresetsChanged.connect_same_thread(_preset_connection, std::bind (&Plugin::invalidate_preset_cache, this, _1, _2, _3));
@@ -120,6 +128,7 @@ Plugin::Plugin (const Plugin& other)
 	, _resolve_midi (false)
 	, _pib (other._pib)
 	, _num (other._num)
+	, _pending_restores (0)
 {
 	_pending_stop_events.ensure_buffers (DataType::MIDI, 1, 4096);
 
@@ -130,6 +139,180 @@ Plugin::~Plugin ()
 {
 }
 
+namespace {
+
+/* concurrent state restore, see Plugin::ConcurrentRestore */
+struct RestoreTask {
+	std::function<void()> work;
+	std::function<void()> done;
+	std::atomic<int>*     pending;
+	Plugin const*         plugin;
+	std::string           library;
+};
+
+Glib::Threads::Mutex      restore_lock;
+Glib::Threads::Cond       restore_cond;
+std::deque<RestoreTask>   restore_queue;
+std::vector<RestoreTask>  restore_done;
+std::vector<PBD::Thread*> restore_threads;
+int                       restore_scopes = 0;
+
+/* number of queued or running tasks per plugin library,
+ * and the libraries that a worker currently uses */
+std::map<std::string, int> restore_libraries;
+std::set<std::string>      restore_busy;
+
+void
+restore_worker ()
+{
+	Glib::Threads::Mutex::Lock lm (restore_lock);
+	while (true) {
+		/* oldest task whose library is not used by another worker */
+		std::deque<RestoreTask>::iterator i = restore_queue.begin ();
+		while (i != restore_queue.end () && !i->library.empty () && restore_busy.find (i->library) != restore_busy.end ()) {
+			++i;
+		}
+
+		if (i != restore_queue.end ()) {
+			RestoreTask t = *i;
+			restore_queue.erase (i);
+			if (!t.library.empty ()) {
+				restore_busy.insert (t.library);
+			}
+			lm.release ();
+			t.work ();
+			lm.acquire ();
+			if (!t.library.empty ()) {
+				restore_busy.erase (t.library);
+				if (--restore_libraries[t.library] == 0) {
+					restore_libraries.erase (t.library);
+				}
+			}
+			t.pending->fetch_sub (1);
+			restore_done.push_back (t);
+			restore_cond.broadcast ();
+			continue;
+		}
+		if (restore_queue.empty () && restore_scopes == 0) {
+			break;
+		}
+		restore_cond.wait (restore_lock);
+	}
+}
+
+} // namespace
+
+Plugin::ConcurrentRestore::ConcurrentRestore ()
+{
+	Glib::Threads::Mutex::Lock lm (restore_lock);
+	++restore_scopes;
+}
+
+Plugin::ConcurrentRestore::~ConcurrentRestore ()
+{
+	std::vector<PBD::Thread*> threads;
+	{
+		Glib::Threads::Mutex::Lock lm (restore_lock);
+		if (--restore_scopes > 0) {
+			return;
+		}
+		threads.swap (restore_threads);
+		restore_cond.broadcast ();
+	}
+
+	/* workers complete the queue before they terminate */
+	for (auto const& t : threads) {
+		t->join ();
+		delete t;
+	}
+
+	std::vector<RestoreTask> done;
+	{
+		Glib::Threads::Mutex::Lock lm (restore_lock);
+		done.swap (restore_done);
+	}
+	for (auto const& t : done) {
+		t.done ();
+	}
+}
+
+void
+Plugin::restore_async (std::function<void()> work, std::function<void()> done, std::string const& library)
+{
+	Glib::Threads::Mutex::Lock lm (restore_lock);
+
+	if (restore_scopes == 0) {
+		lm.release ();
+		work ();
+		done ();
+		return;
+	}
+
+	if (restore_threads.size () < PBD::hardware_concurrency ()) {
+		PBD::Thread* t = PBD::Thread::create (&restore_worker, string_compose ("PluginRestore %1", restore_threads.size ()));
+		if (t) {
+			restore_threads.push_back (t);
+		}
+	}
+
+	if (restore_threads.empty ()) {
+		lm.release ();
+		work ();
+		done ();
+		return;
+	}
+
+	RestoreTask t;
+	t.work    = work;
+	t.done    = done;
+	t.pending = &_pending_restores;
+	t.plugin  = this;
+	t.library = library;
+
+	if (!library.empty ()) {
+		++restore_libraries[library];
+	}
+	_pending_restores.fetch_add (1);
+	restore_queue.push_back (t);
+	restore_cond.broadcast ();
+}
+
+void
+Plugin::wait_for_restore () const
+{
+	if (_pending_restores.load () == 0) {
+		return;
+	}
+	Glib::Threads::Mutex::Lock lm (restore_lock);
+	while (_pending_restores.load () > 0) {
+		restore_cond.wait (restore_lock);
+	}
+}
+
+void
+Plugin::wait_for_library_restore (std::string const& library)
+{
+	Glib::Threads::Mutex::Lock lm (restore_lock);
+	while (restore_libraries.find (library) != restore_libraries.end ()) {
+		restore_cond.wait (restore_lock);
+	}
+}
+
+void
+Plugin::cancel_restore ()
+{
+	wait_for_restore ();
+
+	Glib::Threads::Mutex::Lock lm (restore_lock);
+	for (auto i = restore_done.begin (); i != restore_done.end ();) {
+		if (i->plugin == this) {
+			i = restore_done.erase (i);
+		} else {
+			++i;
+		}
+	}
+}
+
 void
 Plugin::remove_preset (string name)
 {
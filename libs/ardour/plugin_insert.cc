@@ -44,6 +44,7 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rt_tasklist.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
 
@@ -70,6 +71,8 @@ PluginInsert::PluginInsert (Session& s, Temporal::TimeDomainProvider const & tdp
 	, _latency_changed (false)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
+	, _parallel_replicas (false)
+	, _replica_failed (false)
 {
 	_stat_reset.store (0);
 	_flush.store (0);
@@ -1118,11 +1121,31 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		}
 	} else {
 		/* in-place processing */
-		uint32_t pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
+		if (_parallel_replicas && bufs.count().n_midi() == 0 && Config->get_parallel_plugin_replicas ()
+		    && _replica_tasks && _replica_tasks->size () == _plugins.size ()) {
+			/* replicated instances use distinct buffers, run them in parallel */
+			_replica_args.bufs    = &bufs;
+			_replica_args.in_map  = &in_map;
+			_replica_args.out_map = &out_map;
+			_replica_args.start   = start;
+			_replica_args.end     = end;
+			_replica_args.speed   = speed;
+			_replica_args.nframes = nframes;
+			_replica_args.offset  = offset;
+			_replica_failed       = false;
+
+			_replica_tasks->process ();
+
+			if (_replica_failed) {
 				deactivate ();
 			}
+		} else {
+			uint32_t pc = 0;
+			for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
+				if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
+					deactivate ();
+				}
+			}
 		}
 		// now silence unconnected outputs
 		inplace_silence_unconnected (bufs, _out_map, nframes, offset);
@@ -1678,9 +1701,73 @@ PluginInsert::mapping_changed ()
 {
 	PluginMapChanged (); /* EMIT SIGNAL */
 	_no_inplace = check_inplace ();
+	_parallel_replicas = check_parallel_replicas ();
 	_session.set_dirty();
 }
 
+/** Replicated instances may be processed concurrently if they are
+ * processed in-place, and no two instances share any buffer.
+ */
+bool
+PluginInsert::check_parallel_replicas () const
+{
+	if (_no_inplace || _match.method != Replicate || get_count () < 2) {
+		return false;
+	}
+
+	std::set<std::pair<DataType, uint32_t> > used;
+
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		std::set<std::pair<DataType, uint32_t> > bufs;
+		ChanMapping const* maps[] = { &_in_map.p (pc), &_out_map.p (pc) };
+		for (auto const& m : maps) {
+			for (auto const& tm : m->mappings ()) {
+				for (auto const& c : tm.second) {
+					bufs.insert (std::make_pair (tm.first, c.second));
+				}
+			}
+		}
+		for (auto const& b : bufs) {
+			if (!used.insert (b).second) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void
+PluginInsert::setup_replica_tasks ()
+{
+	/* called with the process-lock held */
+	Graph* g = _session.process_graph ();
+
+	if (!g) {
+		_parallel_replicas = false;
+		return;
+	}
+
+	if (!_replica_tasks) {
+		_replica_tasks.reset (new RTSubTaskList (g));
+	}
+
+	_replica_tasks->clear ();
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		_replica_tasks->push_back (std::bind (&PluginInsert::run_replica, this, pc));
+	}
+
+	_parallel_replicas = check_parallel_replicas ();
+}
+
+void
+PluginInsert::run_replica (uint32_t pc)
+{
+	ReplicaArgs const& a (_replica_args);
+	if (_plugins[pc]->connect_and_run (*a.bufs, a.start, a.end, a.speed, a.in_map->p (pc), a.out_map->p (pc), a.nframes, a.offset)) {
+		_replica_failed = true;
+	}
+}
+
 bool
 PluginInsert::check_inplace ()
 {
@@ -2187,6 +2274,7 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 	}
 
 	_no_inplace = check_inplace ();
+	setup_replica_tasks ();
 
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
@@ -69,6 +69,7 @@
 #include <glibmm/fileutils.h>
 
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/file_utils.h"
 #include "pbd/tokenizer.h"
 #include "pbd/whitespace.h"
@@ -476,7 +477,7 @@ PluginManager::refresh (bool cache_only)
 	lua_refresh ();
 
 	BootMessage (_("Scanning LV2 Plugins"));
-	lv2_refresh ();
+	lv2_refresh (cache_only);
 
 	bool conceal_lv1 = Config->get_conceal_lv1_if_lv2_exists();
 
@@ -1102,11 +1103,12 @@ PluginManager::lv2_plugin (std::string const& uri, PluginScanLogEntry::PluginSca
 }
 
 void
-PluginManager::lv2_refresh ()
+PluginManager::lv2_refresh (bool cache_only)
 {
 	DEBUG_TRACE (DEBUG::PluginManager, "LV2: refresh\n");
 	delete _lv2_plugin_info;
-	_lv2_plugin_info = LV2PluginInfo::discover (sigc::mem_fun (*this, &PluginManager::lv2_plugin));
+	/* an explicit scan ignores the LV2 index */
+	_lv2_plugin_info = LV2PluginInfo::discover (sigc::mem_fun (*this, &PluginManager::lv2_plugin), cache_only);
 
 	for (PluginInfoList::iterator i = _lv2_plugin_info->begin(); i != _lv2_plugin_info->end(); ++i) {
 		PSLEPtr psle (scan_log_entry (LV2, (*i)->unique_id));
@@ -1420,6 +1422,186 @@ PluginManager::au_refresh (bool cache_only)
 
 #endif
 
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+
+/** A scanner process, several of which may run at the same time */
+struct PluginManager::ScannerJob {
+	ScannerJob (std::string const& p, PSLEPtr e)
+		: path (p)
+		, psle (e)
+		, scanner (0)
+		, timeout (0)
+		, notime (true)
+		, skip_timeout (false)
+		, done (false)
+		, ok (false)
+	{}
+
+	~ScannerJob () {
+		delete scanner;
+	}
+
+	std::string           path;
+	std::string           label; /* progress message, if any */
+	PSLEPtr               psle;
+	ARDOUR::SystemExec*   scanner;
+	std::stringstream     log;
+	PBD::ScopedConnection connection;
+	int                   timeout; /* deciseconds */
+	bool                  notime;
+	bool                  skip_timeout;
+	bool                  done;
+	bool                  ok;
+};
+
+static void scanner_job_log (std::string msg, std::stringstream* ss)
+{
+	*ss << msg;
+}
+
+uint32_t
+PluginManager::max_concurrent_scans () const
+{
+	uint32_t n = Config->get_plugin_scan_jobs ();
+	if (n == 0) {
+		n = std::min<uint32_t> (8, PBD::hardware_concurrency ());
+	}
+	return std::max<uint32_t> (1, n);
+}
+
+/* Run the scanner app for all given jobs, at most max_concurrent_scans() at a time.
+ * Every job has its own timeout. Cancelling the scan of "one" plugin, or
+ * skipping its timeout applies to all plugins that are being scanned at the time.
+ */
+void
+PluginManager::run_scanner_apps (std::string const& bin_path, std::vector<ScannerJob*> const& jobs,
+                                 std::function<void(std::string const&, PSLEPtr)> prepare,
+                                 std::function<void(std::string const&)> abort)
+{
+	size_t const max_running = max_concurrent_scans ();
+	size_t next = 0;
+
+	std::list<ScannerJob*> running;
+
+	while (true) {
+		/* collect scanners that have completed */
+		for (std::list<ScannerJob*>::iterator i = running.begin (); i != running.end ();) {
+			ScannerJob* job = *i;
+			if (job->scanner->is_running ()) {
+				++i;
+				continue;
+			}
+			delete job->scanner; // wait for stdout
+			job->scanner = 0;
+			job->psle->msg (PluginScanLogEntry::OK, job->log.str());
+			job->ok = true;
+			i = running.erase (i);
+		}
+
+		/* launch new scanners */
+		while (running.size () < max_running && next < jobs.size () && !_cancel_scan_all) {
+			ScannerJob* job = jobs[next++];
+
+			prepare (job->path, job->psle);
+			if (!job->label.empty ()) {
+				ARDOUR::PluginScanMessage (job->label, job->path, true);
+			}
+
+			char **argp= (char**) calloc (5, sizeof (char*));
+			argp[0] = strdup (bin_path.c_str ());
+			argp[1] = strdup ("-f");
+			if (Config->get_verbose_plugin_scan()) {
+				argp[2] = strdup ("-v");
+			} else {
+				argp[2] = strdup ("-f");
+			}
+			argp[3] = strdup (job->path.c_str ());
+			argp[4] = 0;
+
+			job->done    = true;
+			job->scanner = new ARDOUR::SystemExec (bin_path, argp);
+			job->scanner->ReadStdout.connect_same_thread (job->connection, std::bind (&scanner_job_log, _1, &job->log));
+
+			if (job->scanner->start (ARDOUR::SystemExec::MergeWithStdin)) {
+				job->psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), bin_path, strerror (errno)));
+				delete job->scanner;
+				job->scanner = 0;
+				continue;
+			}
+
+			job->timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0;
+			job->notime  = (job->timeout <= 0);
+			running.push_back (job);
+		}
+
+		if (running.empty ()) {
+			break;
+		}
+
+		for (std::list<ScannerJob*>::iterator i = running.begin (); i != running.end (); ++i) {
+			ScannerJob* job = *i;
+			if (_cancel_scan_timeout_one) {
+				job->skip_timeout = true;
+			}
+			bool no_tmo = job->skip_timeout || _cancel_scan_timeout_all;
+
+			if (!job->notime && no_tmo) {
+				job->notime = true;
+				job->timeout = -1;
+			} else if (job->notime && !no_tmo && _enable_scan_timeout) {
+				job->notime = false;
+				job->timeout = 1 + Config->get_plugin_scan_timeout ();
+			}
+
+			if (job->timeout > -864000) {
+				--job->timeout;
+			}
+		}
+		_cancel_scan_timeout_one = false;
+
+		/* the oldest scanner is the first to time out */
+		ARDOUR::PluginScanTimeout (running.front ()->timeout);
+		Glib::usleep (100000);
+
+		bool const cancel = cancelled ();
+
+		for (std::list<ScannerJob*>::iterator i = running.begin (); i != running.end ();) {
+			ScannerJob* job = *i;
+			if (!cancel && (job->notime || job->timeout != 0)) {
+				++i;
+				continue;
+			}
+			job->scanner->terminate ();
+			delete job->scanner;
+			job->scanner = 0;
+			job->psle->msg (PluginScanLogEntry::OK, job->log.str());
+			if (cancel) {
+				job->psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
+			} else {
+				job->psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
+			}
+			/* may be partially written */
+			abort (job->path);
+			i = running.erase (i);
+		}
+		_cancel_scan_one = false;
+	}
+}
+
+bool
+PluginManager::prescanned (std::string const& path, bool& ok)
+{
+	std::map<std::string, bool>::iterator i = _scanner_results.find (path);
+	if (i == _scanner_results.end ()) {
+		return false;
+	}
+	ok = i->second;
+	_scanner_results.erase (i);
+	return true;
+}
+
+#endif
+
 #if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
 
 static bool vst2_is_blacklisted (string const& module_path)
@@ -1479,69 +1661,58 @@ static void vst2_whitelist (string module_path)
 	Glib::file_set_contents (fn, bl);
 }
 
-static void vst2_scanner_log (std::string msg, std::stringstream* ss)
+static void vst2_scan_prepare (std::string const& path, PSLEPtr psle)
 {
-	*ss << msg;
+	psle->reset ();
+	vst2_blacklist (path);
+}
+
+static void vst2_scan_abort (std::string const& path)
+{
+	g_unlink (vst2_cache_file (path).c_str ());
+	vst2_whitelist (path);
 }
 
 bool
-PluginManager::run_vst2_scanner_app (std::string path, PSLEPtr psle) const
+PluginManager::run_vst2_scanner_app (std::string path, PSLEPtr psle)
 {
-	char **argp= (char**) calloc (5, sizeof (char*));
-	argp[0] = strdup (vst2_scanner_bin_path.c_str ());
-	argp[1] = strdup ("-f");
-	if (Config->get_verbose_plugin_scan()) {
-		argp[2] = strdup ("-v");
-	} else {
-		argp[2] = strdup ("-f");
-	}
-	argp[3] = strdup (path.c_str ());
-	argp[4] = 0;
+	ScannerJob job (path, psle);
+	run_scanner_apps (vst2_scanner_bin_path, std::vector<ScannerJob*> (1, &job), &vst2_scan_prepare, &vst2_scan_abort);
+	return job.ok;
+}
 
-	stringstream scan_log;
-	ARDOUR::SystemExec scanner (vst2_scanner_bin_path, argp);
-	PBD::ScopedConnection c;
-	scanner.ReadStdout.connect_same_thread (c, std::bind (&vst2_scanner_log, _1, &scan_log));
+/* Run the scanner app for all modules that need to be scanned, concurrently.
+ * The results are collected by vst2_discover(), in order.
+ */
+void
+PluginManager::vst2_prescan (std::vector<std::string> const& modules, ARDOUR::PluginType type)
+{
+	_scanner_results.clear ();
 
-	if (scanner.start (ARDOUR::SystemExec::MergeWithStdin)) {
-		psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), vst2_scanner_bin_path, strerror (errno)));
-		return false;
+	if (vst2_scanner_bin_path.empty () || cancelled ()) {
+		return;
 	}
 
-	int timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0; /* deciseconds */
-	bool notime = (timeout <= 0);
+	std::vector<ScannerJob*> jobs;
 
-	while (scanner.is_running () && (notime || timeout > 0)) {
-		if (!notime && no_timeout ()) {
-			notime = true;
-			timeout = -1;
-		} else if (notime && !no_timeout() && _enable_scan_timeout) {
-			notime = false;
-			timeout = 1 + Config->get_plugin_scan_timeout ();
+	size_t n = 1;
+	for (std::vector<std::string>::const_iterator i = modules.begin (); i != modules.end (); ++i, ++n) {
+		if (vst2_is_blacklisted (*i) || !vst2_valid_cache_file (*i).empty ()) {
+			continue;
 		}
+		ScannerJob* job = new ScannerJob (*i, scan_log_entry (type, *i));
+		job->label = string_compose (_("VST2 (%1 / %2)"), n, modules.size ());
+		jobs.push_back (job);
+	}
 
-		if (timeout > -864000) {
-			--timeout;
-		}
-		ARDOUR::PluginScanTimeout (timeout);
-		Glib::usleep (100000);
+	run_scanner_apps (vst2_scanner_bin_path, jobs, &vst2_scan_prepare, &vst2_scan_abort);
 
-		if (cancelled () || (!notime && timeout == 0)) {
-			scanner.terminate ();
-			psle->msg (PluginScanLogEntry::OK, scan_log.str());
-			if (cancelled ()) {
-				psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
-			} else {
-				psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
-			}
-			/* may be partially written */
-			g_unlink (vst2_cache_file (path).c_str ());
-			vst2_whitelist (path);
-			return false;
+	for (std::vector<ScannerJob*>::const_iterator i = jobs.begin (); i != jobs.end (); ++i) {
+		if ((*i)->done) {
+			_scanner_results[(*i)->path] = (*i)->ok;
 		}
+		delete *i;
 	}
-	psle->msg (PluginScanLogEntry::OK, scan_log.str());
-	return true;
 }
 
 bool
@@ -1626,7 +1797,14 @@ PluginManager::vst2_discover (string path, ARDOUR::PluginType type, bool cache_o
 
 	PSLEPtr psle (scan_log_entry (type, path));
 
-	if (vst2_is_blacklisted (path)) {
+	bool scan_ok;
+	bool const scanned = prescanned (path, scan_ok);
+
+	if (scanned && !scan_ok) {
+		return -1;
+	}
+
+	if (!scanned && vst2_is_blacklisted (path)) {
 		psle->msg (PluginScanLogEntry::Blacklisted);
 		return -1;
 	}
@@ -1668,12 +1846,9 @@ PluginManager::vst2_discover (string path, ARDOUR::PluginType type, bool cache_o
 		run_scan = true;
 	}
 
-	if (!cache_only && run_scan) {
-		/* re/generate cache file */
-		psle->reset ();
-		vst2_blacklist (path);
-
-		if (!run_vst2_scanner_app (path, psle)) {
+	if (scanned || (!cache_only && run_scan)) {
+		/* re/generate cache file, unless vst2_prescan() already did */
+		if (!scanned && !run_vst2_scanner_app (path, psle)) {
 			return -1;
 		}
 
@@ -1786,6 +1961,10 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	if (!cache_only) {
+		vst2_prescan (plugin_objects, Windows_VST);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
@@ -1875,6 +2054,10 @@ PluginManager::mac_vst_discover_from_path (string path, std::set<std::string>& s
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	if (!cache_only) {
+		vst2_prescan (plugin_objects, MacVST);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
@@ -1935,6 +2118,10 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	if (!cache_only) {
+		vst2_prescan (plugin_objects, LXVST);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
@@ -2085,6 +2272,10 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 
 	find_paths_matching_filter (plugin_objects, paths, vst3_filter, 0, false, true, true);
 
+	if (!cache_only) {
+		vst3_prescan (plugin_objects);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i, ++n) {
@@ -2145,7 +2336,14 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 
 	PSLEPtr psle (scan_log_entry (VST3, path));
 
-	if (vst3_is_blacklisted (module_path)) {
+	bool scan_ok;
+	bool const scanned = prescanned (path, scan_ok);
+
+	if (scanned && !scan_ok) {
+		return -1;
+	}
+
+	if (!scanned && vst3_is_blacklisted (module_path)) {
 		psle->msg (PluginScanLogEntry::Blacklisted);
 		return -1;
 	}
@@ -2181,12 +2379,9 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 		run_scan = true;
 	}
 
-	if (!cache_only && run_scan) {
-		/* re/generate cache file */
-		psle->reset ();
-		vst3_blacklist (module_path);
-		psle->msg (PluginScanLogEntry::OK, string_compose ("VST3 module-path '%1'", module_path));
-		if (!run_vst3_scanner_app (path, psle)) {
+	if (scanned || (!cache_only && run_scan)) {
+		/* re/generate cache file, unless vst3_prescan() already did */
+		if (!scanned && !run_vst3_scanner_app (path, psle)) {
 			return -1;
 		}
 
@@ -2240,72 +2435,64 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 	return 0;
 }
 
-static void vst3_scanner_log (std::string msg, std::stringstream* ss)
+static void vst3_scan_prepare (std::string const& bundle_path, PSLEPtr psle)
 {
-	*ss << msg;
+	std::string module_path = module_path_vst3 (bundle_path);
+	psle->reset ();
+	vst3_blacklist (module_path);
+	psle->msg (PluginScanLogEntry::OK, string_compose ("VST3 module-path '%1'", module_path));
 }
 
-bool
-PluginManager::run_vst3_scanner_app (std::string bundle_path, PSLEPtr psle) const
+static void vst3_scan_abort (std::string const& bundle_path)
 {
-	char **argp= (char**) calloc (5, sizeof (char*));
-	argp[0] = strdup (vst3_scanner_bin_path.c_str ());
-	argp[1] = strdup ("-f");
-	if (Config->get_verbose_plugin_scan()) {
-		argp[2] = strdup ("-v");
-	} else {
-		argp[2] = strdup ("-f");
+	std::string module_path = module_path_vst3 (bundle_path);
+	if (!module_path.empty ()) {
+		g_unlink (vst3_cache_file (module_path).c_str ());
 	}
-	argp[3] = strdup (bundle_path.c_str ());
-	argp[4] = 0;
+	vst3_whitelist (module_path);
+}
 
-	stringstream scan_log;
-	ARDOUR::SystemExec scanner (vst3_scanner_bin_path, argp);
-	PBD::ScopedConnection c;
-	scanner.ReadStdout.connect_same_thread (c, std::bind (&vst3_scanner_log, _1, &scan_log));
+bool
+PluginManager::run_vst3_scanner_app (std::string bundle_path, PSLEPtr psle)
+{
+	ScannerJob job (bundle_path, psle);
+	run_scanner_apps (vst3_scanner_bin_path, std::vector<ScannerJob*> (1, &job), &vst3_scan_prepare, &vst3_scan_abort);
+	return job.ok;
+}
 
-	if (scanner.start (ARDOUR::SystemExec::MergeWithStdin)) {
-		psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), vst3_scanner_bin_path, strerror (errno)));
-		return false;
+/* Run the scanner app for all bundles that need to be scanned, concurrently.
+ * The results are collected by vst3_discover(), in order.
+ */
+void
+PluginManager::vst3_prescan (std::vector<std::string> const& bundles)
+{
+	_scanner_results.clear ();
+
+	if (vst3_scanner_bin_path.empty () || cancelled ()) {
+		return;
 	}
 
-	int timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0; /* deciseconds */
-	bool notime = (timeout <= 0);
+	std::vector<ScannerJob*> jobs;
 
-	while (scanner.is_running () && (notime || timeout > 0)) {
-		if (!notime && no_timeout ()) {
-			notime = true;
-			timeout = -1;
-		} else if (notime && !no_timeout() && _enable_scan_timeout) {
-			notime = false;
-			timeout = 1 + Config->get_plugin_scan_timeout ();
+	size_t n = 1;
+	for (std::vector<std::string>::const_iterator i = bundles.begin (); i != bundles.end (); ++i, ++n) {
+		string module_path = module_path_vst3 (*i);
+		if (module_path.empty () || module_path == "-1" || vst3_is_blacklisted (module_path) || !vst3_valid_cache_file (module_path).empty ()) {
+			continue;
 		}
+		ScannerJob* job = new ScannerJob (*i, scan_log_entry (VST3, *i));
+		job->label = string_compose (_("VST3 (%1 / %2)"), n, bundles.size ());
+		jobs.push_back (job);
+	}
 
-		if (timeout > -864000) {
-			--timeout;
-		}
-		ARDOUR::PluginScanTimeout (timeout);
-		Glib::usleep (100000);
+	run_scanner_apps (vst3_scanner_bin_path, jobs, &vst3_scan_prepare, &vst3_scan_abort);
 
-		if (cancelled () || (!notime && timeout == 0)) {
-			scanner.terminate ();
-			psle->msg (PluginScanLogEntry::OK, scan_log.str());
-			if (cancelled ()) {
-				psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
-			} else {
-				psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
-			}
-			/* may be partially written */
-			std::string module_path = module_path_vst3 (bundle_path);
-			if (!module_path.empty ()) {
-				g_unlink (vst3_cache_file (module_path).c_str ());
-			}
-			vst3_whitelist (module_path);
-			return false;
+	for (std::vector<ScannerJob*>::const_iterator i = jobs.begin (); i != jobs.end (); ++i) {
+		if ((*i)->done) {
+			_scanner_results[(*i)->path] = (*i)->ok;
 		}
+		delete *i;
 	}
-	psle->msg (PluginScanLogEntry::OK, scan_log.str());
-	return true;
 }
 
 #endif // VST3_SUPPORT
@@ -0,0 +1,274 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <glibmm/threads.h>
+#include <glibmm/timer.h>
+
+#include "pbd/gstdio_compat.h"
+#include "pbd/microseconds.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/ringbuffer.h"
+
+#include "ardour/process_trace.h"
+
+using namespace ARDOUR;
+
+std::atomic<bool>     ProcessTrace::_active (false);
+std::atomic<uint64_t> ProcessTrace::_dropped (0);
+
+namespace {
+
+struct TraceEvent {
+	int64_t                start;
+	int64_t                end;
+	ProcessTrace::Category category;
+	char                   name[48];
+};
+
+struct ThreadTrace {
+	ThreadTrace (std::string const& n, uint32_t id)
+		: name (n)
+		, tid (id)
+		, events (16384)
+		, announced (false)
+	{}
+
+	std::string                 name;
+	uint32_t                    tid;
+	PBD::RingBuffer<TraceEvent> events;
+	bool                        announced;
+};
+
+/* Thread traces are never deleted, a thread may record an event at any time */
+Glib::Threads::Mutex      threads_lock;
+std::vector<ThreadTrace*> threads;
+
+thread_local ThreadTrace* this_thread = 0;
+
+/* only used by start(), stop() and the writer thread */
+Glib::Threads::Mutex api_lock;
+FILE*                trace_file   = 0;
+PBD::Thread*         writer       = 0;
+std::atomic<bool>    run_writer (false);
+int64_t              trace_start  = 0;
+bool                 first_event  = true;
+
+const char*
+category_name (ProcessTrace::Category c)
+{
+	switch (c) {
+		case ProcessTrace::Cycle:
+			return "cycle";
+		case ProcessTrace::GraphNode:
+			return "graph";
+		case ProcessTrace::Processor:
+			return "processor";
+		case ProcessTrace::Butler:
+			return "butler";
+		case ProcessTrace::IOTask:
+			return "io";
+	}
+	return "";
+}
+
+void
+write_json_string (FILE* f, char const* s)
+{
+	fputc ('"', f);
+	for (; *s; ++s) {
+		unsigned char c = *s;
+		if (c == '"' || c == '\\') {
+			fputc ('\\', f);
+			fputc (c, f);
+		} else if (c < 0x20) {
+			fprintf (f, "\\u%04x", c);
+		} else {
+			fputc (c, f);
+		}
+	}
+	fputc ('"', f);
+}
+
+void
+separate ()
+{
+	if (!first_event) {
+		fputs (",\n", trace_file);
+	}
+	first_event = false;
+}
+
+/* collect events from all threads, and write them to the trace file */
+void
+flush_events (bool discard)
+{
+	Glib::Threads::Mutex::Lock lm (threads_lock);
+
+	for (auto const& tt : threads) {
+		if (!discard && !tt->announced) {
+			separate ();
+			fprintf (trace_file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", tt->tid);
+			write_json_string (trace_file, tt->name.c_str ());
+			fputs ("}}", trace_file);
+			tt->announced = true;
+		}
+
+		TraceEvent ev;
+		while (tt->events.read (&ev, 1) == 1) {
+			if (discard) {
+				continue;
+			}
+			separate ();
+			fputs ("{\"name\":", trace_file);
+			write_json_string (trace_file, ev.name);
+			fprintf (trace_file, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":1,\"tid\":%u}",
+			         category_name (ev.category),
+			         (long long) (ev.start - trace_start),
+			         (long long) (ev.end - ev.start),
+			         tt->tid);
+		}
+	}
+}
+
+} // namespace
+
+void
+ProcessTrace::thread_init (std::string const& name)
+{
+	Glib::Threads::Mutex::Lock lm (threads_lock);
+
+	if (this_thread) {
+		/* the writer thread reads the name, announce it again */
+		this_thread->name      = name;
+		this_thread->announced = false;
+		return;
+	}
+
+	this_thread = new ThreadTrace (name, threads.size () + 1);
+	threads.push_back (this_thread);
+}
+
+int64_t
+ProcessTrace::now ()
+{
+	return PBD::get_microseconds ();
+}
+
+void
+ProcessTrace::record (Category c, char const* name, int64_t start, int64_t end)
+{
+	ThreadTrace* tt = this_thread;
+
+	if (!tt) {
+		return;
+	}
+
+	PBD::RingBuffer<TraceEvent>::rw_vector vec;
+	tt->events.get_write_vector (&vec);
+
+	if (vec.len[0] == 0) {
+		_dropped.fetch_add (1);
+		return;
+	}
+
+	TraceEvent& ev (vec.buf[0][0]);
+	ev.start    = start;
+	ev.end      = end;
+	ev.category = c;
+	strncpy (ev.name, name, sizeof (ev.name) - 1);
+	ev.name[sizeof (ev.name) - 1] = '\0';
+
+	tt->events.increment_write_idx (1);
+}
+
+bool
+ProcessTrace::start (std::string const& path)
+{
+	Glib::Threads::Mutex::Lock lm (api_lock);
+
+	if (trace_file) {
+		return false;
+	}
+
+	trace_file = g_fopen (path.c_str (), "w");
+	if (!trace_file) {
+		return false;
+	}
+
+	/* discard stale events from a previous run, and re-announce threads */
+	{
+		Glib::Threads::Mutex::Lock tl (threads_lock);
+		for (auto const& tt : threads) {
+			tt->announced = false;
+		}
+	}
+	flush_events (true);
+
+	fputs ("{\"traceEvents\":[\n", trace_file);
+	first_event = true;
+	trace_start = now ();
+	_dropped.store (0);
+
+	run_writer.store (true);
+	writer = PBD::Thread::create (&ProcessTrace::writer_thread, "ProcessTrace");
+
+	if (!writer) {
+		fclose (trace_file);
+		trace_file = 0;
+		return false;
+	}
+
+	_active.store (true);
+	return true;
+}
+
+void
+ProcessTrace::stop ()
+{
+	Glib::Threads::Mutex::Lock lm (api_lock);
+
+	if (!trace_file) {
+		return;
+	}
+
+	_active.store (false);
+	run_writer.store (false);
+	writer->join ();
+	delete writer;
+	writer = 0;
+
+	/* events of scopes that are still in progress are discarded
+	 * on the next start()
+	 */
+	flush_events (false);
+
+	fputs ("\n],\"displayTimeUnit\":\"ms\"}\n", trace_file);
+	fclose (trace_file);
+	trace_file = 0;
+}
+
+void
+ProcessTrace::writer_thread ()
+{
+	while (run_writer.load ()) {
+		Glib::usleep (50000);
+		flush_events (false);
+	}
+}
@@ -0,0 +1,297 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifdef WAF_BUILD
+#include "libardour-config.h"
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include "pbd/compose.h"
+
+#include "ardour/debug.h"
+#include "ardour/read_ahead.h"
+
+using namespace ARDOUR;
+
+/* reads are split into chunks of at most this size. The data is
+ * not used, all chunks are read into the same sink buffer.
+ */
+static const size_t sink_size = 1048576;
+
+#ifdef HAVE_IO_URING
+
+static const unsigned queue_depth = 64;
+
+struct ReadAhead::Ring {
+	Ring ()
+		: fd (-1)
+		, sq_ptr (MAP_FAILED)
+		, cq_ptr (MAP_FAILED)
+		, sqe_ptr (MAP_FAILED)
+	{}
+
+	~Ring ()
+	{
+		if (sqe_ptr != MAP_FAILED) {
+			munmap (sqe_ptr, sqe_size);
+		}
+		if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr) {
+			munmap (cq_ptr, cq_size);
+		}
+		if (sq_ptr != MAP_FAILED) {
+			munmap (sq_ptr, sq_size);
+		}
+		if (fd >= 0) {
+			::close (fd);
+		}
+	}
+
+	bool init (unsigned n_entries)
+	{
+		struct io_uring_params p;
+		memset (&p, 0, sizeof (p));
+
+		fd = syscall (__NR_io_uring_setup, n_entries, &p);
+		if (fd < 0) {
+			return false;
+		}
+
+		sq_size = p.sq_off.array + p.sq_entries * sizeof (unsigned);
+		cq_size = p.cq_off.cqes + p.cq_entries * sizeof (struct io_uring_cqe);
+
+		bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+		if (p.features & IORING_FEAT_SINGLE_MMAP) {
+			single_mmap = true;
+			sq_size = cq_size = std::max (sq_size, cq_size);
+		}
+#endif
+
+		sq_ptr = mmap (0, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+		if (sq_ptr == MAP_FAILED) {
+			return false;
+		}
+
+		if (single_mmap) {
+			cq_ptr = sq_ptr;
+		} else {
+			cq_ptr = mmap (0, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+			if (cq_ptr == MAP_FAILED) {
+				return false;
+			}
+		}
+
+		sqe_size = p.sq_entries * sizeof (struct io_uring_sqe);
+		sqe_ptr  = mmap (0, sqe_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+		if (sqe_ptr == MAP_FAILED) {
+			return false;
+		}
+
+		char* sq = (char*) sq_ptr;
+		char* cq = (char*) cq_ptr;
+
+		sq_head  = (unsigned*) (sq + p.sq_off.head);
+		sq_tail  = (unsigned*) (sq + p.sq_off.tail);
+		sq_mask  = (unsigned*) (sq + p.sq_off.ring_mask);
+		sq_array = (unsigned*) (sq + p.sq_off.array);
+		cq_head  = (unsigned*) (cq + p.cq_off.head);
+		cq_tail  = (unsigned*) (cq + p.cq_off.tail);
+		cq_mask  = (unsigned*) (cq + p.cq_off.ring_mask);
+		cqes     = (struct io_uring_cqe*) (cq + p.cq_off.cqes);
+		sqes     = (struct io_uring_sqe*) sqe_ptr;
+
+		entries = p.sq_entries;
+		iov.resize (entries);
+		return true;
+	}
+
+	int    fd;
+	void*  sq_ptr;
+	void*  cq_ptr;
+	void*  sqe_ptr;
+	size_t sq_size;
+	size_t cq_size;
+	size_t sqe_size;
+
+	unsigned* sq_head;
+	unsigned* sq_tail;
+	unsigned* sq_mask;
+	unsigned* sq_array;
+	unsigned* cq_head;
+	unsigned* cq_tail;
+	unsigned* cq_mask;
+
+	struct io_uring_sqe* sqes;
+	struct io_uring_cqe* cqes;
+
+	unsigned                 entries;
+	std::vector<struct iovec> iov; /* one per submission slot */
+};
+
+#else
+
+struct ReadAhead::Ring {
+};
+
+#endif
+
+ReadAhead::ReadAhead ()
+	: _ring (0)
+	, _sink (0)
+{
+#ifdef HAVE_IO_URING
+	Ring* r = new Ring;
+	if (r->init (queue_depth)) {
+		_ring = r;
+		_sink = (char*) malloc (sink_size);
+	} else {
+		DEBUG_TRACE (DEBUG::Butler, string_compose ("io_uring is not available: %1\n", strerror (errno)));
+		delete r;
+	}
+#endif
+}
+
+ReadAhead::~ReadAhead ()
+{
+	/* closing the ring waits for any pending reads */
+	delete _ring;
+	free (_sink);
+}
+
+void
+ReadAhead::add (int fd, int64_t offset, size_t len)
+{
+	if (!_ring || fd < 0 || len == 0) {
+		return;
+	}
+	_queue.push_back (Request (fd, offset, len));
+}
+
+size_t
+ReadAhead::run ()
+{
+	if (_queue.empty ()) {
+		return 0;
+	}
+
+#ifdef HAVE_IO_URING
+	/* merge overlapping and adjacent ranges of the same file descriptor */
+	std::sort (_queue.begin (), _queue.end (), [] (Request const& a, Request const& b) {
+		return a.fd < b.fd || (a.fd == b.fd && a.offset < b.offset);
+	});
+
+	std::vector<Request>::iterator m = _queue.begin ();
+	for (std::vector<Request>::iterator i = m + 1; i != _queue.end (); ++i) {
+		if (i->fd == m->fd && i->offset <= m->offset + (int64_t) m->len) {
+			m->len = std::max<int64_t> (m->offset + m->len, i->offset + i->len) - m->offset;
+		} else {
+			*++m = *i;
+		}
+	}
+	_queue.erase (m + 1, _queue.end ());
+
+	Ring& r (*_ring);
+
+	std::vector<unsigned> free_slots;
+	for (unsigned s = 0; s < r.entries; ++s) {
+		free_slots.push_back (s);
+	}
+
+	std::vector<Request>::const_iterator q = _queue.begin ();
+
+	size_t   q_done   = 0; /* bytes of *q that were submitted */
+	unsigned inflight = 0;
+	size_t   rv       = 0;
+
+	while (q != _queue.end () || inflight > 0) {
+		unsigned tail = *r.sq_tail;
+
+		while (q != _queue.end () && !free_slots.empty ()) {
+			size_t const   len  = std::min (sink_size, q->len - q_done);
+			unsigned const slot = free_slots.back ();
+			free_slots.pop_back ();
+
+			r.iov[slot].iov_base = _sink;
+			r.iov[slot].iov_len  = len;
+
+			unsigned const      idx = tail & *r.sq_mask;
+			struct io_uring_sqe* sqe = &r.sqes[idx];
+			memset (sqe, 0, sizeof (*sqe));
+			sqe->opcode    = IORING_OP_READV;
+			sqe->fd        = q->fd;
+			sqe->off       = q->offset + q_done;
+			sqe->addr      = (uintptr_t) &r.iov[slot];
+			sqe->len       = 1;
+			sqe->user_data = slot;
+			r.sq_array[idx] = idx;
+
+			++tail;
+			++inflight;
+
+			q_done += len;
+			if (q_done >= q->len) {
+				++q;
+				q_done = 0;
+			}
+		}
+
+		__atomic_store_n (r.sq_tail, tail, __ATOMIC_RELEASE);
+
+		unsigned const to_submit = tail - __atomic_load_n (r.sq_head, __ATOMIC_ACQUIRE);
+
+		if (syscall (__NR_io_uring_enter, r.fd, to_submit, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR) {
+			/* fall back to synchronous reads from now on */
+			DEBUG_TRACE (DEBUG::Butler, string_compose ("io_uring_enter failed: %1\n", strerror (errno)));
+			delete _ring;
+			_ring = 0;
+			break;
+		}
+
+		unsigned       head  = *r.cq_head;
+		unsigned const ctail = __atomic_load_n (r.cq_tail, __ATOMIC_ACQUIRE);
+
+		while (head != ctail) {
+			struct io_uring_cqe const* cqe = &r.cqes[head & *r.cq_mask];
+			if (cqe->res > 0) {
+				rv += cqe->res;
+			}
+			free_slots.push_back (cqe->user_data);
+			--inflight;
+			++head;
+		}
+
+		__atomic_store_n (r.cq_head, head, __ATOMIC_RELEASE);
+	}
+
+	_queue.clear ();
+	return rv;
+#else
+	_queue.clear ();
+	return 0;
+#endif
+}
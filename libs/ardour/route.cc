@@ -36,6 +36,7 @@
 #include <cmath>
 #include <cassert>
 #include <algorithm>
+#include <set>
 
 #include <glibmm.h>
 #include <boost/algorithm/string.hpp>
@@ -87,6 +88,7 @@
 #include "ardour/port.h"
 #include "ardour/port_insert.h"
 #include "ardour/processor.h"
+#include "ardour/process_trace.h"
 #include "ardour/profile.h"
 #include "ardour/revision.h"
 #include "ardour/route.h"
@@ -139,6 +141,8 @@ Route::Route (Session& sess, string name, PresentationInfo::Flag flag, DataType
 	, _initial_io_setup (false)
 	, _in_sidechain_setup (false)
 	, _monitor_gain (0)
+	, _deferred_processor_state (0)
+	, _deferred_processor_version (0)
 	, _custom_meter_position_noted (false)
 	, _pinmgr_proxy (0)
 	, _patch_selector_dialog (0)
@@ -353,6 +357,8 @@ Route::~Route ()
 	}
 
 	_processors.clear ();
+
+	delete _deferred_processor_state;
 }
 
 string
@@ -583,6 +589,8 @@ Route::process_output_buffers (BufferSet& bufs,
 			}
 		}
 
+		ProcessTrace::Scope trace (ProcessTrace::Processor, *proc);
+
 		if (speed < 0) {
 			proc->run (bufs, start_sample + latency, end_sample + latency, pspeed, nframes, proc != _processors.back());
 		} else {
@@ -2594,6 +2602,24 @@ Route::get_template()
 	return state (true);
 }
 
+/** @return true if @a node is the state of a PluginInsert */
+static bool
+is_plugin_processor (XMLNode const& node)
+{
+	std::string type;
+	if (!node.get_property (X_("type"), type)) {
+		return false;
+	}
+	return type == "ladspa" || type == "Ladspa" ||
+	       type == "lv2" ||
+	       type == "windows-vst" ||
+	       type == "mac-vst" ||
+	       type == "lxvst" ||
+	       type == "luaproc" ||
+	       type == "vst3" ||
+	       type == "audiounit";
+}
+
 XMLNode&
 Route::state (bool save_template) const
 {
@@ -2668,7 +2694,14 @@ Route::state (bool save_template) const
 		node->add_child_nocopy (_pannable->get_state ());
 	}
 
-	{
+	if (_deferred_processor_state) {
+		Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
+		XMLNode* ps = deferred_processor_state (save_template);
+		for (auto const & c : ps->children ()) {
+			node->add_child_copy (*c);
+		}
+		delete ps;
+	} else {
 		Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
 		for (auto const & p : _processors) {
 			if (p == _delayline) {
@@ -2841,7 +2874,31 @@ Route::set_state (const XMLNode& node, int version)
 		}
 	}
 
-	set_processor_state (processor_state, version);
+	bool is_active = true;
+	node.get_property (X_("active"), is_active);
+
+	delete _deferred_processor_state;
+	_deferred_processor_state = 0;
+
+	if (!is_active && _session.loading () && !is_singleton () && Config->get_defer_inactive_route_plugins ()) {
+		/* Keep the state of plugins, and only instantiate them
+		 * when the route is activated. Everything else is restored
+		 * now, so that the route is complete for the UI.
+		 */
+		XMLNode builtin_state (X_("processor_state"));
+		for (auto const & c : processor_state.children ()) {
+			if (!is_plugin_processor (*c)) {
+				builtin_state.add_child_copy (*c);
+			}
+		}
+		if (builtin_state.children ().size () != processor_state.children ().size ()) {
+			_deferred_processor_state  = new XMLNode (processor_state);
+			_deferred_processor_version = version;
+		}
+		set_processor_state (builtin_state, version);
+	} else {
+		set_processor_state (processor_state, version);
+	}
 
 	// this looks up the internal instrument in processors
 	reset_instrument_info();
@@ -2865,7 +2922,6 @@ Route::set_state (const XMLNode& node, int version)
 		_phase_control->set_phase_invert (boost::dynamic_bitset<> (phase_invert_str));
 	}
 
-	bool is_active;
 	if (node.get_property (X_("active"), is_active)) {
 		set_active (is_active, this);
 	}
@@ -3306,6 +3362,100 @@ Route::set_processor_state (const XMLNode& node, int version)
 	set_processor_positions ();
 }
 
+/** Merge the state of instantiated processors with the plugin state
+ * that was set aside by ::set_state. Processors that were added since
+ * are written at their position in the processor list. Must be called
+ * with the processor lock held.
+ */
+XMLNode*
+Route::deferred_processor_state (bool save_template) const
+{
+	XMLNode* rv = new XMLNode (X_("processor_state"));
+	std::set<std::shared_ptr<Processor>> used;
+
+	auto add_processor = [&] (std::shared_ptr<Processor> const& p) {
+		if (p == _delayline || !used.insert (p).second) {
+			return;
+		}
+		if (save_template) {
+			/* see ::state, listen sends are added if necessary */
+			std::shared_ptr<InternalSend> is = std::dynamic_pointer_cast<InternalSend> (p);
+			if (is && is->role() == Delivery::Listen) {
+				return;
+			}
+		}
+		rv->add_child_nocopy (p->get_state ());
+	};
+
+	/* invisible processors are only added to the list once
+	 * processors are configured.
+	 */
+	ProcessorList candidates (_processors);
+	candidates.push_back (_main_outs);
+	candidates.push_back (_intreturn);
+	candidates.push_back (_monitor_control);
+
+	ProcessorList::const_iterator next = _processors.begin ();
+
+	for (auto const & c : _deferred_processor_state->children ()) {
+		if (is_plugin_processor (*c)) {
+			rv->add_child_copy (*c);
+			continue;
+		}
+		XMLProperty const* id_prop = c->property (X_("id"));
+		if (!id_prop) {
+			continue;
+		}
+		std::shared_ptr<Processor> proc;
+		for (auto const & p : candidates) {
+			if (p && p->id () == id_prop->value ()) {
+				proc = p;
+				break;
+			}
+		}
+		if (!proc) {
+			continue;
+		}
+		/* processors that were added after the session was loaded,
+		 * and which precede this one.
+		 */
+		ProcessorList::const_iterator i = std::find (next, _processors.end (), proc);
+		if (i != _processors.end ()) {
+			for (; next != i; ++next) {
+				add_processor (*next);
+			}
+			++next;
+		}
+		add_processor (proc);
+	}
+
+	for (; next != _processors.end (); ++next) {
+		add_processor (*next);
+	}
+
+	return rv;
+}
+
+void
+Route::load_deferred_processors ()
+{
+	if (!_deferred_processor_state) {
+		return;
+	}
+
+	XMLNode* ps;
+	{
+		Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
+		ps = deferred_processor_state (false);
+	}
+
+	delete _deferred_processor_state;
+	_deferred_processor_state = 0;
+
+	set_processor_state (*ps, _deferred_processor_version);
+	delete ps;
+}
+
 bool
 Route::set_processor_state (XMLNode const& node, int version, XMLProperty const* prop, ProcessorList& new_order, bool& must_configure)
 {
@@ -3331,14 +3481,7 @@ Route::set_processor_state (XMLNode const& node, int version, XMLProperty const*
 
 			processor.reset (new InternalSend (_session, _pannable, _mute_master, std::dynamic_pointer_cast<ARDOUR::Route>(shared_from_this()), std::shared_ptr<Route>(), Delivery::Aux, true));
 
-		} else if (prop->value() == "ladspa" || prop->value() == "Ladspa" ||
-		           prop->value() == "lv2" ||
-		           prop->value() == "windows-vst" ||
-		           prop->value() == "mac-vst" ||
-		           prop->value() == "lxvst" ||
-		           prop->value() == "luaproc" ||
-		           prop->value() == "vst3" ||
-		           prop->value() == "audiounit") {
+		} else if (is_plugin_processor (node)) {
 
 			if (_session.get_disable_all_loaded_plugins ()) {
 				processor.reset (new UnknownProcessor (_session, node, this));
@@ -4862,6 +5005,9 @@ Route::set_active (bool yn, void* src)
 	}
 
 	if (_active != yn) {
+		if (yn) {
+			load_deferred_processors ();
+		}
 		_active = yn;
 		_input->set_active (yn);
 		_output->set_active (yn);
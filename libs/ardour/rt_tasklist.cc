@@ -45,3 +45,36 @@ RTTaskList::process ()
 	}
 	_tasks.clear ();
 }
+
+RTSubTaskList::RTSubTaskList (Graph* g)
+	: _graph (g)
+	, _next (0)
+	, _helpers_done ("subtasks_done", 0)
+{
+}
+
+void
+RTSubTaskList::push_back (std::function<void ()> fn)
+{
+	_tasks.push_back (fn);
+}
+
+void
+RTSubTaskList::process ()
+{
+	if (_tasks.size () > 1) {
+		_graph->process_subtasks (*this);
+	} else if (!_tasks.empty ()) {
+		_tasks.front () ();
+	}
+}
+
+void
+RTSubTaskList::run_tasks ()
+{
+	size_t const n = _tasks.size ();
+	size_t       i;
+	while ((i = _next.fetch_add (1)) < n) {
+		_tasks[i] ();
+	}
+}
@@ -86,6 +86,7 @@
 #include "ardour/io_tasklist.h"
 #include "ardour/luabindings.h"
 #include "ardour/lv2_plugin.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/midiport_manager.h"
 #include "ardour/scene_changer.h"
 #include "ardour/midi_patch_manager.h"
@@ -121,6 +122,7 @@
 #include "ardour/session_route.h"
 #include "ardour/smf_source.h"
 #include "ardour/solo_isolate_control.h"
+#include "ardour/source_cache.h"
 #include "ardour/source_factory.h"
 #include "ardour/speakers.h"
 #include "ardour/surround_return.h"
@@ -349,6 +351,7 @@ Session::Session (AudioEngine &eng,
 	, _midi_ports (0)
 	, _mmc (0)
 	, _vca_manager (new VCAManager (*this))
+	, _meter_snapshot (new MeterSnapshot)
 	, _selection (new CoreSelection (*this))
 	, _global_locate_pending (false)
 	, _had_destructive_tracks (false)
@@ -682,6 +685,10 @@ Session::destroy ()
 	/* stop auto dis/connecting */
 	auto_connect_thread_terminate ();
 
+	/* the cache holds data of this session's sources */
+	SourceCache::instance ().stop_preload ();
+	SourceCache::instance ().clear ();
+
 	/* shutdown control surface protocols while we still have ports
 	 * and the engine to move data to any devices.
 	 */
@@ -738,6 +745,8 @@ Session::destroy ()
 
 	/* drop GraphNode references */
 	_graph_chain.reset ();
+	_export_graph_chain.reset ();
+	_export_routes.reset ();
 	_current_route_graph = GraphEdges ();
 
 	_io_graph_chain[0].reset ();
@@ -29,9 +29,13 @@
 
 #include "ardour/audioengine.h"
 #include "ardour/butler.h"
+#include "ardour/debug.h"
 #include "ardour/export_handler.h"
 #include "ardour/export_status.h"
+#include "ardour/graph.h"
+#include "ardour/graph_edges.h"
 #include "ardour/process_thread.h"
+#include "ardour/rt_safe_delete.h"
 #include "ardour/session.h"
 #include "ardour/track.h"
 #include "ardour/transport_fsm.h"
@@ -111,6 +115,48 @@ Session::pre_export ()
 	return 0;
 }
 
+/** Limit processing during export to the given routes and everything
+ * that feeds them, directly or via sends and side-chains.
+ *
+ * @param sinks routes whose output is exported, or null to process all routes
+ */
+void
+Session::set_export_routes (std::shared_ptr<RouteList const> sinks)
+{
+	std::shared_ptr<RouteList>  rl;
+	std::shared_ptr<GraphChain> chain;
+
+	if (sinks) {
+		std::set<GraphVertex> nodes;
+		for (auto const& r : *sinks) {
+			nodes.insert (r);
+			std::set<GraphVertex> const up = _current_route_graph.to (r);
+			nodes.insert (up.begin (), up.end ());
+		}
+
+		GraphNodeList gnl (nodes.begin (), nodes.end ());
+		GraphEdges    edges;
+
+		if (topological_sort (gnl, edges)) {
+			rl.reset (new RouteList);
+			for (auto const& n : gnl) {
+				std::shared_ptr<Route> r = std::dynamic_pointer_cast<Route> (n);
+				if (r && !r->is_auditioner ()) {
+					rl->push_back (r);
+				}
+			}
+			if (_process_graph->n_threads () > 1) {
+				chain = std::shared_ptr<GraphChain> (new GraphChain (gnl, edges), std::bind (&rt_safe_delete<GraphChain>, this, _1));
+			}
+			DEBUG_TRACE (DEBUG::Graph, string_compose ("Export processes %1 of %2 routes\n", rl->size (), routes.reader ()->size ()));
+		}
+	}
+
+	Glib::Threads::Mutex::Lock lm (AudioEngine::instance()->process_lock ());
+	_export_routes      = rl;
+	_export_graph_chain = chain;
+}
+
 /** Called for each range that is being exported */
 int
 Session::start_audio_export (samplepos_t position, bool realtime, bool region_export)
@@ -446,6 +492,8 @@ Session::finalize_audio_export (TransportRequestSource trs)
 		stop_audio_export ();
 	}
 
+	set_export_routes (std::shared_ptr<RouteList const> ());
+
 	/* Clean up */
 
 	if (_realtime_export) {
@@ -43,8 +43,10 @@
 #include "ardour/disk_reader.h"
 #include "ardour/graph.h"
 #include "ardour/io_plug.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/port.h"
 #include "ardour/process_thread.h"
+#include "ardour/process_trace.h"
 #include "ardour/rt_tasklist.h"
 #include "ardour/scene_changer.h"
 #include "ardour/session.h"
@@ -84,6 +86,7 @@ void
 Session::process (pframes_t nframes)
 {
 	TimerRAII tr (dsp_stats[OverallProcess]);
+	ProcessTrace::Scope trace (ProcessTrace::Cycle, "Session::process");
 
 	if (processing_blocked()) {
 		_silent = true;
@@ -172,6 +175,9 @@ Session::process (pframes_t nframes)
 		TFSM_EVENT (TransportFSM::DeclickDone);
 	}
 
+	/* make this cycle's meter levels visible to the GUI and surfaces */
+	_meter_snapshot->publish ();
+
 	_engine.main_thread()->drop_buffers ();
 
 	/* deliver MIDI clock. Note that we need to use the transport sample
@@ -265,6 +271,13 @@ Session::process_routes (pframes_t nframes, bool& need_butler)
 	_global_locate_pending = locate_pending();
 
 	std::shared_ptr<GraphChain> graph_chain = _graph_chain;
+
+	/* only process routes that contribute to the export */
+	if (_exporting && _export_routes) {
+		r           = _export_routes;
+		graph_chain = _export_graph_chain;
+	}
+
 	if (graph_chain) {
 		DEBUG_TRACE(DEBUG::ProcessThreads,"calling graph/process-routes\n");
 		if (_process_graph->process_routes (graph_chain, nframes, start_sample, end_sample, need_butler) < 0) {
@@ -117,6 +117,7 @@
 #include "ardour/mixer_scene.h"
 #include "ardour/playlist_factory.h"
 #include "ardour/playlist_source.h"
+#include "ardour/plugin.h"
 #include "ardour/port.h"
 #include "ardour/processor.h"
 #include "ardour/profile.h"
@@ -135,6 +136,7 @@
 #include "ardour/silentfilesource.h"
 #include "ardour/smf_source.h"
 #include "ardour/sndfilesource.h"
+#include "ardour/source_cache.h"
 #include "ardour/source_factory.h"
 #include "ardour/speakers.h"
 #include "ardour/template_utils.h"
@@ -228,6 +230,11 @@ Session::post_engine_init ()
 
 	BootMessage (_("Using configuration"));
 
+	/* undo transactions that exceed the history memory budget are moved here */
+	_history.set_spill_file (Glib::build_filename (_session_dir->root_path(), legalize_for_path (_name) + history_suffix + X_(".spill")));
+	_history.set_reload_handler (std::bind (&Session::undo_transaction_from_state, this, std::placeholders::_1));
+	set_history_memory_budget (Config->get_history_memory_budget());
+
 	_midi_ports = new MidiPortManager;
 
 	MIDISceneChanger* msc;
@@ -427,6 +434,8 @@ Session::session_loaded ()
 		save_state ("");
 	}
 
+	preload_source_cache ();
+
 	/* Now, finally, we can fill the playback buffers */
 
 	BootMessage (_("Filling playback buffers"));
@@ -434,6 +443,51 @@ Session::session_loaded ()
 	reset_xrun_count ();
 }
 
+/** Load the audio used by all playlists into memory, in the background,
+ * starting with the regions closest to the start of the session.
+ */
+void
+Session::preload_source_cache ()
+{
+	SourceCache& cache (SourceCache::instance ());
+
+	cache.stop_preload ();
+	cache.set_budget ((size_t) Config->get_playback_cache_megabytes () * 1048576);
+
+	if (!cache.enabled ()) {
+		return;
+	}
+
+	std::vector<std::shared_ptr<AudioRegion> > regions;
+
+	for (auto const& pl : _playlists->get_used ()) {
+		if (pl->data_type () != DataType::AUDIO) {
+			continue;
+		}
+		std::shared_ptr<RegionList> rl = pl->region_list ();
+		for (auto const& r : *rl) {
+			std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (r);
+			if (ar) {
+				regions.push_back (ar);
+			}
+		}
+	}
+
+	std::stable_sort (regions.begin (), regions.end (), [] (std::shared_ptr<AudioRegion> const& a, std::shared_ptr<AudioRegion> const& b) {
+		return a->position_sample () < b->position_sample ();
+	});
+
+	std::vector<SourceCache::Range> ranges;
+
+	for (auto const& ar : regions) {
+		for (uint32_t n = 0; n < ar->n_channels (); ++n) {
+			ranges.push_back (SourceCache::Range (ar->audio_source (n), ar->start_sample (), ar->length_samples ()));
+		}
+	}
+
+	cache.preload (ranges);
+}
+
 string
 Session::raid_path () const
 {
@@ -1656,7 +1710,7 @@ Session::maybe_copy_midifile (snapshot_t snapshot_type, std::shared_ptr<Source>
 	{
 		Source::WriterLock lm (ms->mutex());
 
-		if (!ms->model()) {
+		if (!ms->has_model()) {
 			ms->load_model (lm);
 		}
 	}
@@ -2143,30 +2197,37 @@ Session::load_routes (const XMLNode& node, int version)
 
 	set_dirty();
 
-	for (niter = nlist.begin(); niter != nlist.end(); ++niter) {
+	{
+		/* plugins restore their state in the background while
+		 * routes are created, wait for that before adding the routes.
+		 */
+		Plugin::ConcurrentRestore cr;
 
-		std::shared_ptr<Route> route;
+		for (niter = nlist.begin(); niter != nlist.end(); ++niter) {
 
-		try {
-			if (version < 3000) {
-				route = XMLRouteFactory_2X (**niter, version);
-			} else if (version < 5000) {
-				route = XMLRouteFactory_3X (**niter, version);
-			} else {
-				route = XMLRouteFactory (**niter, version);
+			std::shared_ptr<Route> route;
+
+			try {
+				if (version < 3000) {
+					route = XMLRouteFactory_2X (**niter, version);
+				} else if (version < 5000) {
+					route = XMLRouteFactory_3X (**niter, version);
+				} else {
+					route = XMLRouteFactory (**niter, version);
+				}
+			} catch (...) {
+				goto errout;
 			}
-		} catch (...) {
-			goto errout;
-		}
 
-		if (route == 0) {
-			error << _("Session: cannot create track/bus from XML description.") << endmsg;
-			goto errout;
-		}
+			if (route == 0) {
+				error << _("Session: cannot create track/bus from XML description.") << endmsg;
+				goto errout;
+			}
 
-		BootMessage (string_compose (_("Loaded track/bus %1"), route->name()));
+			BootMessage (string_compose (_("Loaded track/bus %1"), route->name()));
 
-		new_routes.push_back (route);
+			new_routes.push_back (route);
+		}
 	}
 
 	BootMessage (_("Tracks/busses loaded;  Adding to Session"));
@@ -4058,8 +4119,6 @@ Session::instant_xml (const string& node_name)
 int
 Session::save_history (string snapshot_name)
 {
-	XMLTree tree;
-
 	if (!_writable) {
 	        return 0;
 	}
@@ -4081,13 +4140,12 @@ Session::save_history (string snapshot_name)
 	}
 
 	if (!Config->get_save_history() || Config->get_saved_history_depth() < 0 ||
-	    (_history.undo_depth() == 0 && _history.redo_depth() == 0)) {
+	    (_history.undo_depth() == 0 && _history.redo_depth() == 0 && _history.spilled_depth() == 0)) {
 		return 0;
 	}
 
-	tree.set_root (&_history.get_state (Config->get_saved_history_depth()));
-
-	if (!tree.write (xml_path))
+	/* this also includes transactions that were moved to the spill file */
+	if (!_history.write_state (xml_path, Config->get_saved_history_depth()))
 	{
 		error << string_compose (_("history could not be saved to %1"), xml_path) << endmsg;
 
@@ -4106,6 +4164,91 @@ Session::save_history (string snapshot_name)
 	return 0;
 }
 
+/** Re-create an undo transaction from its state, used when loading
+ *  the history and for transactions that were spilled to disk.
+ */
+UndoTransaction*
+Session::undo_transaction_from_state (XMLNode const& node)
+{
+	std::string name;
+	int64_t tv_sec;
+	int64_t tv_usec;
+
+	if (!node.get_property ("name", name) || !node.get_property ("tv-sec", tv_sec) ||
+	    !node.get_property ("tv-usec", tv_usec)) {
+		return 0;
+	}
+
+	UndoTransaction* ut = new UndoTransaction ();
+	ut->set_name (name);
+
+	struct timeval tv;
+	tv.tv_sec = tv_sec;
+	tv.tv_usec = tv_usec;
+	ut->set_timestamp(tv);
+
+	for (XMLNodeConstIterator child_it  = node.children().begin();
+	     child_it != node.children().end(); child_it++)
+	{
+		XMLNode *n = *child_it;
+		Command *c;
+
+		if (n->name() == "MementoCommand" ||
+		    n->name() == "MementoUndoCommand" ||
+		    n->name() == "MementoRedoCommand") {
+
+			if ((c = memento_command_factory(n))) {
+				ut->add_command(c);
+			}
+
+		} else if (n->name() == "TempoCommand") {
+
+			ut->add_command (new TempoCommand (*n));
+
+		} else if (n->name() == "NoteDiffCommand") {
+			PBD::ID id (n->property("midi-source")->value());
+			std::shared_ptr<MidiSource> midi_source =
+				std::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
+			if (midi_source) {
+				ut->add_command (new MidiModel::NoteDiffCommand(midi_source->model(), *n));
+			} else {
+				error << _("Failed to downcast MidiSource for NoteDiffCommand") << endmsg;
+			}
+
+		} else if (n->name() == "SysExDiffCommand") {
+
+			PBD::ID id (n->property("midi-source")->value());
+			std::shared_ptr<MidiSource> midi_source =
+				std::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
+			if (midi_source) {
+				ut->add_command (new MidiModel::SysExDiffCommand (midi_source->model(), *n));
+			} else {
+				error << _("Failed to downcast MidiSource for SysExDiffCommand") << endmsg;
+			}
+
+		} else if (n->name() == "PatchChangeDiffCommand") {
+
+			PBD::ID id (n->property("midi-source")->value());
+			std::shared_ptr<MidiSource> midi_source =
+				std::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
+			if (midi_source) {
+				ut->add_command (new MidiModel::PatchChangeDiffCommand (midi_source->model(), *n));
+			} else {
+				error << _("Failed to downcast MidiSource for PatchChangeDiffCommand") << endmsg;
+			}
+
+		} else if (n->name() == "StatefulDiffCommand") {
+			if ((c = stateful_diff_command_factory (n))) {
+				ut->add_command (c);
+			}
+		} else {
+			error << string_compose(_("Couldn't figure out how to make a Command out of a %1 XMLNode."), n->name()) << endmsg;
+		}
+	}
+
+	return ut;
+}
+
 int
 Session::restore_history (string snapshot_name)
 {
@@ -4138,85 +4281,10 @@ Session::restore_history (string snapshot_name)
 	try {
 		for (XMLNodeConstIterator it  = tree.root()->children().begin(); it != tree.root()->children().end(); ++it) {
 
-			XMLNode *t = *it;
-
-			std::string name;
-			int64_t tv_sec;
-			int64_t tv_usec;
-
-			if (!t->get_property ("name", name) || !t->get_property ("tv-sec", tv_sec) ||
-			    !t->get_property ("tv-usec", tv_usec)) {
-				continue;
+			UndoTransaction* ut = undo_transaction_from_state (**it);
+			if (ut) {
+				_history.add (ut);
 			}
-
-			UndoTransaction* ut = new UndoTransaction ();
-			ut->set_name (name);
-
-			struct timeval tv;
-			tv.tv_sec = tv_sec;
-			tv.tv_usec = tv_usec;
-			ut->set_timestamp(tv);
-
-			for (XMLNodeConstIterator child_it  = t->children().begin();
-			     child_it != t->children().end(); child_it++)
-			{
-				XMLNode *n = *child_it;
-				Command *c;
-
-				if (n->name() == "MementoCommand" ||
-				    n->name() == "MementoUndoCommand" ||
-				    n->name() == "MementoRedoCommand") {
-
-					if ((c = memento_command_factory(n))) {
-						ut->add_command(c);
-					}
-
-				} else if (n->name() == "TempoCommand") {
-
-					ut->add_command (new TempoCommand (*n));
-
-				} else if (n->name() == "NoteDiffCommand") {
-					PBD::ID id (n->property("midi-source")->value());
-					std::shared_ptr<MidiSource> midi_source =
-						std::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
-					if (midi_source) {
-						ut->add_command (new MidiModel::NoteDiffCommand(midi_source->model(), *n));
-					} else {
-						error << _("Failed to downcast MidiSource for NoteDiffCommand") << endmsg;
-					}
-
-				} else if (n->name() == "SysExDiffCommand") {
-
-					PBD::ID id (n->property("midi-source")->value());
-					std::shared_ptr<MidiSource> midi_source =
-						std::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
-					if (midi_source) {
-						ut->add_command (new MidiModel::SysExDiffCommand (midi_source->model(), *n));
-					} else {
-						error << _("Failed to downcast MidiSource for SysExDiffCommand") << endmsg;
-					}
-
-				} else if (n->name() == "PatchChangeDiffCommand") {
-
-					PBD::ID id (n->property("midi-source")->value());
-					std::shared_ptr<MidiSource> midi_source =
-						std::dynamic_pointer_cast<MidiSource, Source>(source_by_id(id));
-					if (midi_source) {
-						ut->add_command (new MidiModel::PatchChangeDiffCommand (midi_source->model(), *n));
-					} else {
-						error << _("Failed to downcast MidiSource for PatchChangeDiffCommand") << endmsg;
-					}
-
-				} else if (n->name() == "StatefulDiffCommand") {
-					if ((c = stateful_diff_command_factory (n))) {
-						ut->add_command (c);
-					}
-				} else {
-					error << string_compose(_("Couldn't figure out how to make a Command out of a %1 XMLNode."), n->name()) << endmsg;
-				}
-			}
-
-			_history.add (ut);
 		}
 
 	} catch (std::exception const & e) {
@@ -4405,6 +4473,8 @@ Session::config_changed (std::string p, bool ours)
 		setup_fpu ();
 	} else if (p == "history-depth") {
 		set_history_depth (Config->get_history_depth());
+	} else if (p == "history-memory-budget") {
+		set_history_memory_budget (Config->get_history_memory_budget());
 	} else if (p == "remote-model") {
 		/* XXX DO SOMETHING HERE TO TELL THE GUI THAT WE NEED
 		   TO SET REMOTE ID'S
@@ -4508,6 +4578,10 @@ Session::config_changed (std::string p, bool ours)
 		if (follow && !transport_state_rolling() && !loading()) {
 			request_locate (transport_sample(), true);
 		}
+	} else if (p == "playback-cache-megabytes") {
+		if (!loading ()) {
+			preload_source_cache ();
+		}
 	} else if (p == "default-time-domain") {
 		Temporal::TimeDomain td = config.get_default_time_domain ();
 		set_time_domain (td);
@@ -4523,6 +4597,12 @@ Session::set_history_depth (uint32_t d)
 	_history.set_depth (d);
 }
 
+void
+Session::set_history_memory_budget (uint32_t mb)
+{
+	_history.set_memory_budget ((size_t) mb * 1048576);
+}
+
 /** Connect things to the MMC object */
 void
 Session::setup_midi_machine_control ()
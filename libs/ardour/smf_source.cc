@@ -51,6 +51,7 @@
 #include "ardour/midi_ring_buffer.h"
 #include "ardour/midi_state_tracker.h"
 #include "ardour/parameter_types.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 #include "ardour/smf_source.h"
 
@@ -187,7 +188,15 @@ SMFSource::SMFSource (Session& s, const XMLNode& node, bool must_exist)
 	}
 
 	/* no lock required since we do not actually exist yet */
-	load_model_unlocked (true);
+	if (model_can_be_deferred ()) {
+		/* playback reads straight from the file, the model is only
+		 * loaded when it is first asked for (e.g. for editing)
+		 */
+		scan_unlocked ();
+		_model_deferred = true;
+	} else {
+		load_model_unlocked (true);
+	}
 }
 
 SMFSource::~SMFSource ()
@@ -236,6 +245,8 @@ SMFSource::render (const ReaderLock& lock, Evoral::EventSink<Temporal::Beats>& d
 
 	/* start of read in SMF ticks (which may differ from our own musical ticks */
 
+	Glib::Threads::Mutex::Lock lm (_stream_lock);
+
 	Evoral::SMF::seek_to_start();
 
 	while (true) {
@@ -248,12 +259,12 @@ SMFSource::render (const ReaderLock& lock, Evoral::EventSink<Temporal::Beats>& d
 			break;
 		}
 
+		time += Temporal::Beats::ticks_at_rate (ev_delta_t, ppqn()); // accumulate delta time
+
 		if (ret == 0) { // meta-event (skipped, just accumulate time)
 			continue;
 		}
 
-		time += Temporal::Beats::ticks_at_rate (ev_delta_t, ppqn()); // accumulate delta time
-
 		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF render delta %1, time %2, buf[0] %3\n",
 								  ev_delta_t, time, ev_buffer[0]));
 
@@ -269,8 +280,7 @@ SMFSource::render (const ReaderLock& lock, Evoral::EventSink<Temporal::Beats>& d
 		ev_size = scratch_size; // ensure read_event only allocates if necessary
 	}
 
-	_smf_last_read_end = time;
-	_smf_last_read_time = time;
+	free (ev_buffer);
 }
 
 timecnt_t
@@ -283,8 +293,7 @@ SMFSource::read_unlocked (const ReaderLock&               lock,
                           MidiNoteTracker*                tracker,
                           MidiChannelFilter*              filter) const
 {
-	int      ret  = 0;
-	timepos_t time; // in SMF ticks, 1 tick per _ppqn
+	int ret = 0;
 
 	if (writable() && !_open) {
 		/* nothing to read since nothing has ben written */
@@ -298,72 +307,58 @@ SMFSource::read_unlocked (const ReaderLock&               lock,
 	uint32_t ev_size    = 0;
 	uint8_t* ev_buffer  = 0;
 
-	size_t scratch_size = 0; // keep track of scratch to minimize reallocs
-
-	/* start of read in SMF ticks (which may differ from our own musical ticks */
-	const uint64_t start_ticks = llrint (start.beats().to_ticks() * (Temporal::Beats::PPQN / ppqn()));
+	uint32_t scratch_size = 0; // keep track of scratch to minimize reallocs
 
-	DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: start in ticks %1\n", start_ticks));
+	uint64_t time = 0; /* in SMF ticks, 1 tick per _ppqn */
 
-	if (_smf_last_read_end.is_zero() || start != _smf_last_read_end) {
-		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: seek to %1\n", start));
-		Evoral::SMF::seek_to_start();
-		while (time < start_ticks) {
-			Evoral::event_id_t ignored;
+	/* read range, relative to the start of the source */
+	const Temporal::Beats source_start_beats = source_start.beats();
+	const Temporal::Beats start_beats        = start.beats();
+	const Temporal::Beats end_beats          = start_beats + duration.beats();
 
-			ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
-			if (ret == -1) { // EOF
-				_smf_last_read_end = start + duration;
-				return timecnt_t();
-			}
-			time += timepos_t::from_ticks (ev_delta_t); // accumulate delta time
-		}
-	} else {
-		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: set time to %1\n", _smf_last_read_time));
-		time = _smf_last_read_time;
-	}
+	/* concurrent readers share the source lock, but not the read position of the file */
+	Glib::Threads::Mutex::Lock lm (_stream_lock);
 
-	_smf_last_read_end = start + duration;
+	Evoral::SMF::seek_to_start();
 
 	while (true) {
 		Evoral::event_id_t ignored; /* XXX don't ignore note id's ??*/
 
-		ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
+		ret = read_event (&ev_delta_t, &ev_size, &ev_buffer, &ignored);
 		if (ret == -1) { // EOF
 			break;
 		}
 
-		time += timepos_t::from_ticks (ev_delta_t); // accumulate delta time
-		_smf_last_read_time = time;
+		time += ev_delta_t; // accumulate delta time
 
 		if (ret == 0) { // meta-event (skipped, just accumulate time)
 			continue;
 		}
 
-		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked delta %1, time %2, buf[0] %3\n",
-								  ev_delta_t, time, ev_buffer[0]));
+		const Temporal::Beats ev_beats = Temporal::Beats::ticks_at_rate (time, ppqn());
 
-		assert(time >= start_ticks);
+		if (ev_beats >= end_beats) {
+			break;
+		}
 
-		/* Note that we add on the source start time (in session samples) here so that ev_sample_time
-		   is in session samples.
-		*/
-		const samplepos_t ev_sample_time = (time + timepos_t (source_start.beats())).samples();
-		timepos_t est (ev_sample_time);
+		if (ev_beats >= start_beats) {
 
-		if (loop_range) {
-			est = loop_range->squish (est);
-		}
+			DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked delta %1, time %2, buf[0] %3\n",
+			                                                  ev_delta_t, ev_beats, ev_buffer[0]));
+
+			/* Note that we add on the source start time here so that the event time is in session samples */
+			const timepos_t seb (source_start_beats + ev_beats);
+			const samplepos_t time_samples = loop_range ? loop_range->squish (seb).samples() : seb.samples();
 
-		if (est < start + duration) {
-			if (!filter || !filter->filter(ev_buffer, ev_size)) {
-				destination.write (est.samples(), Evoral::MIDI_EVENT, ev_size, ev_buffer);
+			const uint8_t status           = ev_buffer[0];
+			const bool    is_channel_event = (0x80 <= (status & 0xF0)) && (status <= 0xE0);
+
+			if (!filter || !is_channel_event || !filter->filter (ev_buffer, ev_size)) {
+				destination.write (time_samples, Evoral::MIDI_EVENT, ev_size, ev_buffer);
 				if (tracker) {
-					tracker->track(ev_buffer);
+					tracker->track (ev_buffer);
 				}
 			}
-		} else {
-			break;
 		}
 
 		if (ev_size > scratch_size) {
@@ -372,6 +367,8 @@ SMFSource::read_unlocked (const ReaderLock&               lock,
 		ev_size = scratch_size; // ensure read_event only allocates if necessary
 	}
 
+	free (ev_buffer);
+
 	return duration;
 }
 
@@ -781,22 +778,7 @@ SMFSource::load_model_unlocked (bool force_reload)
 				continue;
 			}
 
-			/* aggregate information about channels and pgm-changes */
-			uint8_t type = buf[0] & 0xf0;
-			uint8_t chan = buf[0] & 0x0f;
-			if (type >= 0x80 && type <= 0xE0) {
-				_used_channels.set(chan);
-				switch (type) {
-					case MIDI_CMD_NOTE_ON:
-						++_n_note_on_events;
-						break;
-					case MIDI_CMD_PGM_CHANGE:
-						_has_pgm_change = true;
-						break;
-					default:
-						break;
-				}
-			}
+			update_channel_info (buf);
 
 			if (ret > 0) {
 				/* not a meta-event */
@@ -847,6 +829,108 @@ SMFSource::load_model_unlocked (bool force_reload)
 		delete it->first;
 	}
 
+	set_length_from_file ();
+
+	_model->set_duration (_length.beats());
+
+	// cerr << "----SMF-SRC-----\n";
+        // _playback_buf->dump (cerr);
+        // cerr << "----------------\n";
+
+	_model->end_write (Evoral::Sequence<Temporal::Beats>::ResolveStuckNotes, _length.beats());
+	_model->set_edited (false);
+	_model_deferred = false;
+
+	free (buf);
+}
+
+/** @return true if this source can be played back without loading its model */
+bool
+SMFSource::model_can_be_deferred () const
+{
+	if (!Config->get_defer_midi_model_load ()) {
+		return false;
+	}
+
+	/* read_unlocked only reads the first track */
+	if ((_flags & Source::Empty) || !_open || num_tracks () != 1) {
+		return false;
+	}
+
+	/* read_unlocked cannot skip parameters whose automation is not played back */
+	for (AutomationStateMap::const_iterator i = _automation_state.begin(); i != _automation_state.end(); ++i) {
+		if (i->second != Play) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/** Set up channel information and the length of the source from the file,
+ * without loading the model.
+ */
+void
+SMFSource::scan_unlocked ()
+{
+	uint32_t scratch_size = 0; // keep track of scratch and minimize reallocs
+
+	uint32_t delta_t = 0;
+	uint32_t size    = 0;
+	uint8_t* buf     = NULL;
+	int ret;
+	Evoral::event_id_t ignored;
+
+	_num_channels     = 0;
+	_n_note_on_events = 0;
+	_has_pgm_change   = false;
+	_used_channels.reset ();
+
+	for (unsigned i = 1; i <= num_tracks(); ++i) {
+		if (seek_to_track(i)) {
+			continue;
+		}
+
+		while ((ret = read_event (&delta_t, &size, &buf, &ignored)) >= 0) {
+			if (ret > 0) {
+				update_channel_info (buf);
+				scratch_size = std::max(size, scratch_size);
+				size = scratch_size;
+			}
+		}
+	}
+
+	_num_channels = _used_channels.size();
+
+	set_length_from_file ();
+
+	free (buf);
+}
+
+/** aggregate information about channels and pgm-changes */
+void
+SMFSource::update_channel_info (uint8_t const* buf)
+{
+	uint8_t type = buf[0] & 0xf0;
+	uint8_t chan = buf[0] & 0x0f;
+	if (type >= 0x80 && type <= 0xE0) {
+		_used_channels.set(chan);
+		switch (type) {
+			case MIDI_CMD_NOTE_ON:
+				++_n_note_on_events;
+				break;
+			case MIDI_CMD_PGM_CHANGE:
+				_has_pgm_change = true;
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+void
+SMFSource::set_length_from_file ()
+{
 	/* Length ought to be based on data in the file (TrkEnd meta-event, not
 	   the final true event.
 	*/
@@ -867,17 +951,6 @@ SMFSource::load_model_unlocked (bool force_reload)
 		_length = tmap->quarters_at (Temporal::BBT_Argument (bbt));
 		std::cerr << " rounded up to bar " << bbt << " aka " << _length.beats() << std::endl;
 	}
-
-	_model->set_duration (_length.beats());
-
-	// cerr << "----SMF-SRC-----\n";
-        // _playback_buf->dump (cerr);
-        // cerr << "----------------\n";
-
-	_model->end_write (Evoral::Sequence<Temporal::Beats>::ResolveStuckNotes, _length.beats());
-	_model->set_edited (false);
-
-	free (buf);
 }
 
 Evoral::SMF::UsedChannels
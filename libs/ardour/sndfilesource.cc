@@ -26,6 +26,7 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <cerrno>
 #include <climits>
@@ -44,10 +45,16 @@
 #include <utime.h>
 #endif
 
+#ifndef PLATFORM_WINDOWS
+#include <unistd.h>
+#endif
+
 #include <glibmm/convert.h>
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "ardour/debug.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -67,6 +74,29 @@ const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::RemovableIfEmpty |
 		Source::CanRename );
 
+/** @return size of a sample in bytes, for formats that store samples as-is, otherwise 0 */
+static int
+pcm_sample_bytes (int format)
+{
+	switch (format & SF_FORMAT_SUBMASK) {
+		case SF_FORMAT_PCM_S8:
+		case SF_FORMAT_PCM_U8:
+			return 1;
+		case SF_FORMAT_PCM_16:
+			return 2;
+		case SF_FORMAT_PCM_24:
+			return 3;
+		case SF_FORMAT_PCM_32:
+		case SF_FORMAT_FLOAT:
+			return 4;
+		case SF_FORMAT_DOUBLE:
+			return 8;
+		default:
+			break;
+	}
+	return 0;
+}
+
 SndFileSource::SndFileSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, AudioFileSource (s, node)
@@ -340,6 +370,13 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_fd.store (-1);
+	_data_offset     = 0;
+	_bytes_per_frame = 0;
+	_write_fd        = -1;
+	_preallocate     = false;
+	_preallocated    = 0;
+
 	AudioFileSource::HeaderPositionOffsetChanged.connect_same_thread (header_position_connection, std::bind (&SndFileSource::handle_header_position_change, this));
 }
 
@@ -347,6 +384,9 @@ void
 SndFileSource::close ()
 {
 	if (_sndfile) {
+		_fd.store (-1);
+		trim_preallocation ();
+		_write_fd = -1;
 		sf_close (_sndfile);
 		_sndfile = 0;
 		file_closed ();
@@ -401,6 +441,14 @@ SndFileSource::open ()
 
 	_length = timecnt_t (_info.frames);
 
+	if (!writable ()) {
+		locate_data (fd);
+	} else if (pcm_sample_bytes (_info.format) > 0) {
+		_bytes_per_frame = pcm_sample_bytes (_info.format) * _info.channels;
+		_write_fd        = fd;
+		_preallocate     = true;
+	}
+
 #ifdef HAVE_RF64_RIFF
 	if (_file_is_new && _length == 0 && writable()) {
 		if (_flags & RF64_RIFF) {
@@ -489,6 +537,70 @@ SndFileSource::open ()
 	return 0;
 }
 
+/** Find where the sample data starts, for files that store samples
+ * as-is, in a single chunk.
+ */
+void
+SndFileSource::locate_data (int fd)
+{
+#ifndef PLATFORM_WINDOWS
+	int const bytes = pcm_sample_bytes (_info.format);
+
+	if (bytes == 0) {
+		return;
+	}
+
+	switch (_info.format & SF_FORMAT_TYPEMASK) {
+		case SF_FORMAT_WAV:
+		case SF_FORMAT_WAVEX:
+		case SF_FORMAT_RF64:
+		case SF_FORMAT_AIFF:
+		case SF_FORMAT_CAF:
+			break;
+		default:
+			return;
+	}
+
+	/* libsndfile reads unbuffered from the file descriptor,
+	 * seeking to the first sample leaves it at the start of the data.
+	 */
+	if (sf_seek (_sndfile, 0, SEEK_SET) != 0) {
+		return;
+	}
+
+	off_t const offset = lseek (fd, 0, SEEK_CUR);
+
+	if (offset <= 0) {
+		return;
+	}
+
+	_data_offset     = offset;
+	_bytes_per_frame = bytes * _info.channels;
+	_fd.store (fd);
+#endif
+}
+
+bool
+SndFileSource::file_extent (samplepos_t start, samplecnt_t cnt, int& fd, int64_t& offset, size_t& len) const
+{
+	fd = _fd.load ();
+
+	if (fd < 0 || start < 0 || cnt <= 0) {
+		return false;
+	}
+
+	samplecnt_t const length = _length.samples ();
+
+	if (start >= length) {
+		return false;
+	}
+
+	cnt    = std::min (cnt, length - start);
+	offset = _data_offset + (int64_t) start * _bytes_per_frame;
+	len    = (size_t) cnt * _bytes_per_frame;
+	return true;
+}
+
 SndFileSource::~SndFileSource ()
 {
 	close ();
@@ -627,6 +739,8 @@ SndFileSource::nondestructive_write_unlocked (Sample const * data, samplecnt_t c
 	assert (_length.time_domain() == Temporal::AudioTime);
 	samplepos_t sample_pos = _length.samples();
 
+	preallocate (sample_pos + cnt);
+
 	if (write_float (data, sample_pos, cnt) != cnt) {
 		return 0;
 	}
@@ -641,6 +755,81 @@ SndFileSource::nondestructive_write_unlocked (Sample const * data, samplecnt_t c
 	return cnt;
 }
 
+/** Reserve disk space ahead of the data that is written.
+ *
+ * The file grows by appending chunks of data, which otherwise makes the
+ * filesystem allocate blocks during a take. The space is allocated beyond
+ * the end of the file, the file size (and hence the file as seen by
+ * libsndfile and other readers) is not changed.
+ */
+void
+SndFileSource::preallocate (samplepos_t end)
+{
+#ifdef FALLOC_FL_KEEP_SIZE
+	/* leave room for header chunks that are written in front of the data */
+	const int64_t header_size = 65536;
+	const int64_t block_size  = 1048576;
+
+	if (!_preallocate || (int64_t) end * _bytes_per_frame + header_size <= _preallocated) {
+		return;
+	}
+
+	float const seconds = Config->get_capture_preallocate_seconds ();
+
+	if (seconds <= 0) {
+		return;
+	}
+
+	struct stat statbuf;
+
+	if (fstat (_write_fd, &statbuf) != 0) {
+		_preallocate = false;
+		return;
+	}
+
+	/* allocate whole blocks */
+	int64_t const size   = statbuf.st_size;
+	int64_t const extent = (int64_t) (seconds * _info.samplerate) * _bytes_per_frame;
+	int64_t const alloc  = ((size + header_size + extent) / block_size + 1) * block_size;
+
+	if (fallocate (_write_fd, FALLOC_FL_KEEP_SIZE, size, alloc - size) != 0) {
+		/* not supported by the filesystem, or out of space: just append */
+		DEBUG_TRACE (DEBUG::DiskIO, string_compose ("cannot preallocate %1: %2\n", _path, strerror (errno)));
+		_preallocate = false;
+		return;
+	}
+
+	_preallocated = alloc;
+#endif
+}
+
+/** Release the space that was allocated but not written to */
+void
+SndFileSource::trim_preallocation ()
+{
+#ifdef FALLOC_FL_KEEP_SIZE
+	if (_write_fd < 0 || _preallocated == 0) {
+		return;
+	}
+
+	struct stat statbuf;
+
+	/* truncating to the current size frees all blocks beyond the end of the file */
+	if (fstat (_write_fd, &statbuf) == 0 && ftruncate (_write_fd, statbuf.st_size) != 0) {
+		warning << string_compose (_("cannot release unused space of %1 (%2)"), _path, strerror (errno)) << endmsg;
+	}
+
+	_preallocated = 0;
+#endif
+}
+
+void
+SndFileSource::mark_streaming_write_completed (const WriterLock& lock, Temporal::timecnt_t const & duration)
+{
+	AudioFileSource::mark_streaming_write_completed (lock, duration);
+	trim_preallocation ();
+}
+
 int
 SndFileSource::update_header (samplepos_t when, struct tm& now, time_t tnow)
 {
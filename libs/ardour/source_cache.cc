@@ -0,0 +1,288 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "pbd/compose.h"
+#include "pbd/pthread_utils.h"
+
+#include "ardour/audiosource.h"
+#include "ardour/debug.h"
+#include "ardour/source_cache.h"
+
+using namespace ARDOUR;
+
+/* 256 kB per block of float samples */
+const samplecnt_t SourceCache::block_samples;
+
+SourceCache&
+SourceCache::instance ()
+{
+	static SourceCache cache;
+	return cache;
+}
+
+SourceCache::SourceCache ()
+	: _used (0)
+	, _budget (0)
+	, _preload_thread (0)
+	, _stop_preload (false)
+{
+}
+
+SourceCache::~SourceCache ()
+{
+	stop_preload ();
+}
+
+void
+SourceCache::set_budget (size_t bytes)
+{
+	_budget.store (bytes);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+	evict_locked ();
+}
+
+size_t
+SourceCache::used () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _used;
+}
+
+void
+SourceCache::erase_locked (std::map<Key, Entry>::iterator i)
+{
+	_used -= i->second.block->size () * sizeof (Sample);
+	_lru.erase (i->second.lru);
+	_blocks.erase (i);
+}
+
+void
+SourceCache::evict_locked ()
+{
+	size_t const budget = _budget.load ();
+
+	while (_used > budget && !_lru.empty ()) {
+		erase_locked (_blocks.find (_lru.back ()));
+	}
+}
+
+void
+SourceCache::drop (PBD::ID const& id)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	std::map<Key, Entry>::iterator i = _blocks.lower_bound (Key (id, 0));
+
+	while (i != _blocks.end () && i->first.first == id) {
+		erase_locked (i++);
+	}
+
+	/* do not cache data that is being read meanwhile */
+	++_generation[id];
+}
+
+void
+SourceCache::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_blocks.clear ();
+	_lru.clear ();
+	_used = 0;
+}
+
+std::shared_ptr<SourceCache::Block const>
+SourceCache::block (PBD::ID const& id, Reader const& reader, samplepos_t index, samplecnt_t len)
+{
+	Key const key (id, index);
+	uint64_t  generation;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		std::map<Key, Entry>::iterator i = _blocks.find (key);
+		if (i != _blocks.end ()) {
+			_lru.splice (_lru.begin (), _lru, i->second.lru);
+			return i->second.block;
+		}
+		std::map<PBD::ID, uint64_t>::const_iterator g = _generation.find (id);
+		generation = g == _generation.end () ? 0 : g->second;
+	}
+
+	/* read without holding the lock, other threads may use the cache meanwhile */
+	std::shared_ptr<Block> b (new Block (len));
+
+	if (reader (&(*b)[0], index * block_samples, len) != len) {
+		return std::shared_ptr<Block const> ();
+	}
+
+	size_t const bytes = len * sizeof (Sample);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	std::map<PBD::ID, uint64_t>::const_iterator g = _generation.find (id);
+	if ((g == _generation.end () ? 0 : g->second) != generation) {
+		/* the source was modified (e.g. its gain changed) during the read,
+		 * the data is stale. The caller reads it again, uncached.
+		 */
+		return std::shared_ptr<Block const> ();
+	}
+
+	if (bytes > _budget.load ()) {
+		return b;
+	}
+
+	std::map<Key, Entry>::iterator i = _blocks.find (key);
+
+	if (i != _blocks.end ()) {
+		/* another thread was faster */
+		return i->second.block;
+	}
+
+	_lru.push_front (key);
+
+	Entry e;
+	e.block = b;
+	e.lru   = _lru.begin ();
+	_blocks.insert (std::make_pair (key, e));
+
+	_used += bytes;
+	evict_locked ();
+
+	return b;
+}
+
+samplecnt_t
+SourceCache::read (AudioSource const& src, Sample* dst, samplepos_t start, samplecnt_t cnt)
+{
+	return read (src.id (), src.readable_length_samples (), [&src] (Sample* d, samplepos_t s, samplecnt_t c) { return src.read_uncached (d, s, c); }, dst, start, cnt);
+}
+
+samplecnt_t
+SourceCache::read (PBD::ID const& id, samplecnt_t length, Reader const& reader, Sample* dst, samplepos_t start, samplecnt_t cnt)
+{
+	samplecnt_t rv = 0;
+
+	while (cnt > 0) {
+		samplepos_t const index  = start / block_samples;
+		samplecnt_t const offset = start - index * block_samples;
+		samplecnt_t const n      = std::min (cnt, block_samples - offset);
+
+		std::shared_ptr<Block const> b;
+
+		if (start < length) {
+			b = block (id, reader, index, std::min (block_samples, length - index * block_samples));
+		}
+
+		if (b && offset + n <= (samplecnt_t) b->size ()) {
+			memcpy (dst, &(*b)[offset], n * sizeof (Sample));
+		} else {
+			/* beyond the end of the source, or a read error */
+			samplecnt_t const r = reader (dst, start, n);
+			if (r != n) {
+				return rv + r;
+			}
+		}
+
+		rv    += n;
+		dst   += n;
+		start += n;
+		cnt   -= n;
+	}
+
+	return rv;
+}
+
+void
+SourceCache::preload (std::vector<Range> const& ranges)
+{
+	stop_preload ();
+
+	if (!enabled () || ranges.empty ()) {
+		return;
+	}
+
+	_preload_ranges = ranges;
+	_stop_preload.store (false);
+	_preload_thread = PBD::Thread::create (std::bind (&SourceCache::preload_thread, this), "SourceCache");
+}
+
+void
+SourceCache::stop_preload ()
+{
+	if (_preload_thread) {
+		_stop_preload.store (true);
+		_preload_thread->join ();
+		delete _preload_thread;
+		_preload_thread = 0;
+	}
+
+	_preload_ranges.clear ();
+
+	std::vector<std::shared_ptr<AudioSource> > orphans;
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		orphans.swap (_orphans);
+	}
+	/* sources are destroyed here, not in the preload thread */
+	orphans.clear ();
+}
+
+void
+SourceCache::preload_thread ()
+{
+	size_t const block_bytes = block_samples * sizeof (Sample);
+
+	for (auto const& r : _preload_ranges) {
+		for (samplepos_t index = r.start / block_samples; index * block_samples < r.start + r.cnt; ++index) {
+
+			/* do not evict what was loaded before */
+			if (_stop_preload.load () || used () + block_bytes > _budget.load ()) {
+				DEBUG_TRACE (DEBUG::DiskIO, string_compose ("source cache preload done, using %1 bytes\n", used ()));
+				return;
+			}
+
+			std::shared_ptr<AudioSource> src = r.source.lock ();
+
+			if (!src || !src->cacheable ()) {
+				break;
+			}
+
+			samplecnt_t const length = src->readable_length_samples ();
+
+			if (index * block_samples >= length) {
+				break;
+			}
+
+			AudioSource const& as (*src);
+			block (as.id (), [&as] (Sample* d, samplepos_t s, samplecnt_t c) { return as.read_uncached (d, s, c); },
+			       index, std::min (block_samples, length - index * block_samples));
+
+			if (src.use_count () == 1) {
+				/* the source was removed meanwhile. Do not destroy it in this
+				 * thread, and stop loading it.
+				 */
+				Glib::Threads::Mutex::Lock lm (_lock);
+				_orphans.push_back (src);
+				break;
+			}
+		}
+	}
+
+	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("source cache preload complete, using %1 bytes\n", used ()));
+}
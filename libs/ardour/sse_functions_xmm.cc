@@ -18,6 +18,7 @@
  */
 
 #include <xmmintrin.h>
+#include "ardour/mix.h"
 #include "ardour/types.h"
 
 void
@@ -114,5 +115,241 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 	_mm_store_ss(max, work);
 }
 
+/**
+ * @brief x86 SSE optimized FIR kernel for ArdourZita::VMResampler
+ *
+ * Interpolates the filter coefficients between two phases and
+ * convolves them with the input history, see VMResampler::default_filter.
+ */
+float
+x86_sse_resample_filter (const float* p1, const float* p2, const float* q1, const float* q2, float a, float b, uint32_t hl)
+{
+	const int n = hl;
+	int i = 0;
+
+	__m128 va  = _mm_set1_ps(a);
+	__m128 vb  = _mm_set1_ps(b);
+	// bias each lane to avoid denormals, as the scalar kernel does
+	__m128 acc = _mm_set1_ps(1e-25f);
+
+	for (; i + 4 <= n; i += 4) {
+		__m128 c1 = _mm_add_ps(_mm_mul_ps(va, _mm_loadu_ps(q1 + i)), _mm_mul_ps(vb, _mm_loadu_ps(q1 + i + n)));
+		__m128 c2 = _mm_add_ps(_mm_mul_ps(va, _mm_loadu_ps(q2 + i)), _mm_mul_ps(vb, _mm_loadu_ps(q2 + i - n)));
+
+		__m128 x1 = _mm_loadu_ps(p1 + i);
+		// p2 is read backwards: p2[-i-1] ... p2[-i-4]
+		__m128 x2 = _mm_loadu_ps(p2 - i - 4);
+		x2 = _mm_shuffle_ps(x2, x2, _MM_SHUFFLE(0, 1, 2, 3));
+
+		acc = _mm_add_ps(acc, _mm_add_ps(_mm_mul_ps(x1, c1), _mm_mul_ps(x2, c2)));
+	}
+
+	// Horizontal sum
+	acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+	acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
 
+	float s = _mm_cvtss_f32(acc);
 
+	for (; i < n; ++i) {
+		const float c1 = a * q1[i] + b * q1[i + n];
+		const float c2 = a * q2[i] + b * q2[i - n];
+		s += p1[i] * c1 + p2[-i - 1] * c2;
+	}
+
+	return s - 4 * 1e-25f;
+}
+
+/* Meter ballistics, four channels at a time: one channel per lane.
+ * The samples are loaded in blocks of four per channel, and transposed
+ * so that s[j] holds sample j of each channel. The operations are the
+ * same as in default_kmeter_process() etc., so the results are identical.
+ */
+
+static inline void
+load_transposed (const float* const* buf, uint32_t i, __m128* s)
+{
+	s[0] = _mm_loadu_ps (buf[0] + i);
+	s[1] = _mm_loadu_ps (buf[1] + i);
+	s[2] = _mm_loadu_ps (buf[2] + i);
+	s[3] = _mm_loadu_ps (buf[3] + i);
+	_MM_TRANSPOSE4_PS (s[0], s[1], s[2], s[3]);
+}
+
+void
+x86_sse_kmeter_process (const float* const* buf, float* z1, float* z2, uint32_t nframes, float omega)
+{
+	const __m128 w  = _mm_set1_ps (omega);
+	const __m128 w4 = _mm_set1_ps (4 * omega);
+
+	__m128 a = _mm_loadu_ps (z1);
+	__m128 b = _mm_loadu_ps (z2);
+
+	for (uint32_t i = 0; i < nframes; i += 4) {
+		__m128 s[4];
+		load_transposed (buf, i, s);
+		for (int j = 0; j < 4; ++j) {
+			a = _mm_add_ps (a, _mm_mul_ps (w, _mm_sub_ps (_mm_mul_ps (s[j], s[j]), a)));
+		}
+		b = _mm_add_ps (b, _mm_mul_ps (w4, _mm_sub_ps (a, b)));
+	}
+
+	_mm_storeu_ps (z1, a);
+	_mm_storeu_ps (z2, b);
+}
+
+void
+x86_sse_ppm_process (const float* const* buf, float* z1, float* z2, float* m, uint32_t nframes, float w1, float w2, float w3)
+{
+	const __m128 sign = _mm_set1_ps (-0.f);
+	const __m128 vw1  = _mm_set1_ps (w1);
+	const __m128 vw2  = _mm_set1_ps (w2);
+	const __m128 vw3  = _mm_set1_ps (w3);
+
+	__m128 a  = _mm_loadu_ps (z1);
+	__m128 b  = _mm_loadu_ps (z2);
+	__m128 mx = _mm_loadu_ps (m);
+
+	for (uint32_t i = 0; i < nframes; i += 4) {
+		__m128 s[4];
+		load_transposed (buf, i, s);
+		a = _mm_mul_ps (a, vw3);
+		b = _mm_mul_ps (b, vw3);
+
+		__m128 t[4];
+		for (int j = 0; j < 4; ++j) {
+			t[j] = _mm_andnot_ps (sign, s[j]);
+		}
+
+		/* the filters only rise if a sample exceeds their value, which
+		 * is rare; skip the (serial) updates if no channel needs them.
+		 */
+		const __m128 tmax = _mm_max_ps (_mm_max_ps (t[0], t[1]), _mm_max_ps (t[2], t[3]));
+		if (_mm_movemask_ps (_mm_cmpgt_ps (tmax, _mm_min_ps (a, b)))) {
+			for (int j = 0; j < 4; ++j) {
+				/* if (t > z) z += w * (t - z) */
+				a = _mm_add_ps (a, _mm_and_ps (_mm_cmpgt_ps (t[j], a), _mm_mul_ps (vw1, _mm_sub_ps (t[j], a))));
+				b = _mm_add_ps (b, _mm_and_ps (_mm_cmpgt_ps (t[j], b), _mm_mul_ps (vw2, _mm_sub_ps (t[j], b))));
+			}
+		}
+		/* if (t > m) m = t */
+		mx = _mm_max_ps (_mm_add_ps (a, b), mx);
+	}
+
+	_mm_storeu_ps (z1, a);
+	_mm_storeu_ps (z2, b);
+	_mm_storeu_ps (m, mx);
+}
+
+void
+x86_sse_vumeter_process (const float* const* buf, float* z1, float* z2, float* m, uint32_t nframes, float w)
+{
+	const __m128 sign = _mm_set1_ps (-0.f);
+	const __m128 half = _mm_set1_ps (.5f);
+	const __m128 vw   = _mm_set1_ps (w);
+	const __m128 vw4  = _mm_set1_ps (4 * w);
+
+	__m128 a  = _mm_loadu_ps (z1);
+	__m128 b  = _mm_loadu_ps (z2);
+	__m128 mx = _mm_loadu_ps (m);
+
+	for (uint32_t i = 0; i < nframes; i += 4) {
+		__m128 s[4];
+		load_transposed (buf, i, s);
+		const __m128 t2 = _mm_mul_ps (b, half);
+		for (int j = 0; j < 4; ++j) {
+			const __m128 t1 = _mm_sub_ps (_mm_andnot_ps (sign, s[j]), t2);
+			a = _mm_add_ps (a, _mm_mul_ps (vw, _mm_sub_ps (t1, a)));
+		}
+		b  = _mm_add_ps (b, _mm_mul_ps (vw4, _mm_sub_ps (a, b)));
+		mx = _mm_max_ps (b, mx);
+	}
+
+	_mm_storeu_ps (z1, a);
+	_mm_storeu_ps (z2, b);
+	_mm_storeu_ps (m, mx);
+}
+
+/* K-weighting filter, four channels at a time: one channel per lane,
+ * same operations as default_kweight_process().
+ */
+
+void
+x86_sse_kweight_process (const float* const* buf, float* z, float* sum, uint32_t nframes, const float* coeff)
+{
+	const __m128 a0  = _mm_set1_ps (coeff[0]);
+	const __m128 a1  = _mm_set1_ps (coeff[1]);
+	const __m128 a2  = _mm_set1_ps (coeff[2]);
+	const __m128 b1  = _mm_set1_ps (coeff[3]);
+	const __m128 b2  = _mm_set1_ps (coeff[4]);
+	const __m128 c3  = _mm_set1_ps (coeff[5]);
+	const __m128 c4  = _mm_set1_ps (coeff[6]);
+	const __m128 eps = _mm_set1_ps (1e-15f);
+
+	__m128 z1 = _mm_loadu_ps (z);
+	__m128 z2 = _mm_loadu_ps (z + 4);
+	__m128 z3 = _mm_loadu_ps (z + 8);
+	__m128 z4 = _mm_loadu_ps (z + 12);
+	__m128 s  = _mm_setzero_ps ();
+
+	auto step = [&] (__m128 d) {
+		const __m128 x = _mm_add_ps (_mm_sub_ps (_mm_sub_ps (d, _mm_mul_ps (b1, z1)), _mm_mul_ps (b2, z2)), eps);
+		const __m128 y = _mm_sub_ps (_mm_sub_ps (_mm_add_ps (_mm_add_ps (_mm_mul_ps (a0, x), _mm_mul_ps (a1, z1)), _mm_mul_ps (a2, z2)), _mm_mul_ps (c3, z3)), _mm_mul_ps (c4, z4));
+		z2 = z1;
+		z1 = x;
+		z4 = _mm_add_ps (z4, z3);
+		z3 = _mm_add_ps (z3, y);
+		s  = _mm_add_ps (s, _mm_mul_ps (y, y));
+	};
+
+	uint32_t i = 0;
+	for (; i + 4 <= nframes; i += 4) {
+		__m128 d[4];
+		load_transposed (buf, i, d);
+		step (d[0]);
+		step (d[1]);
+		step (d[2]);
+		step (d[3]);
+	}
+	for (; i < nframes; ++i) {
+		step (_mm_setr_ps (buf[0][i], buf[1][i], buf[2][i], buf[3][i]));
+	}
+
+	_mm_storeu_ps (z, z1);
+	_mm_storeu_ps (z + 4, z2);
+	_mm_storeu_ps (z + 8, z3);
+	_mm_storeu_ps (z + 12, z4);
+	_mm_storeu_ps (sum, s);
+}
+
+/* True-peak, four consecutive output samples at a time: one sample per
+ * lane. The filter taps are summed in the same order as in
+ * default_compute_true_peak(), which also processes the remaining samples.
+ */
+
+float
+x86_sse_compute_true_peak (const float* buf, uint32_t nframes, const float* coeff, uint32_t n_phases, float current)
+{
+	const __m128 sign = _mm_set1_ps (-0.f);
+
+	__m128   m = _mm_set1_ps (current);
+	uint32_t i = 0;
+
+	for (; i + 4 <= nframes; i += 4) {
+		const float* r = &buf[i];
+		m = _mm_max_ps (m, _mm_andnot_ps (sign, _mm_loadu_ps (r + 47)));
+		for (uint32_t p = 0; p < n_phases; ++p) {
+			const float* h = &coeff[48 * p];
+			__m128       u = _mm_mul_ps (_mm_loadu_ps (r), _mm_load1_ps (h));
+			for (int k = 1; k < 48; ++k) {
+				u = _mm_add_ps (u, _mm_mul_ps (_mm_loadu_ps (r + k), _mm_load1_ps (h + k)));
+			}
+			m = _mm_max_ps (m, _mm_andnot_ps (sign, u));
+		}
+	}
+
+	m = _mm_max_ps (m, _mm_movehl_ps (m, m));
+	m = _mm_max_ss (m, _mm_shuffle_ps (m, m, _MM_SHUFFLE (1, 1, 1, 1)));
+	_mm_store_ss (&current, m);
+
+	return default_compute_true_peak (&buf[i], nframes - i, coeff, n_phases, current);
+}
@@ -25,6 +25,13 @@ FPUTest::setUp ()
 		_test2[i] = _comp2[i] = 2.5 / (i + 1.0);
 	}
 
+	resample_filter = 0;
+	kmeter_process  = 0;
+	ppm_process     = 0;
+	vumeter_process = 0;
+
+	kweight_process   = 0;
+	compute_true_peak = 0;
 }
 
 void
@@ -83,6 +90,96 @@ FPUTest::run (size_t align_max, float const max_diff)
 			CPPUNIT_ASSERT_MESSAGE (string_compose ("Find peaks not aligned off: %1 cnt: %2", off, cnt), fabsf (pk_test - pk_comp) < 2e-6 && fabsf (pk_test_max - pk_comp_max) < 2e-6);
 		}
 	}
+
+	if (kmeter_process) {
+		/* meter ballistics, four channels per call. The kernels must
+		 * produce the same results as the scalar code.
+		 */
+		float const* buf[4] = { _comp1, _comp2, &_comp1[_size / 2], &_comp2[_size / 4] };
+		uint32_t const n    = _size / 4;
+
+		float z1_test[4] = { 0, 1, 2, 50 };
+		float z2_test[4] = { 0, 2, 1, 50 };
+		float m_test[4]  = { 0, 0, 5, 0 };
+		float z1_comp[4] = { 0, 1, 2, 50 };
+		float z2_comp[4] = { 0, 2, 1, 50 };
+		float m_comp[4]  = { 0, 0, 5, 0 };
+
+		kmeter_process (buf, z1_test, z2_test, n, 0.01f);
+		default_kmeter_process (buf, z1_comp, z2_comp, n, 0.01f);
+		for (int c = 0; c < 4; ++c) {
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("K-meter channel: %1", c), z1_test[c] == z1_comp[c] && z2_test[c] == z2_comp[c]);
+		}
+
+		ppm_process (buf, z1_test, z2_test, m_test, n, 0.3f, 0.02f, 0.99f);
+		default_ppm_process (buf, z1_comp, z2_comp, m_comp, n, 0.3f, 0.02f, 0.99f);
+		for (int c = 0; c < 4; ++c) {
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("PPM channel: %1", c), z1_test[c] == z1_comp[c] && z2_test[c] == z2_comp[c] && m_test[c] == m_comp[c]);
+		}
+
+		vumeter_process (buf, z1_test, z2_test, m_test, n, 0.005f);
+		default_vumeter_process (buf, z1_comp, z2_comp, m_comp, n, 0.005f);
+		for (int c = 0; c < 4; ++c) {
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("VU-meter channel: %1", c), z1_test[c] == z1_comp[c] && z2_test[c] == z2_comp[c] && m_test[c] == m_comp[c]);
+		}
+	}
+
+	if (kweight_process) {
+		/* loudness meter K-weighting, four channels per call, and
+		 * true-peak for all block sizes (47 samples history).
+		 */
+		float const coeff[7] = { 1.53f, -2.69f, 1.20f, -1.69f, 0.73f, 0.002f, 0.001f };
+
+		for (uint32_t n = 1; n < 2 * align_max; ++n) {
+			float const* buf[4] = { &_comp1[n], &_comp2[n], &_comp1[_size / 2], &_comp2[3] };
+
+			float z_test[16];
+			float z_comp[16];
+			float s_test[4];
+			float s_comp[4];
+			for (int i = 0; i < 16; ++i) {
+				z_test[i] = z_comp[i] = .01f * i;
+			}
+
+			kweight_process (buf, z_test, s_test, n, coeff);
+			default_kweight_process (buf, z_comp, s_comp, n, coeff);
+			for (int c = 0; c < 4; ++c) {
+				CPPUNIT_ASSERT_MESSAGE (string_compose ("K-weighting n: %1 channel: %2 (%3 != %4)", n, c, s_test[c], s_comp[c]), fabsf (s_test[c] - s_comp[c]) <= 1e-5 * (1.f + fabsf (s_comp[c])));
+			}
+
+			float tp_coeff[3 * 48];
+			for (int i = 0; i < 3 * 48; ++i) {
+				tp_coeff[i] = (i % 48 == 23 ? .9f : .01f) - .001f * (i % 48);
+			}
+			for (uint32_t phases = 1; phases <= 3; ++phases) {
+				float const pk_test = compute_true_peak (&_comp2[n], n, tp_coeff, phases, 0.5f);
+				float const pk_comp = default_compute_true_peak (&_comp2[n], n, tp_coeff, phases, 0.5f);
+				CPPUNIT_ASSERT_MESSAGE (string_compose ("True-peak n: %1 phases: %2 (%3 != %4)", n, phases, pk_test, pk_comp), fabsf (pk_test - pk_comp) <= 1e-5 * (1.f + fabsf (pk_comp)));
+			}
+		}
+	}
+
+	if (!resample_filter) {
+		return;
+	}
+
+	/* resampler FIR kernel, for all supported filter lengths.
+	 * p1 = [0, hl), p2 = [hl, 2 * hl) reversed, q1 = [0, 2 * hl), q2 = [hl, 3 * hl)
+	 */
+	for (uint32_t hl = 8; hl <= 96; ++hl) {
+		for (size_t off = 0; off < align_max; ++off) {
+			float const* p1 = &_comp1[off];
+			float const* p2 = p1 + 2 * hl;
+			float const* q1 = &_comp2[off];
+			float const* q2 = q1 + 2 * hl;
+			float const  b  = off / (float) align_max;
+
+			float r_test = resample_filter (p1, p2, q1, q2, 1.f - b, b, hl);
+			float r_comp = ArdourZita::VMResampler::default_filter (p1, p2, q1, q2, 1.f - b, b, hl);
+
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Resample filter hl: %1 off: %2 (%3 != %4)", hl, off, r_test, r_comp), fabsf (r_test - r_comp) <= 1e-5 * (1.f + fabsf (r_comp)));
+		}
+	}
 }
 
 void
@@ -122,6 +219,12 @@ FPUTest::avxFmaTest ()
 	mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
+	resample_filter       = x86_fma_resample_filter;
+	kmeter_process        = x86_sse_kmeter_process;
+	ppm_process           = x86_sse_ppm_process;
+	vumeter_process       = x86_sse_vumeter_process;
+	kweight_process       = x86_sse_kweight_process;
+	compute_true_peak     = x86_sse_compute_true_peak;
 
 	run (align_max, FLT_EPSILON);
 }
@@ -149,6 +252,12 @@ FPUTest::avxTest ()
 	mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
+	resample_filter       = x86_sse_resample_filter;
+	kmeter_process        = x86_sse_kmeter_process;
+	ppm_process           = x86_sse_ppm_process;
+	vumeter_process       = x86_sse_vumeter_process;
+	kweight_process       = x86_sse_kweight_process;
+	compute_true_peak     = x86_sse_compute_true_peak;
 
 	run (align_max);
 }
@@ -176,6 +285,12 @@ FPUTest::avx512fTest ()
 	mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 	copy_vector           = x86_avx512f_copy_vector;
+	resample_filter       = x86_avx512f_resample_filter;
+	kmeter_process        = x86_sse_kmeter_process;
+	ppm_process           = x86_sse_ppm_process;
+	vumeter_process       = x86_sse_vumeter_process;
+	kweight_process       = x86_sse_kweight_process;
+	compute_true_peak     = x86_sse_compute_true_peak;
 
 	run (align_max, FLT_EPSILON);
 }
@@ -203,6 +318,12 @@ FPUTest::sseTest ()
 	mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
+	resample_filter       = x86_sse_resample_filter;
+	kmeter_process        = x86_sse_kmeter_process;
+	ppm_process           = x86_sse_ppm_process;
+	vumeter_process       = x86_sse_vumeter_process;
+	kweight_process       = x86_sse_kweight_process;
+	compute_true_peak     = x86_sse_compute_true_peak;
 
 	run (align_max);
 }
@@ -227,6 +348,14 @@ FPUTest::neonTest ()
 	mix_buffers_with_gain = arm_neon_mix_buffers_with_gain;
 	mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 	copy_vector           = arm_neon_copy_vector;
+	resample_filter       = arm_neon_resample_filter;
+#ifdef __aarch64__
+	kmeter_process        = arm_neon_kmeter_process;
+	ppm_process           = arm_neon_ppm_process;
+	vumeter_process       = arm_neon_vumeter_process;
+	kweight_process       = arm_neon_kweight_process;
+	compute_true_peak     = arm_neon_compute_true_peak;
+#endif
 
 	run (128);
 }
@@ -3,6 +3,8 @@
 
 #include "ardour/runtime_functions.h"
 
+#include "zita-resampler/vmresampler.h"
+
 class FPUTest : public CppUnit::TestFixture
 {
 	CPPUNIT_TEST_SUITE (FPUTest);
@@ -48,6 +50,14 @@ private:
 	ARDOUR::mix_buffers_no_gain_t   mix_buffers_no_gain;
 	ARDOUR::copy_vector_t           copy_vector;
 
+	ArdourZita::VMResampler::filter_t resample_filter;
+
+	ARDOUR::kmeter_process_t    kmeter_process;
+	ARDOUR::ppm_process_t       ppm_process;
+	ARDOUR::vumeter_process_t   vumeter_process;
+	ARDOUR::kweight_process_t   kweight_process;
+	ARDOUR::compute_true_peak_t compute_true_peak;
+
 	size_t _size;
 
 	float* _test1;
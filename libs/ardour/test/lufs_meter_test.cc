@@ -0,0 +1,120 @@
+#include <cmath>
+#include <vector>
+
+#include "ardour/lufs_meter.h"
+
+#include "lufs_meter_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (LUFSMeterTest);
+
+using namespace ARDOUR;
+
+/* The test signals follow EBU Tech 3341 (Loudness Metering: 'EBU Mode'
+ * metering to supplement EBU R 128 loudness normalization), which
+ * specifies a tolerance of +/- 0.1 LU, and +0.2/-0.4 dB for true-peak.
+ */
+
+namespace {
+
+/** Feed @a seconds of a sine with the given level (in dBFS, peak) and
+ * frequency to all channels of @a m. The signal is processed in blocks
+ * of an odd size, to exercise partial kernel blocks.
+ */
+void
+sine (LUFSMeter& m, uint32_t n_channels, double sr, float dbfs, double freq, double seconds, double phase = 0)
+{
+	const uint32_t bs = 1001;
+	const float    g  = powf (10.f, .05f * dbfs);
+	const uint64_t n  = seconds * sr;
+
+	std::vector<std::vector<float>> buf (n_channels, std::vector<float> (bs));
+	std::vector<float const*>       data (n_channels);
+
+	for (uint64_t pos = 0; pos < n; pos += bs) {
+		const uint32_t ns = std::min<uint64_t> (bs, n - pos);
+		for (uint32_t c = 0; c < n_channels; ++c) {
+			for (uint32_t i = 0; i < ns; ++i) {
+				buf[c][i] = g * sin (phase + 2 * M_PI * freq * (pos + i) / sr);
+			}
+			data[c] = &buf[c][0];
+		}
+		m.run (&data[0], ns);
+	}
+}
+
+} // namespace
+
+void
+LUFSMeterTest::loudnessTest ()
+{
+	/* Tech 3341, case 1 and 2: stereo 1 kHz sine, 20 sec */
+	for (double sr : { 44100., 48000., 96000. }) {
+		LUFSMeter m (sr, 2);
+		sine (m, 2, sr, -23, 1000, 20);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, m.momentary (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, m.integrated_loudness (), 0.1);
+
+		m.reset ();
+		sine (m, 2, sr, -33, 1000, 20);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-33.f, m.momentary (), 0.1);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (-33.f, m.integrated_loudness (), 0.1);
+	}
+
+	/* all channel counts, surround channels are weighted by +1.5dB.
+	 * (the integrated loudness is quantized to 0.1 LU, use momentary)
+	 */
+	for (uint32_t n_channels = 1; n_channels <= 5; ++n_channels) {
+		LUFSMeter m (48000, n_channels);
+		sine (m, n_channels, 48000, -23, 1000, 1);
+
+		float expected = -23 + 10 * log10f (n_channels / 2.f);
+		if (n_channels == 1) {
+			expected = -23; // mono is counted twice
+		} else if (n_channels > 3) {
+			expected = -23 + 10 * log10f ((3 + (n_channels - 3) * 1.41f) / 2.f);
+		}
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (expected, m.momentary (), 0.1);
+	}
+}
+
+void
+LUFSMeterTest::gatingTest ()
+{
+	/* Tech 3341, case 3: -36, -23, -36 dBFS; 10, 60, 10 sec */
+	LUFSMeter m (48000, 2);
+	sine (m, 2, 48000, -36, 1000, 10);
+	sine (m, 2, 48000, -23, 1000, 60);
+	sine (m, 2, 48000, -36, 1000, 10);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, m.integrated_loudness (), 0.1);
+
+	/* Tech 3341, case 4: -72, -36, -23, -36, -72 dBFS; 10, 10, 60, 10, 10 sec */
+	m.reset ();
+	sine (m, 2, 48000, -72, 1000, 10);
+	sine (m, 2, 48000, -36, 1000, 10);
+	sine (m, 2, 48000, -23, 1000, 60);
+	sine (m, 2, 48000, -36, 1000, 10);
+	sine (m, 2, 48000, -72, 1000, 10);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, m.integrated_loudness (), 0.1);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-23.f, m.max_momentary (), 0.1);
+}
+
+void
+LUFSMeterTest::truePeakTest ()
+{
+	/* Tech 3341, case 15..18 style: sine at fs/4, with a 45 degree phase
+	 * offset the sample-peak is 3dB below the true-peak.
+	 */
+	LUFSMeter m (48000, 2);
+	sine (m, 2, 48000, -6, 12000, 1, M_PI / 4);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-6.f, m.dbtp (), 0.3);
+
+	/* 2x upsampling */
+	LUFSMeter m2 (96000, 1);
+	sine (m2, 1, 96000, -6, 24000, 1, M_PI / 4);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-6.f, m2.dbtp (), 0.3);
+
+	/* a 1 kHz sine has the same sample-peak and true-peak */
+	m.reset ();
+	sine (m, 2, 48000, -1, 1000, 1);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (-1.f, m.dbtp (), 0.1);
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class LUFSMeterTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (LUFSMeterTest);
+	CPPUNIT_TEST (loudnessTest);
+	CPPUNIT_TEST (gatingTest);
+	CPPUNIT_TEST (truePeakTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void loudnessTest ();
+	void gatingTest ();
+	void truePeakTest ();
+};
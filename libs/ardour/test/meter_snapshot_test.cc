@@ -0,0 +1,75 @@
+#include <limits>
+
+#include "ardour/meter_snapshot.h"
+
+#include "meter_snapshot_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MeterSnapshotTest);
+
+using namespace ARDOUR;
+
+void
+MeterSnapshotTest::allocationTest ()
+{
+	MeterSnapshot ms;
+
+	CPPUNIT_ASSERT_EQUAL (-1, ms.allocate (0));
+
+	int32_t a = ms.allocate (2);
+	int32_t b = ms.allocate (1);
+	int32_t c = ms.allocate (4);
+
+	CPPUNIT_ASSERT_EQUAL (0, a);
+	CPPUNIT_ASSERT_EQUAL (2 * (int32_t)MeterSnapshot::NValues, b);
+	CPPUNIT_ASSERT_EQUAL (3 * (int32_t)MeterSnapshot::NValues, c);
+
+	/* freed slots are merged and reused */
+	ms.release (a, 2);
+	ms.release (b, 1);
+	CPPUNIT_ASSERT_EQUAL (0, ms.allocate (3));
+
+	/* growing the storage retains published values */
+	float* v = ms.back (c);
+	v[MeterSnapshot::Peak] = -6.f;
+	ms.publish ();
+
+	for (int i = 0; i < 100; ++i) {
+		ms.allocate (8);
+	}
+
+	float peak = 0;
+	CPPUNIT_ASSERT (ms.read (c + MeterSnapshot::Peak, 1, &peak));
+	CPPUNIT_ASSERT_EQUAL (-6.f, peak);
+}
+
+void
+MeterSnapshotTest::publishTest ()
+{
+	MeterSnapshot ms;
+
+	int32_t slot = ms.allocate (1);
+
+	float vals[MeterSnapshot::NValues];
+	CPPUNIT_ASSERT (ms.read (slot, MeterSnapshot::NValues, vals));
+	CPPUNIT_ASSERT_EQUAL (-std::numeric_limits<float>::infinity (), vals[MeterSnapshot::Peak]);
+	CPPUNIT_ASSERT_EQUAL (0.f, vals[MeterSnapshot::MaxPeak]);
+
+	uint64_t seq = ms.sequence ();
+
+	/* values are not visible before they are published */
+	ms.back (slot)[MeterSnapshot::MaxPeak] = 0.5f;
+	CPPUNIT_ASSERT (ms.read (slot, MeterSnapshot::NValues, vals));
+	CPPUNIT_ASSERT_EQUAL (0.f, vals[MeterSnapshot::MaxPeak]);
+
+	ms.publish ();
+	CPPUNIT_ASSERT (ms.sequence () != seq);
+	CPPUNIT_ASSERT_EQUAL (uint64_t (0), ms.sequence () & 1);
+
+	uint64_t read_seq = 0;
+	CPPUNIT_ASSERT (ms.read (slot, MeterSnapshot::NValues, vals, &read_seq));
+	CPPUNIT_ASSERT_EQUAL (0.5f, vals[MeterSnapshot::MaxPeak]);
+	CPPUNIT_ASSERT_EQUAL (ms.sequence (), read_seq);
+
+	/* out of range */
+	CPPUNIT_ASSERT (!ms.read (1u << 30, 1, vals));
+}
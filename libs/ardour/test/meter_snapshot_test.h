@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MeterSnapshotTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MeterSnapshotTest);
+	CPPUNIT_TEST (allocationTest);
+	CPPUNIT_TEST (publishTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void allocationTest ();
+	void publishTest ();
+};
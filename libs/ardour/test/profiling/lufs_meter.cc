@@ -0,0 +1,60 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <glibmm/timer.h>
+
+#include "ardour/ardour.h"
+#include "ardour/lufs_meter.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Loudness meter throughput: process <seconds> of noise with
+ * <channels> channels, in blocks of <blocksize> samples.
+ */
+int
+main (int argc, char* argv[])
+{
+	const uint32_t n_channels = argc > 1 ? atoi (argv[1]) : 2;
+	const double   seconds    = argc > 2 ? atof (argv[2]) : 600;
+	const uint32_t blocksize  = argc > 3 ? atoi (argv[3]) : 1024;
+	const double   sr         = argc > 4 ? atof (argv[4]) : 48000;
+
+	if (n_channels < 1 || n_channels > 5 || blocksize < 1) {
+		cerr << argv[0] << ": [channels (1..5)] [seconds] [blocksize] [samplerate]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+
+	vector<float>        buf (n_channels * blocksize);
+	vector<float const*> data (n_channels);
+
+	for (auto& s : buf) {
+		s = .5f * (rand () / (float)RAND_MAX - .5f);
+	}
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		data[c] = &buf[c * blocksize];
+	}
+
+	LUFSMeter     meter (sr, n_channels);
+	const int64_t n = seconds * sr;
+
+	Glib::Timer timer;
+	for (int64_t pos = 0; pos < n; pos += blocksize) {
+		meter.run (&data[0], blocksize);
+	}
+	timer.stop ();
+
+	const double elapsed = timer.elapsed ();
+
+	cout << "INFO: " << n_channels << " channels, " << seconds << " sec @ " << sr << " Hz: "
+	     << elapsed << " sec, " << seconds / elapsed << "x realtime"
+	     << " (integrated: " << meter.integrated_loudness () << " LUFS, " << meter.dbtp () << " dBTP)\n";
+
+	ARDOUR::cleanup ();
+	return 0;
+}
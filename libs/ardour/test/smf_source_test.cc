@@ -0,0 +1,148 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <vector>
+
+#include <glibmm/miscutils.h>
+
+#include "evoral/Event.h"
+#include "evoral/EventSink.h"
+
+#include "ardour/midi_cursor.h"
+#include "ardour/midi_model.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/session.h"
+#include "ardour/session_directory.h"
+#include "ardour/smf_source.h"
+#include "ardour/source_factory.h"
+
+#include "smf_source_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SMFSourceTest);
+
+using namespace std;
+using namespace ARDOUR;
+using namespace Temporal;
+
+namespace {
+
+class EventCollector : public Evoral::EventSink<samplepos_t>
+{
+public:
+	uint32_t write (samplepos_t time, Evoral::EventType, uint32_t size, const uint8_t* buf)
+	{
+		events.push_back (make_pair (time, vector<uint8_t> (buf, buf + size)));
+		return size;
+	}
+
+	vector<pair<samplepos_t, vector<uint8_t> > > events;
+};
+
+/* read 16 beats, starting 8 beats into the source, which starts at beat 4 */
+void
+read_range (std::shared_ptr<MidiSource> src, EventCollector& dst)
+{
+	MidiCursor             cursor;
+	set<Evoral::Parameter> filtered;
+
+	Source::ReaderLock lm (src->mutex ());
+	src->midi_read (lm, dst, timepos_t (Beats (4, 0)), timepos_t (Beats (8, 0)), timecnt_t (Beats (16, 0)), 0, cursor, 0, 0, filtered);
+}
+
+} // namespace
+
+void
+SMFSourceTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	std::string const path = Glib::build_filename (_session->session_directory ().midi_path (), "smf_source_test.mid");
+
+	_src = std::dynamic_pointer_cast<SMFSource> (SourceFactory::createWritable (DataType::MIDI, *_session, path, _session->sample_rate ()));
+	CPPUNIT_ASSERT (_src);
+
+	/* one eighth note on every beat */
+	Source::WriterLock lm (_src->mutex ());
+	_src->mark_streaming_midi_write_started (lm, Sustained);
+	for (int i = 0; i < 64; ++i) {
+		uint8_t on[3]  = { 0x90, uint8_t (36 + i), 100 };
+		uint8_t off[3] = { 0x80, uint8_t (36 + i), 0 };
+		_src->append_event_beats (lm, Evoral::Event<Beats> (Evoral::MIDI_EVENT, Beats (i, 0), 3, on));
+		_src->append_event_beats (lm, Evoral::Event<Beats> (Evoral::MIDI_EVENT, Beats (i, Beats::PPQN / 2), 3, off));
+	}
+	_src->mark_streaming_write_completed (lm, timecnt_t (Beats (64, 0)));
+}
+
+void
+SMFSourceTest::tearDown ()
+{
+	_src.reset ();
+	TestNeedingSession::tearDown ();
+}
+
+void
+SMFSourceTest::streamingReadTest ()
+{
+	CPPUNIT_ASSERT (_src->has_model ());
+
+	EventCollector from_model;
+	read_range (_src, from_model);
+
+	CPPUNIT_ASSERT_EQUAL (size_t (32), from_model.events.size ());
+	CPPUNIT_ASSERT_EQUAL (timepos_t (Beats (12, 0)).samples (), from_model.events.front ().first);
+
+	{
+		Source::WriterLock lm (_src->mutex ());
+		_src->destroy_model (lm);
+	}
+	CPPUNIT_ASSERT (!_src->has_model ());
+
+	/* without a model, events are read from the file */
+	EventCollector from_file;
+	read_range (_src, from_file);
+
+	CPPUNIT_ASSERT (from_model.events == from_file.events);
+}
+
+void
+SMFSourceTest::deferredModelTest ()
+{
+	Config->set_defer_midi_model_load (true);
+
+	XMLNode&                   node (_src->get_state ());
+	std::shared_ptr<SMFSource> src (new SMFSource (*_session, node));
+	delete &node;
+
+	/* the source knows about its content, but did not load it */
+	CPPUNIT_ASSERT (!src->has_model ());
+	CPPUNIT_ASSERT_EQUAL (uint64_t (64), src->n_note_on_events ());
+	CPPUNIT_ASSERT (src->length ().beats () >= Beats (64, 0));
+
+	EventCollector from_file;
+	read_range (src, from_file);
+	CPPUNIT_ASSERT (!src->has_model ());
+
+	/* the model is loaded on demand */
+	std::shared_ptr<MidiModel> model = src->model ();
+	CPPUNIT_ASSERT (model);
+	CPPUNIT_ASSERT (src->has_model ());
+	CPPUNIT_ASSERT_EQUAL (size_t (64), model->n_notes ());
+
+	EventCollector from_model;
+	read_range (src, from_model);
+
+	CPPUNIT_ASSERT (from_model.events == from_file.events);
+}
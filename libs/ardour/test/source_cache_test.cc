@@ -0,0 +1,202 @@
+#include <vector>
+
+#include "pbd/id.h"
+
+#include "ardour/source_cache.h"
+
+#include "source_cache_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SourceCacheTest);
+
+using namespace ARDOUR;
+
+namespace {
+
+/** A source whose sample at position p is p, which counts uncached reads */
+struct TestSource {
+	TestSource (samplecnt_t len)
+		: length (len)
+		, reads (0)
+		, offset (0)
+	{}
+
+	samplecnt_t read (Sample* dst, samplepos_t start, samplecnt_t cnt)
+	{
+		++reads;
+		for (samplecnt_t i = 0; i < cnt; ++i) {
+			dst[i] = start + i + offset;
+		}
+		return cnt;
+	}
+
+	SourceCache::Reader reader ()
+	{
+		return [this] (Sample* d, samplepos_t s, samplecnt_t c) { return read (d, s, c); };
+	}
+
+	PBD::ID     id;
+	samplecnt_t length;
+	int         reads;
+	float       offset;
+};
+
+const samplecnt_t   bs          = SourceCache::block_samples;
+const size_t        block_bytes = bs * sizeof (Sample);
+
+samplecnt_t
+cached_read (TestSource& src, std::vector<Sample>& buf, samplepos_t start, samplecnt_t cnt)
+{
+	buf.resize (cnt);
+	return SourceCache::instance ().read (src.id, src.length, src.reader (), &buf[0], start, cnt);
+}
+
+}
+
+void
+SourceCacheTest::setUp ()
+{
+	SourceCache::instance ().clear ();
+}
+
+void
+SourceCacheTest::tearDown ()
+{
+	SourceCache::instance ().set_budget (0);
+	SourceCache::instance ().clear ();
+}
+
+void
+SourceCacheTest::readTest ()
+{
+	SourceCache&        cache (SourceCache::instance ());
+	TestSource          src (3 * bs + 100);
+	std::vector<Sample> buf;
+
+	cache.set_budget (16 * block_bytes);
+
+	/* spanning two blocks */
+	CPPUNIT_ASSERT_EQUAL (bs, cached_read (src, buf, bs / 2, bs));
+	CPPUNIT_ASSERT_EQUAL (2, src.reads);
+	CPPUNIT_ASSERT_EQUAL (2 * block_bytes, cache.used ());
+	for (samplecnt_t i = 0; i < bs; ++i) {
+		CPPUNIT_ASSERT_EQUAL ((Sample)(bs / 2 + i), buf[i]);
+	}
+
+	/* cached */
+	CPPUNIT_ASSERT_EQUAL (bs, cached_read (src, buf, 0, bs));
+	CPPUNIT_ASSERT_EQUAL (2, src.reads);
+	CPPUNIT_ASSERT_EQUAL ((Sample)17, buf[17]);
+
+	/* the last block is shorter */
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t)100, cached_read (src, buf, 3 * bs, 100));
+	CPPUNIT_ASSERT_EQUAL (3, src.reads);
+	CPPUNIT_ASSERT_EQUAL (2 * block_bytes + 100 * sizeof (Sample), cache.used ());
+	CPPUNIT_ASSERT_EQUAL ((Sample)(3 * bs + 99), buf[99]);
+}
+
+void
+SourceCacheTest::lruTest ()
+{
+	SourceCache&        cache (SourceCache::instance ());
+	TestSource          src (8 * bs);
+	std::vector<Sample> buf;
+
+	cache.set_budget (3 * block_bytes);
+
+	cached_read (src, buf, 0, bs);      // block 0
+	cached_read (src, buf, bs, bs);     // block 1
+	cached_read (src, buf, 2 * bs, bs); // block 2
+	CPPUNIT_ASSERT_EQUAL (3, src.reads);
+
+	/* use block 0, so block 1 is the least recently used */
+	cached_read (src, buf, 0, bs);
+	CPPUNIT_ASSERT_EQUAL (3, src.reads);
+
+	/* block 3 evicts block 1 */
+	cached_read (src, buf, 3 * bs, bs);
+	CPPUNIT_ASSERT_EQUAL (4, src.reads);
+	CPPUNIT_ASSERT_EQUAL (3 * block_bytes, cache.used ());
+
+	cached_read (src, buf, 0, bs);
+	cached_read (src, buf, 2 * bs, bs);
+	cached_read (src, buf, 3 * bs, bs);
+	CPPUNIT_ASSERT_EQUAL (4, src.reads);
+
+	cached_read (src, buf, bs, bs);
+	CPPUNIT_ASSERT_EQUAL (5, src.reads);
+}
+
+void
+SourceCacheTest::budgetTest ()
+{
+	SourceCache&        cache (SourceCache::instance ());
+	TestSource          src (8 * bs);
+	std::vector<Sample> buf;
+
+	cache.set_budget (4 * block_bytes);
+	CPPUNIT_ASSERT (cache.enabled ());
+
+	cached_read (src, buf, 0, 8 * bs);
+	CPPUNIT_ASSERT_EQUAL (8, src.reads);
+	CPPUNIT_ASSERT_EQUAL (4 * block_bytes, cache.used ());
+
+	/* the most recently read blocks are retained */
+	cached_read (src, buf, 4 * bs, 4 * bs);
+	CPPUNIT_ASSERT_EQUAL (8, src.reads);
+
+	/* shrinking the budget evicts */
+	cache.set_budget (2 * block_bytes);
+	CPPUNIT_ASSERT_EQUAL (2 * block_bytes, cache.used ());
+
+	/* blocks larger than the budget are not cached */
+	cache.set_budget (block_bytes / 2);
+	CPPUNIT_ASSERT_EQUAL ((size_t)0, cache.used ());
+	cached_read (src, buf, 0, bs);
+	cached_read (src, buf, 0, bs);
+	CPPUNIT_ASSERT_EQUAL (10, src.reads);
+	CPPUNIT_ASSERT_EQUAL ((size_t)0, cache.used ());
+
+	cache.set_budget (0);
+	CPPUNIT_ASSERT (!cache.enabled ());
+	CPPUNIT_ASSERT_EQUAL ((size_t)0, cache.used ());
+}
+
+void
+SourceCacheTest::dropTest ()
+{
+	SourceCache&        cache (SourceCache::instance ());
+	TestSource          src (2 * bs);
+	TestSource          other (bs);
+	std::vector<Sample> buf;
+
+	cache.set_budget (16 * block_bytes);
+
+	cached_read (src, buf, 0, 2 * bs);
+	cached_read (other, buf, 0, bs);
+	CPPUNIT_ASSERT_EQUAL (3 * block_bytes, cache.used ());
+
+	/* only data of the given source is dropped */
+	cache.drop (src.id);
+	CPPUNIT_ASSERT_EQUAL (block_bytes, cache.used ());
+
+	src.offset = 1;
+	cached_read (src, buf, 0, bs);
+	CPPUNIT_ASSERT_EQUAL (3, src.reads);
+	CPPUNIT_ASSERT_EQUAL ((Sample)1, buf[0]);
+
+	/* a drop while a block is read (e.g. a gain change) discards it */
+	TestSource racy (bs);
+	SourceCache::Reader r = [&] (Sample* d, samplepos_t s, samplecnt_t c) {
+		samplecnt_t rv = racy.read (d, s, c);
+		racy.offset = 2;
+		cache.drop (racy.id);
+		return rv;
+	};
+
+	buf.resize (bs);
+	CPPUNIT_ASSERT_EQUAL (bs, cache.read (racy.id, racy.length, r, &buf[0], 0, bs));
+	/* the stale block was not cached, and was read again */
+	CPPUNIT_ASSERT_EQUAL (2, racy.reads);
+	CPPUNIT_ASSERT_EQUAL ((Sample)2, buf[0]);
+	CPPUNIT_ASSERT_EQUAL (2 * block_bytes, cache.used ());
+}
@@ -0,0 +1,21 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class SourceCacheTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (SourceCacheTest);
+	CPPUNIT_TEST (readTest);
+	CPPUNIT_TEST (lruTest);
+	CPPUNIT_TEST (budgetTest);
+	CPPUNIT_TEST (dropTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void readTest ();
+	void lruTest ();
+	void budgetTest ();
+	void dropTest ();
+};
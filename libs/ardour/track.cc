@@ -621,6 +621,12 @@ Track::do_refill ()
 	return _disk_reader->do_refill ();
 }
 
+void
+Track::prefetch (ReadAhead& ra)
+{
+	_disk_reader->prefetch (ra);
+}
+
 int
 Track::do_flush (RunContext c, bool force)
 {
@@ -18,7 +18,10 @@
  */
 
 #include <math.h>
+#include <algorithm>
+
 #include "ardour/vumeterdsp.h"
+#include "ardour/runtime_functions.h"
 
 
 float Vumeterdsp::_w;
@@ -72,6 +75,40 @@ void Vumeterdsp::process (float const *p, int n)
 }
 
 
+void Vumeterdsp::process (Vumeterdsp* const* m, float const* const* p, uint32_t n_meters, int n)
+{
+    for (uint32_t c = 0; c < n_meters; c += 4)
+    {
+	// Unused lanes repeat the last meter.
+	const uint32_t last = std::min (c + 3, n_meters - 1);
+
+	float const *buf[4];
+	float z1[4], z2[4], mx[4];
+
+	for (uint32_t l = 0; l < 4; ++l)
+	{
+	    const uint32_t i = std::min (c + l, last);
+	    Vumeterdsp const *k = m[i];
+	    buf[l] = p[i];
+	    z1[l] = k->_z1 > 20 ? 20 : (k->_z1 < -20 ? -20 : k->_z1);
+	    z2[l] = k->_z2 > 20 ? 20 : (k->_z2 < -20 ? -20 : k->_z2);
+	    mx[l] = k->_res ? 0 : k->_m;
+	}
+
+	ARDOUR::vumeter_process (buf, z1, z2, mx, n & ~3, _w);
+
+	for (uint32_t i = c; i <= last; ++i)
+	{
+	    Vumeterdsp *k = m[i];
+	    k->_z1 = isnan (z1[i - c]) ? 0 : z1[i - c];
+	    k->_z2 = (isnan (z2[i - c]) ? 0 : z2[i - c]) + 1e-10f;
+	    k->_m = mx[i - c];
+	    k->_res = false;
+	}
+    }
+}
+
+
 float Vumeterdsp::read (void)
 {
     _res = true;
@@ -1146,4 +1146,47 @@ x86_avx512f_copy_vector(float *dst, const float *src, uint32_t nframes)
 	_mm256_zeroupper(); // zeros the upper portion of YMM register
 }
 
+/**
+ * @brief x86-64 AVX-512F optimized FIR kernel for ArdourZita::VMResampler
+ *
+ * @see x86_sse_resample_filter
+ */
+float
+x86_avx512f_resample_filter(const float *p1, const float *p2, const float *q1, const float *q2, float a, float b, uint32_t hl)
+{
+	const int n = hl;
+	int i = 0;
+
+	const __m512i rev = _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+	__m512 va  = _mm512_set1_ps(a);
+	__m512 vb  = _mm512_set1_ps(b);
+	// bias each lane to avoid denormals, as the scalar kernel does
+	__m512 acc = _mm512_set1_ps(1e-25f);
+
+	for (; i + 16 <= n; i += 16) {
+		__m512 c1 = _mm512_fmadd_ps(va, _mm512_loadu_ps(q1 + i), _mm512_mul_ps(vb, _mm512_loadu_ps(q1 + i + n)));
+		__m512 c2 = _mm512_fmadd_ps(va, _mm512_loadu_ps(q2 + i), _mm512_mul_ps(vb, _mm512_loadu_ps(q2 + i - n)));
+
+		__m512 x1 = _mm512_loadu_ps(p1 + i);
+		// p2 is read backwards
+		__m512 x2 = _mm512_permutexvar_ps(rev, _mm512_loadu_ps(p2 - i - 16));
+
+		acc = _mm512_fmadd_ps(x1, c1, acc);
+		acc = _mm512_fmadd_ps(x2, c2, acc);
+	}
+
+	float s = _mm512_reduce_add_ps(acc);
+
+	for (; i < n; ++i) {
+		const float c1 = a * q1[i] + b * q1[i + n];
+		const float c2 = a * q2[i] + b * q2[i - n];
+		s += p1[i] * c1 + p2[-i - 1] * c2;
+	}
+
+	_mm256_zeroupper();
+
+	return s - 16 * 1e-25f;
+}
+
 #endif // FPU_AVX512F_SUPPORT
@@ -138,4 +138,59 @@ x86_fma_mix_buffers_with_gain(
 	} while (0);
 }
 
+/**
+ * @brief x86-64 AVX/FMA optimized FIR kernel for ArdourZita::VMResampler
+ *
+ * @see x86_sse_resample_filter
+ */
+float
+x86_fma_resample_filter(
+    const float *p1,
+    const float *p2,
+    const float *q1,
+    const float *q2,
+    float a,
+    float b,
+    uint32_t hl)
+{
+	const int n = hl;
+	int i = 0;
+
+	__m256 va  = _mm256_set1_ps(a);
+	__m256 vb  = _mm256_set1_ps(b);
+	// bias each lane to avoid denormals, as the scalar kernel does
+	__m256 acc = _mm256_set1_ps(1e-25f);
+
+	for (; i + 8 <= n; i += 8) {
+		__m256 c1 = _mm256_fmadd_ps(va, _mm256_loadu_ps(q1 + i), _mm256_mul_ps(vb, _mm256_loadu_ps(q1 + i + n)));
+		__m256 c2 = _mm256_fmadd_ps(va, _mm256_loadu_ps(q2 + i), _mm256_mul_ps(vb, _mm256_loadu_ps(q2 + i - n)));
+
+		__m256 x1 = _mm256_loadu_ps(p1 + i);
+		// p2 is read backwards: reverse within each lane, then swap lanes
+		__m256 x2 = _mm256_loadu_ps(p2 - i - 8);
+		x2 = _mm256_permute_ps(x2, _MM_SHUFFLE(0, 1, 2, 3));
+		x2 = _mm256_permute2f128_ps(x2, x2, 0x01);
+
+		acc = _mm256_fmadd_ps(x1, c1, acc);
+		acc = _mm256_fmadd_ps(x2, c2, acc);
+	}
+
+	// Horizontal sum
+	__m128 s0 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+	s0 = _mm_add_ps(s0, _mm_movehl_ps(s0, s0));
+	s0 = _mm_add_ss(s0, _mm_shuffle_ps(s0, s0, _MM_SHUFFLE(1, 1, 1, 1)));
+
+	float s = _mm_cvtss_f32(s0);
+
+	for (; i < n; ++i) {
+		const float c1 = a * q1[i] + b * q1[i + n];
+		const float c2 = a * q2[i] + b * q2[i - n];
+		s += p1[i] * c1 + p2[-i - 1] * c2;
+	}
+
+	_mm256_zeroupper();
+
+	return s - 8 * 1e-25f;
+}
+
 #endif // FPU_AVX_FMA_SUPPORT
@@ -21,6 +21,7 @@
 
 #include <vector>
 
+#include <glibmm/threads.h>
 #include <vamp-hostsdk/PluginLoader.h>
 
 #include "audiographer/visibility.h"
@@ -46,6 +47,11 @@ class LIBAUDIOGRAPHER_API LoudnessReader : public ListedSource<float>, public Si
 
 	using Sink<float>::process;
 
+	/** The Vamp plugin loader is not thread-safe. Plugins must be
+	 * loaded, initialized and deleted with this lock held.
+	 */
+	static Glib::Threads::Mutex& vamp_lock ();
+
   protected:
 	Vamp::Plugin*              _ebur_plugin;
 	std::vector<Vamp::Plugin*> _dbtp_plugins;
@@ -36,6 +36,8 @@ LoudnessReader::LoudnessReader (float sample_rate, unsigned int channels, sample
 	assert (bufsize > 1);
 	assert (_bufsize > 0);
 
+	Glib::Threads::Mutex::Lock lm (vamp_lock ());
+
 	if (channels > 0 && channels <= 2) {
 		using namespace Vamp::HostExt;
 		PluginLoader* loader (PluginLoader::getInstance ());
@@ -72,15 +74,25 @@ LoudnessReader::LoudnessReader (float sample_rate, unsigned int channels, sample
 
 LoudnessReader::~LoudnessReader ()
 {
-	delete _ebur_plugin;
-	while (!_dbtp_plugins.empty()) {
-		delete _dbtp_plugins.back();
-		_dbtp_plugins.pop_back();
+	{
+		Glib::Threads::Mutex::Lock lm (vamp_lock ());
+		delete _ebur_plugin;
+		while (!_dbtp_plugins.empty()) {
+			delete _dbtp_plugins.back();
+			_dbtp_plugins.pop_back();
+		}
 	}
 	free (_bufs[0]);
 	free (_bufs[1]);
 }
 
+Glib::Threads::Mutex&
+LoudnessReader::vamp_lock ()
+{
+	static Glib::Threads::Mutex lock;
+	return lock;
+}
+
 void
 LoudnessReader::reset ()
 {
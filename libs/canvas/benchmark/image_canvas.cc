@@ -0,0 +1,76 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <pango/pangocairo.h>
+#include <pangomm/context.h>
+
+#include "image_canvas.h"
+
+using namespace std;
+using namespace ArdourCanvas;
+
+ImageCanvas::ImageCanvas (Duple size)
+	: _surface (Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, size.x, size.y))
+{
+	_context = Cairo::Context::create (_surface);
+}
+
+void
+ImageCanvas::render_to_image (Rect const & area) const
+{
+	render (area, _context);
+}
+
+void
+ImageCanvas::write_to_png (string const & filename)
+{
+	_surface->write_to_png (filename);
+}
+
+void
+ImageCanvas::request_redraw (Rect const &)
+{
+	/* there is no expose to wait for. Cached content of changed
+	 * items was already invalidated by request_item_redraw().
+	 */
+}
+
+Rect
+ImageCanvas::visible_area () const
+{
+	return Rect (0, 0, width (), height ());
+}
+
+Coord
+ImageCanvas::width () const
+{
+	return _surface->get_width ();
+}
+
+Coord
+ImageCanvas::height () const
+{
+	return _surface->get_height ();
+}
+
+Glib::RefPtr<Pango::Context>
+ImageCanvas::get_pango_context ()
+{
+	if (!_pango_context) {
+		_pango_context = Glib::wrap (pango_font_map_create_context (pango_cairo_font_map_get_default ()));
+	}
+	return _pango_context;
+}
@@ -0,0 +1,64 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cairomm/surface.h>
+
+#include "canvas/canvas.h"
+
+namespace ArdourCanvas {
+
+/** A canvas without a window, which renders into an image surface.
+ *  Used by the benchmarks.
+ */
+class ImageCanvas : public Canvas
+{
+public:
+	ImageCanvas (Duple size = Duple (1920, 1080));
+
+	/** Render @param area (in WINDOW coordinates) into the image */
+	void render_to_image (Rect const & area) const;
+	void write_to_png (std::string const & filename);
+
+	void request_redraw (Rect const &);
+	void request_size (Duple) {}
+	void grab (Item *) {}
+	void ungrab () {}
+	void queue_resize () {}
+	void focus (Item *) {}
+	void unfocus (Item *) {}
+	void re_enter () {}
+
+	Rect  visible_area () const;
+	Coord width () const;
+	Coord height () const;
+
+	bool get_mouse_position (Duple&) const { return false; }
+
+	Glib::RefPtr<Pango::Context> get_pango_context ();
+
+protected:
+	void pick_current_item (int) {}
+	void pick_current_item (Duple const &, int) {}
+
+private:
+	Cairo::RefPtr<Cairo::ImageSurface> _surface;
+	Cairo::RefPtr<Cairo::Context>      _context;
+	Glib::RefPtr<Pango::Context>       _pango_context;
+};
+
+}
@@ -1,32 +1,45 @@
 #include <sys/time.h>
-#include "canvas/group.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
 #include "canvas/canvas.h"
-#include "canvas/root_group.h"
+#include "canvas/container.h"
+#include "canvas/lookup_table.h"
 #include "canvas/rectangle.h"
 #include "benchmark.h"
+#include "image_canvas.h"
 
 using namespace std;
 using namespace ArdourCanvas;
 
+/* @param spatial use a SpatialLookupTable (otherwise DumbLookupTable)
+ * @param n_moves number of items to move between lookups
+ */
 static void
-test (int items_per_cell)
+test (bool spatial, int n_moves)
 {
-	Group::default_items_per_cell = items_per_cell;
+	Item::spatial_lookup_threshold = spatial ? 64 : SIZE_MAX;
 
-	int const n_rectangles = 10000;
+	int const n_rectangles = 50000;
 	int const n_tests = 1000;
-	double const rough_size = 1000;
+	double const rough_size = 10000;
 	srand (1);
 
 	ImageCanvas canvas;
+	Container* group = new Container (canvas.root());
 
-	list<Item*> rectangles;
+	vector<Rectangle*> rectangles;
 
 	for (int i = 0; i < n_rectangles; ++i) {
-		rectangles.push_back (new Rectangle (canvas.root(), rect_random (rough_size)));
+		rectangles.push_back (new Rectangle (group, rect_random (rough_size)));
 	}
 
 	for (int i = 0; i < n_tests; ++i) {
+		for (int m = 0; m < n_moves; ++m) {
+			Rectangle* r = rectangles[rand () % n_rectangles];
+			r->move (Duple (double_random () * 10 - 5, double_random () * 10 - 5));
+		}
+
 		Duple test (double_random() * rough_size, double_random() * rough_size);
 
 		/* ask the group what's at this point */
@@ -37,26 +50,27 @@ test (int items_per_cell)
 
 int main ()
 {
-	int tests[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+	int moves[] = { 0, 1, 16, 256 };
 
-	for (unsigned int i = 0; i < sizeof (tests) / sizeof (int); ++i) {
-		timeval start;
-		timeval stop;
+	for (unsigned int i = 0; i < sizeof (moves) / sizeof (int); ++i) {
+		for (int spatial = 0; spatial < 2; ++spatial) {
+			timeval start;
+			timeval stop;
 
-		gettimeofday (&start, 0);
-		test (tests[i]);
-		gettimeofday (&stop, 0);
+			gettimeofday (&start, 0);
+			test (spatial, moves[i]);
+			gettimeofday (&stop, 0);
 
-		int sec = stop.tv_sec - start.tv_sec;
-		int usec = stop.tv_usec - start.tv_usec;
-		if (usec < 0) {
-			--sec;
-			usec += 1e6;
-		}
+			int sec = stop.tv_sec - start.tv_sec;
+			int usec = stop.tv_usec - start.tv_usec;
+			if (usec < 0) {
+				--sec;
+				usec += 1e6;
+			}
 
-		double seconds = sec + ((double) usec / 1e6);
+			double seconds = sec + ((double) usec / 1e6);
 
-		cout << "Test " << tests[i] << ": " << seconds << "\n";
+			cout << (spatial ? "Spatial" : "Dumb") << " LUT, " << moves[i] << " moves per lookup: " << seconds << "\n";
+		}
 	}
 }
-
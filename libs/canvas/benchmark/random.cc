@@ -0,0 +1,38 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstdlib>
+
+#include "canvas/types.h"
+#include "benchmark.h"
+
+using namespace ArdourCanvas;
+
+double
+double_random ()
+{
+	return ((double) rand() / RAND_MAX);
+}
+
+Rect
+rect_random (double rough_size)
+{
+	double const x = double_random () * rough_size / 2;
+	double const y = double_random () * rough_size / 2;
+	double const w = double_random () * rough_size / 2;
+	double const h = double_random () * rough_size / 2;
+	return Rect (x, y, x + w, y + h);
+}
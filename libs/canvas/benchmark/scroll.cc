@@ -0,0 +1,90 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <sys/time.h>
+#include <iostream>
+#include <pangomm/init.h>
+#include "canvas/canvas.h"
+#include "canvas/rectangle.h"
+#include "canvas/scroll_group.h"
+#include "benchmark.h"
+#include "image_canvas.h"
+
+using namespace std;
+using namespace ArdourCanvas;
+
+/* Scroll horizontally across a canvas full of rectangles, and render
+ * the whole window after each step; as an expose event would after
+ * ScrollGroup::scroll_to().
+ */
+static double
+test (bool tile_cache, int step)
+{
+	int const n_rectangles = 50000;
+	int const n_steps = 500;
+	double const rough_size = 20000;
+	srand (1);
+
+	ImageCanvas canvas;
+
+	ScrollGroup* sg = new ScrollGroup (canvas.root(), ScrollGroup::ScrollSensitivity (ScrollGroup::ScrollsVertically | ScrollGroup::ScrollsHorizontally));
+	canvas.add_scroller (*sg);
+	sg->set_tile_cache (tile_cache);
+
+	for (int i = 0; i < n_rectangles; ++i) {
+		Rectangle* r = new Rectangle (sg, rect_random (rough_size));
+		r->set_fill_color (0x4080c0ff);
+		r->set_outline_color (0x000000ff);
+	}
+
+	timeval start;
+	timeval stop;
+
+	gettimeofday (&start, 0);
+
+	for (int i = 0; i < n_steps; ++i) {
+		canvas.scroll_to (i * step, 0);
+		canvas.render_to_image (Rect (0, 0, 1920, 1080));
+	}
+
+	gettimeofday (&stop, 0);
+
+	int sec = stop.tv_sec - start.tv_sec;
+	int usec = stop.tv_usec - start.tv_usec;
+	if (usec < 0) {
+		--sec;
+		usec += 1e6;
+	}
+
+	cout << "  tiles rendered: " << sg->tiles_rendered () << " updated: " << sg->tiles_updated () << " reused: " << sg->tiles_reused () << "\n";
+
+	return sec + ((double) usec / 1e6);
+}
+
+int main ()
+{
+	Pango::init ();
+
+	int steps[] = { 1, 8, 32, 128 };
+
+	for (unsigned int i = 0; i < sizeof (steps) / sizeof (int); ++i) {
+		double const direct = test (false, steps[i]);
+		double const tiled  = test (true, steps[i]);
+		cout << "Scroll step " << steps[i] << "px: direct " << direct << " tiled " << tiled << "\n";
+	}
+
+	return 0;
+}
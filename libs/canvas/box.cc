@@ -444,7 +444,7 @@ Box::layout ()
 }
 
 void
-Box::child_changed (bool bbox_changed)
+Box::child_changed (bool bbox_changed, Item* child)
 {
 	/* catch visibility and size changes */
 
@@ -452,7 +452,7 @@ Box::child_changed (bool bbox_changed)
 		return;
 	}
 
-	Item::child_changed (bbox_changed);
+	Item::child_changed (bbox_changed, child);
 
 	reposition_children (_allocation.width(), _allocation.height(), false, false);
 }
@@ -60,6 +60,7 @@ Canvas::Canvas ()
 	, _queue_draw_frozen (0)
 	, _bg_color (Gtkmm2ext::rgba_to_color (0, 1.0, 0.0, 1.0))
 	, _debug_render (false)
+	, _scrolling (false)
 	, _last_render_start_timestamp(0)
 	, _use_intermediate_surface (false)
 {
@@ -100,10 +101,15 @@ Canvas::scroll_to (Coord x, Coord y)
 	   becomes O(1) rather than O(N).
 	*/
 
+	/* Scrolling only moves content, cached tiles remain valid */
+	_scrolling = true;
+
 	for (list<ScrollGroup*>::iterator i = scrollers.begin(); i != scrollers.end(); ++i) {
 		(*i)->scroll_to (Duple (x, y));
 	}
 
+	_scrolling = false;
+
 	pick_current_item (0); // no current mouse position
 }
 
@@ -113,6 +119,50 @@ Canvas::add_scroller (ScrollGroup& i)
 	scrollers.push_back (&i);
 }
 
+void
+Canvas::invalidate_cached_area (Rect const & area)
+{
+	if (_scrolling || !area) {
+		return;
+	}
+
+	for (list<ScrollGroup*>::iterator i = scrollers.begin(); i != scrollers.end(); ++i) {
+		(*i)->invalidate_tiles (area);
+	}
+}
+
+void
+Canvas::invalidate_cached_area (Item const * item, Rect const & area)
+{
+	if (_scrolling || !area || !item) {
+		return;
+	}
+
+	for (list<ScrollGroup*>::iterator i = scrollers.begin(); i != scrollers.end(); ++i) {
+		/* damage caused by items outside of a scroll group (e.g. the
+		 * playhead in a different group) does not change its content.
+		 */
+		if (item == *i || item->is_descendant_of (**i) || (*i)->is_descendant_of (*item)) {
+			(*i)->invalidate_tiles (area);
+		}
+	}
+}
+
+void
+Canvas::request_item_redraw (Item const * item, Rect const & area)
+{
+	invalidate_cached_area (item, area);
+	request_redraw (area);
+}
+
+void
+Canvas::invalidate_cached_area ()
+{
+	for (list<ScrollGroup*>::iterator i = scrollers.begin(); i != scrollers.end(); ++i) {
+		(*i)->invalidate_all_tiles ();
+	}
+}
+
 void
 Canvas::zoomed ()
 {
@@ -283,7 +333,9 @@ Canvas::item_shown_or_hidden (Item* item)
 	Rect bbox = item->bounding_box ();
 	if (bbox) {
 		if (_queue_draw_frozen) {
-			frozen_area = frozen_area.extend (compute_draw_item_area (item, bbox));
+			Rect const r = compute_draw_item_area (item, bbox);
+			frozen_area = frozen_area.extend (r);
+			invalidate_cached_area (item, r);
 			return;
 		}
 
@@ -465,7 +517,7 @@ Canvas::item_moved (Item* item, Rect pre_change_parent_bounding_box)
 void
 Canvas::queue_draw_item_area (Item* item, Rect area)
 {
-	request_redraw (compute_draw_item_area (item, area));
+	request_item_redraw (item, compute_draw_item_area (item, area));
 }
 
 Rect
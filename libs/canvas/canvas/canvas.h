@@ -138,6 +138,28 @@ public:
 	void scroll_to (Coord x, Coord y);
 	void add_scroller (ScrollGroup& i);
 
+	/** Request a redraw of @param area (in WINDOW coordinates) because
+	 *  @param item changed. Cached content is only discarded in scroll
+	 *  groups that contain the item.
+	 */
+	void request_item_redraw (Item const *, Rect const & area);
+
+	/** Discard cached content of all scroll groups that overlaps
+	 *  @param area (in WINDOW coordinates). This is called whenever
+	 *  an area needs to be re-rendered rather than just re-drawn.
+	 */
+	void invalidate_cached_area (Rect const &);
+	/** Discard cached content overlapping @param area (in WINDOW
+	 *  coordinates) of scroll groups that render @param item .
+	 */
+	void invalidate_cached_area (Item const *, Rect const &);
+	/** Discard all cached content of all scroll groups. Redraws that are
+	 *  not caused by an item change (request_redraw(), queue_draw())
+	 *  do not discard cached content, call this when content changed
+	 *  without notifying the canvas.
+	 */
+	void invalidate_cached_area ();
+
 	virtual Rect  visible_area () const = 0;
 	virtual Coord width () const = 0;
 	virtual Coord height () const = 0;
@@ -197,6 +219,7 @@ protected:
 	Rect              frozen_area;
 	Gtkmm2ext::Color _bg_color;
 	bool             _debug_render;
+	bool             _scrolling;
 
 	mutable gint64 _last_render_start_timestamp;
 
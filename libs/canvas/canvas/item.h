@@ -237,12 +237,14 @@ public:
 	void raise_child_to_top (Item *);
 	void raise_child (Item *, int);
 	void lower_child_to_bottom (Item *);
-	virtual void child_changed (bool bbox_changed);
+	virtual void child_changed (bool bbox_changed, Item* child);
 
 	PackOptions pack_options () const { return _pack_options; }
 	void set_pack_options (PackOptions);
 
 	static int default_items_per_cell;
+	/** containers with at least this many children use a SpatialLookupTable */
+	static size_t spatial_lookup_threshold;
 
 
 	/* This is a sigc++ signal because it is solely
@@ -20,7 +20,9 @@
 #ifndef __CANVAS_LOOKUP_TABLE_H__
 #define __CANVAS_LOOKUP_TABLE_H__
 
+#include <map>
 #include <vector>
+#include <stdint.h>
 #include <boost/multi_array.hpp>
 
 #include "canvas/visibility.h"
@@ -42,6 +44,17 @@ public:
     virtual std::vector<Item*> items_at_point (Duple const &) const = 0;
     virtual bool has_item_at_point (Duple const & point) const = 0;
 
+    /* Incremental updates. These return false if the table cannot
+     * be updated in place, and needs to be re-created.
+     */
+
+    /** @param child item that was added to the owning item's list */
+    virtual bool add (Item* /*child*/, bool /*front*/) { return false; }
+    /** @param child item that was removed from the owning item's list */
+    virtual bool remove (Item* /*child*/) { return false; }
+    /** @param child item that moved or changed its bounding box */
+    virtual bool update (Item* /*child*/) { return false; }
+
 protected:
 
     Item const & _item;
@@ -84,6 +97,80 @@ public:
     bool _added;
 };
 
+/** A hierarchical (quadtree) index of the owning item's children.
+ *
+ * Each child is stored in the smallest node that entirely contains its
+ * bounding box (in the owning item's coordinates). Moving or resizing a
+ * child only re-inserts that child, rather than rebuilding the table.
+ */
+class LIBCANVAS_API SpatialLookupTable : public LookupTable
+{
+public:
+	SpatialLookupTable (Item const &);
+	~SpatialLookupTable ();
+
+	std::vector<Item*> get (Rect const &);
+	std::vector<Item*> items_at_point (Duple const &) const;
+	bool has_item_at_point (Duple const & point) const;
+
+	bool add (Item*, bool front);
+	bool remove (Item*);
+	bool update (Item*);
+
+	/** max number of items in a leaf node before it is split */
+	static size_t node_capacity;
+	/** max depth of the tree */
+	static int max_depth;
+
+private:
+	struct Node;
+
+	struct Entry {
+		Entry (Item* i, int64_t o) : item (i), order (o), bucket (0), index (0) {}
+		Item*                item;
+		Rect                 bbox;   /* in the owning item's coordinates */
+		int64_t              order;  /* stacking order */
+		std::vector<Entry*>* bucket; /* node, _outside or _pending */
+		size_t               index;  /* in bucket */
+	};
+
+	struct Node {
+		Node (Rect const & b, int d) : bounds (b), depth (d) { children[0] = children[1] = children[2] = children[3] = 0; }
+		~Node () { for (int i = 0; i < 4; ++i) { delete children[i]; } }
+		Rect                bounds;
+		int                 depth;
+		std::vector<Entry*> entries;
+		Node*               children[4];
+		bool is_leaf () const { return children[0] == 0; }
+	};
+
+	typedef std::map<Item const*, Entry*> EntryMap;
+
+	Node*               _root;
+	EntryMap            _entries;
+	std::vector<Entry*> _outside;
+	std::vector<Entry*> _pending;
+	int64_t             _front_order;
+	int64_t             _back_order;
+
+	Rect item_bbox (Item const*) const;
+	Rect window_to_table (Rect const &) const;
+	Duple window_to_table (Duple const &) const;
+
+	void insert (Entry*);
+	void insert (Node*, Entry*);
+	void link (std::vector<Entry*>&, Entry*);
+	void unlink (Entry*);
+	void flush_pending ();
+	bool need_rebuild () const;
+	void split (Node*);
+	int  quadrant (Node const*, Rect const &) const;
+
+	void query (Node const*, Rect const &, std::vector<Entry*>&) const;
+	std::vector<Item*> sorted_items (std::vector<Entry*>&) const;
+	static bool order_sort (Entry const*, Entry const*);
+};
+
 }
 
 #endif
@@ -20,6 +20,8 @@
 #ifndef __CANVAS_SCROLL_GROUP_H__
 #define __CANVAS_SCROLL_GROUP_H__
 
+#include <map>
+
 #include "canvas/container.h"
 
 namespace ArdourCanvas {
@@ -49,9 +51,52 @@ class LIBCANVAS_API ScrollGroup : public Container
 
 	ScrollSensitivity sensitivity() const { return _scroll_sensitivity; }
 
+	/** Retain rendered content in tiles (aligned to canvas coordinates).
+	 *  When scrolling, only newly exposed areas need to be rendered,
+	 *  the rest is copied from the cache. Changes of items inside this
+	 *  group mark the affected part of a tile dirty, and only that part
+	 *  is re-rendered (see Canvas::request_item_redraw()).
+	 */
+	void set_tile_cache (bool yn);
+	bool tile_cache () const { return _tile_cache; }
+
+	/** @param area Area to invalidate, in window coordinates */
+	void invalidate_tiles (Rect const & area);
+	void invalidate_all_tiles ();
+
+	uint64_t tiles_rendered () const { return _tiles_rendered; }
+	uint64_t tiles_updated () const { return _tiles_updated; }
+	uint64_t tiles_reused () const { return _tiles_reused; }
+
+	static int      tile_size;
+	static uint32_t max_tiles;
+
   private:
 	ScrollSensitivity _scroll_sensitivity;
 	Duple             _scroll_offset;
+
+	struct Tile {
+		Tile () : valid (false), last_used (0) {}
+		Cairo::RefPtr<Cairo::Surface> surface;
+		bool     valid;
+		Rect     dirty; ///< area to re-render, in canvas coordinates
+		uint64_t last_used;
+	};
+
+	typedef std::pair<int64_t, int64_t> TileIndex;
+	typedef std::map<TileIndex, Tile>   Tiles;
+
+	bool             _tile_cache;
+	mutable Tiles    _tiles;
+	mutable uint64_t _tile_clock;
+	mutable uint64_t _tiles_rendered;
+	mutable uint64_t _tiles_updated;
+	mutable uint64_t _tiles_reused;
+
+	Rect tile_window_rect (TileIndex const&) const;
+	void render_tile (Tile&, Rect const & tile_area, Rect const & area, Cairo::RefPtr<Cairo::Context>) const;
+	void render_tiled (Rect const & area, Cairo::RefPtr<Cairo::Context>) const;
+	void evict_tiles () const;
 };
 
 }
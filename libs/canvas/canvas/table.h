@@ -88,7 +88,7 @@ public:
 	void set_col_size (uint32_t row, Distance);
 
   protected:
-	void child_changed (bool bbox_changed);
+	void child_changed (bool bbox_changed, Item* child);
 
   private:
 	FourDimensions padding;
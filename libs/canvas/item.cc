@@ -34,6 +34,7 @@ using namespace PBD;
 using namespace ArdourCanvas;
 
 int Item::default_items_per_cell = 64;
+size_t Item::spatial_lookup_threshold = 64;
 
 Item::Item (Canvas* canvas)
 	: Fill (*this)
@@ -301,7 +302,7 @@ Item::set_position (Duple p)
 		_canvas->item_moved (this, pre_change_parent_bounding_box);
 
 		if (_parent) {
-			_parent->child_changed (true);
+			_parent->child_changed (true, this);
 		}
 	}
 }
@@ -411,7 +412,7 @@ Item::propagate_show_hide ()
 	/* bounding box may have changed while we were hidden */
 
 	if (_parent) {
-		_parent->child_changed (true);
+		_parent->child_changed (true, this);
 	}
 
 	_canvas->item_shown_or_hidden (this);
@@ -745,7 +746,7 @@ void
 Item::redraw () const
 {
 	if (visible() && _bounding_box && _canvas) {
-		_canvas->request_redraw (item_to_window (_bounding_box, false));
+		_canvas->request_item_redraw (this, item_to_window (_bounding_box, false));
 	}
 
 }
@@ -769,7 +770,7 @@ Item::end_change ()
 		_canvas->item_changed (this, _pre_change_bounding_box);
 
 		if (_parent) {
-			_parent->child_changed (_pre_change_bounding_box != _bounding_box);
+			_parent->child_changed (_pre_change_bounding_box != _bounding_box, this);
 		}
 	}
 }
@@ -1063,7 +1064,9 @@ Item::add (Item* i)
 
 	_items.push_back (i);
 	i->reparent (this, true);
-	invalidate_lut ();
+	if (!_lut || !_lut->add (i, false)) {
+		invalidate_lut ();
+	}
 	set_bbox_dirty ();
 }
 
@@ -1074,7 +1077,9 @@ Item::add_front (Item* i)
 
 	_items.push_front (i);
 	i->reparent (this, true);
-	invalidate_lut ();
+	if (!_lut || !_lut->add (i, true)) {
+		invalidate_lut ();
+	}
 	set_bbox_dirty();
 }
 
@@ -1101,7 +1106,9 @@ Item::remove (Item* i)
 	i->unparent ();
 	i->set_layout_sensitive (false);
 	_items.remove (i);
-	invalidate_lut ();
+	if (!_lut || !_lut->remove (i)) {
+		invalidate_lut ();
+	}
 	set_bbox_dirty ();
 
 	end_change ();
@@ -1157,7 +1164,9 @@ Item::raise_child_to_top (Item* i)
 	_items.remove (i);
 	_items.push_back (i);
 
-	invalidate_lut ();
+	if (!_lut || !_lut->remove (i) || !_lut->add (i, false)) {
+		invalidate_lut ();
+	}
         redraw ();
 }
 
@@ -1190,7 +1199,9 @@ Item::lower_child_to_bottom (Item* i)
 	}
 	_items.remove (i);
 	_items.push_front (i);
-	invalidate_lut ();
+	if (!_lut || !_lut->remove (i) || !_lut->add (i, true)) {
+		invalidate_lut ();
+	}
         redraw ();
 }
 
@@ -1198,7 +1209,11 @@ void
 Item::ensure_lut () const
 {
 	if (!_lut) {
-		_lut = new DumbLookupTable (*this);
+		if (_items.size () >= spatial_lookup_threshold) {
+			_lut = new SpatialLookupTable (*this);
+		} else {
+			_lut = new DumbLookupTable (*this);
+		}
 	}
 }
 
@@ -1210,16 +1225,18 @@ Item::invalidate_lut () const
 }
 
 void
-Item::child_changed (bool bbox_changed)
+Item::child_changed (bool bbox_changed, Item* child)
 {
-	invalidate_lut ();
+	if (!_lut || !_lut->update (child)) {
+		invalidate_lut ();
+	}
 
 	if (bbox_changed) {
 		set_bbox_dirty ();
 	}
 
 	if (!change_blocked && _parent) {
-		_parent->child_changed (bbox_changed);
+		_parent->child_changed (bbox_changed, this);
 	}
 }
 
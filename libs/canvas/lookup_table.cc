@@ -18,6 +18,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cassert>
+
 #include "canvas/item.h"
 #include "canvas/lookup_table.h"
 
@@ -321,3 +324,377 @@ OptimizingLookupTable::get (Rect const & area)
 	return vitems;
 }
 
+
+size_t SpatialLookupTable::node_capacity = 16;
+int    SpatialLookupTable::max_depth = 16;
+
+SpatialLookupTable::SpatialLookupTable (Item const & item)
+	: LookupTable (item)
+	, _root (0)
+	, _front_order (-1)
+	, _back_order (0)
+{
+	/* our item's bounding box in its coordinates, leave some
+	 * room for children to move before they end up outside.
+	 */
+	Rect bbox = _item.bounding_box ();
+	if (bbox) {
+		Distance const margin = max (bbox.width (), bbox.height ()) * .25 + 1.0;
+		_root = new Node (bbox.expand (margin), 0);
+	}
+
+	for (auto const & child : _item.items()) {
+		Entry* e = new Entry (child, _back_order++);
+		_entries.insert (make_pair (child, e));
+		insert (e);
+	}
+}
+
+SpatialLookupTable::~SpatialLookupTable ()
+{
+	for (EntryMap::iterator i = _entries.begin (); i != _entries.end (); ++i) {
+		delete i->second;
+	}
+	delete _root;
+}
+
+/** @return bounding box of the given child in our item's coordinates */
+Rect
+SpatialLookupTable::item_bbox (Item const* child) const
+{
+	Rect const bbox = child->bounding_box ();
+	if (!bbox) {
+		return Rect ();
+	}
+	return child->item_to_parent (bbox);
+}
+
+Rect
+SpatialLookupTable::window_to_table (Rect const & area) const
+{
+	/* all children share the same scroll-parent, which is not
+	 * necessarily the same as our item's (e.g. a ScrollGroup).
+	 */
+	Item const* child = _item.items ().front ();
+	return child->item_to_parent (child->window_to_item (area));
+}
+
+Duple
+SpatialLookupTable::window_to_table (Duple const & point) const
+{
+	Item const* child = _item.items ().front ();
+	return child->item_to_parent (child->window_to_item (point));
+}
+
+int
+SpatialLookupTable::quadrant (Node const* n, Rect const & r) const
+{
+	Coord const mx = n->bounds.x0 + n->bounds.width () * .5;
+	Coord const my = n->bounds.y0 + n->bounds.height () * .5;
+
+	int q;
+
+	if (r.x1 <= mx) {
+		q = 0;
+	} else if (r.x0 >= mx) {
+		q = 1;
+	} else {
+		return -1;
+	}
+
+	if (r.y1 <= my) {
+		return q;
+	} else if (r.y0 >= my) {
+		return q + 2;
+	}
+	return -1;
+}
+
+void
+SpatialLookupTable::link (std::vector<Entry*>& bucket, Entry* e)
+{
+	e->bucket = &bucket;
+	e->index  = bucket.size ();
+	bucket.push_back (e);
+}
+
+void
+SpatialLookupTable::unlink (Entry* e)
+{
+	if (!e->bucket) {
+		return;
+	}
+
+	std::vector<Entry*>& v (*e->bucket);
+	assert (e->index < v.size () && v[e->index] == e);
+
+	Entry* last = v.back ();
+	v[e->index] = last;
+	last->index = e->index;
+	v.pop_back ();
+
+	e->bucket = 0;
+}
+
+void
+SpatialLookupTable::insert (Entry* e)
+{
+	e->bbox = item_bbox (e->item);
+
+	if (!e->bbox) {
+		/* not indexed until it has a bounding box */
+		return;
+	}
+
+	Rect const& r (e->bbox);
+
+	if (!_root || r.x0 < _root->bounds.x0 || r.y0 < _root->bounds.y0 || r.x1 > _root->bounds.x1 || r.y1 > _root->bounds.y1) {
+		link (_outside, e);
+		return;
+	}
+
+	insert (_root, e);
+}
+
+void
+SpatialLookupTable::insert (Node* n, Entry* e)
+{
+	while (!n->is_leaf ()) {
+		int const q = quadrant (n, e->bbox);
+		if (q < 0) {
+			break;
+		}
+		n = n->children[q];
+	}
+
+	link (n->entries, e);
+
+	if (n->is_leaf () && n->entries.size () > node_capacity && n->depth < max_depth) {
+		split (n);
+	}
+}
+
+void
+SpatialLookupTable::split (Node* n)
+{
+	Rect const& b (n->bounds);
+	Coord const mx = b.x0 + b.width () * .5;
+	Coord const my = b.y0 + b.height () * .5;
+
+	n->children[0] = new Node (Rect (b.x0, b.y0, mx, my), n->depth + 1);
+	n->children[1] = new Node (Rect (mx, b.y0, b.x1, my), n->depth + 1);
+	n->children[2] = new Node (Rect (b.x0, my, mx, b.y1), n->depth + 1);
+	n->children[3] = new Node (Rect (mx, my, b.x1, b.y1), n->depth + 1);
+
+	std::vector<Entry*> entries;
+	entries.swap (n->entries);
+
+	for (std::vector<Entry*>::const_iterator i = entries.begin (); i != entries.end (); ++i) {
+		int const q = quadrant (n, (*i)->bbox);
+		link (q < 0 ? n->entries : n->children[q]->entries, *i);
+	}
+
+	for (int i = 0; i < 4; ++i) {
+		Node* c = n->children[i];
+		if (c->entries.size () > node_capacity && c->depth < max_depth) {
+			split (c);
+		}
+	}
+}
+
+/** Index items that were added or changed since the last lookup.
+ *
+ * Children are added while they are being constructed, their
+ * bounding box can only be computed later.
+ */
+void
+SpatialLookupTable::flush_pending ()
+{
+	std::vector<Entry*> pending;
+	pending.swap (_pending);
+
+	for (std::vector<Entry*>::const_iterator i = pending.begin (); i != pending.end (); ++i) {
+		(*i)->bucket = 0;
+		insert (*i);
+	}
+}
+
+bool
+SpatialLookupTable::need_rebuild () const
+{
+	/* too many items outside of the tree's area */
+	return _outside.size () > max<size_t> (64, _entries.size () / 8);
+}
+
+bool
+SpatialLookupTable::add (Item* child, bool front)
+{
+	if (_entries.find (child) != _entries.end ()) {
+		return false;
+	}
+
+	Entry* e = new Entry (child, front ? _front_order-- : _back_order++);
+	_entries.insert (make_pair (child, e));
+	link (_pending, e);
+
+	return !need_rebuild ();
+}
+
+bool
+SpatialLookupTable::remove (Item* child)
+{
+	/* Note: child may be in the middle of being deleted,
+	 * do not call any of its methods.
+	 */
+	EntryMap::iterator i = _entries.find (child);
+	if (i == _entries.end ()) {
+		return false;
+	}
+
+	unlink (i->second);
+	delete i->second;
+	_entries.erase (i);
+	return true;
+}
+
+bool
+SpatialLookupTable::update (Item* child)
+{
+	EntryMap::iterator i = _entries.find (child);
+	if (i == _entries.end ()) {
+		return false;
+	}
+
+	Entry* e = i->second;
+
+	if (e->bucket != &_pending) {
+		unlink (e);
+		link (_pending, e);
+	}
+
+	return !need_rebuild ();
+}
+
+void
+SpatialLookupTable::query (Node const* n, Rect const & area, std::vector<Entry*>& found) const
+{
+	if (!n->bounds.intersection (area)) {
+		return;
+	}
+
+	for (std::vector<Entry*>::const_iterator i = n->entries.begin (); i != n->entries.end (); ++i) {
+		if ((*i)->bbox.intersection (area)) {
+			found.push_back (*i);
+		}
+	}
+
+	if (!n->is_leaf ()) {
+		for (int i = 0; i < 4; ++i) {
+			query (n->children[i], area, found);
+		}
+	}
+}
+
+bool
+SpatialLookupTable::order_sort (Entry const* a, Entry const* b)
+{
+	return a->order < b->order;
+}
+
+/** @return items of @p found, in stacking order of the owning item */
+vector<Item*>
+SpatialLookupTable::sorted_items (std::vector<Entry*>& found) const
+{
+	sort (found.begin (), found.end (), order_sort);
+
+	vector<Item*> vitems;
+	vitems.reserve (found.size ());
+	for (std::vector<Entry*>::const_iterator i = found.begin (); i != found.end (); ++i) {
+		vitems.push_back ((*i)->item);
+	}
+	return vitems;
+}
+
+/** @param area Area in window coordinates */
+vector<Item*>
+SpatialLookupTable::get (Rect const & area)
+{
+	if (_item.items ().empty ()) {
+		return vector<Item*> ();
+	}
+
+	flush_pending ();
+
+	/* allow for rounding in Item::item_to_window(), callers
+	 * intersect the returned items' bounding box again.
+	 */
+	Rect const r = window_to_table (area).expand (1.0);
+
+	std::vector<Entry*> found;
+
+	if (_root) {
+		query (_root, r, found);
+	}
+
+	for (std::vector<Entry*>::const_iterator i = _outside.begin (); i != _outside.end (); ++i) {
+		if ((*i)->bbox.intersection (r)) {
+			found.push_back (*i);
+		}
+	}
+
+	return sorted_items (found);
+}
+
+vector<Item*>
+SpatialLookupTable::items_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	if (_item.items ().empty ()) {
+		return vector<Item*> ();
+	}
+
+	/* lookup is logically const, updating the index is not */
+	const_cast<SpatialLookupTable*> (this)->flush_pending ();
+
+	Duple const p = window_to_table (point);
+	Rect const area (p.x - 1, p.y - 1, p.x + 1, p.y + 1);
+
+	std::vector<Entry*> candidates;
+
+	if (_root) {
+		query (_root, area, candidates);
+	}
+
+	for (std::vector<Entry*>::const_iterator i = _outside.begin (); i != _outside.end (); ++i) {
+		if ((*i)->bbox.intersection (area)) {
+			candidates.push_back (*i);
+		}
+	}
+
+	/* exact test, same as DumbLookupTable */
+	std::vector<Entry*> found;
+	for (std::vector<Entry*>::const_iterator i = candidates.begin (); i != candidates.end (); ++i) {
+		if ((*i)->item->covers (point)) {
+			found.push_back (*i);
+		}
+	}
+
+	return sorted_items (found);
+}
+
+bool
+SpatialLookupTable::has_item_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	vector<Item*> items = items_at_point (point);
+
+	for (vector<Item*>::const_iterator i = items.begin (); i != items.end (); ++i) {
+		if ((*i)->visible ()) {
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -832,7 +832,7 @@ Meter::queue_vertical_redraw (float old_level)
 		if (visible() && _bounding_box && _canvas) {
 			Cairo::RectangleInt iri = region->get_extents();
 			Rect ir (iri.x, iri.y, iri.x + iri.width, iri.y + iri.height);
-			_canvas->request_redraw (item_to_window (ir));
+			_canvas->request_item_redraw (this, item_to_window (ir));
   		}
 	}
 }
@@ -903,7 +903,7 @@ Meter::queue_horizontal_redraw (float old_level)
 		if (visible() && _bounding_box && _canvas) {
 			Cairo::RectangleInt iri = region->get_extents();
 			Rect ir (iri.x, iri.y, iri.x + iri.width, iri.y + iri.height);
-			_canvas->request_redraw (item_to_window (ir));
+			_canvas->request_item_redraw (this, item_to_window (ir));
 		}
 	}
 }
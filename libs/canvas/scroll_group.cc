@@ -17,6 +17,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cmath>
 #include <iostream>
 
 #include "pbd/compose.h"
@@ -28,15 +29,28 @@
 using namespace std;
 using namespace ArdourCanvas;
 
+int      ScrollGroup::tile_size = 256;
+uint32_t ScrollGroup::max_tiles = 256;
+
 ScrollGroup::ScrollGroup (Canvas* c, ScrollSensitivity s)
 	: Container (c)
 	, _scroll_sensitivity (s)
+	, _tile_cache (false)
+	, _tile_clock (0)
+	, _tiles_rendered (0)
+	, _tiles_updated (0)
+	, _tiles_reused (0)
 {
 }
 
 ScrollGroup::ScrollGroup (Item* parent, ScrollSensitivity s)
 	: Container (parent)
 	, _scroll_sensitivity (s)
+	, _tile_cache (false)
+	, _tile_clock (0)
+	, _tiles_rendered (0)
+	, _tiles_updated (0)
+	, _tiles_reused (0)
 {
 }
 
@@ -68,11 +82,182 @@ ScrollGroup::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) c
 	context->rectangle (self.x0, self.y0, self.width(), self.height());
 	context->clip ();
 
-	Container::render (area, context);
+	if (_tile_cache && _scroll_offset.x == rint (_scroll_offset.x) && _scroll_offset.y == rint (_scroll_offset.y)) {
+		render_tiled (area.intersection (self), context);
+	} else {
+		Container::render (area, context);
+	}
 
 	context->restore ();
 }
 
+static bool
+rect_inside (Rect const & r, Rect const & outer)
+{
+	return r.x0 >= outer.x0 && r.y0 >= outer.y0 && r.x1 <= outer.x1 && r.y1 <= outer.y1;
+}
+
+Rect
+ScrollGroup::tile_window_rect (TileIndex const & ti) const
+{
+	Rect r (ti.first * tile_size, ti.second * tile_size, (ti.first + 1) * tile_size, (ti.second + 1) * tile_size);
+	return r.translate (-_scroll_offset);
+}
+
+/** Render @param area (in window coordinates) of the tile, which
+ *  covers @param tile_area (in window coordinates).
+ */
+void
+ScrollGroup::render_tile (Tile& tile, Rect const & tile_area, Rect const & area, Cairo::RefPtr<Cairo::Context> context) const
+{
+	if (!tile.surface) {
+		tile.surface = Cairo::Surface::create (context->get_target (), Cairo::CONTENT_COLOR_ALPHA, tile_size, tile_size);
+	}
+	Cairo::RefPtr<Cairo::Context> tc = Cairo::Context::create (tile.surface);
+	tc->translate (-tile_area.x0, -tile_area.y0);
+	tc->rectangle (area.x0, area.y0, area.width(), area.height());
+	tc->clip ();
+	tc->set_operator (Cairo::OPERATOR_CLEAR);
+	tc->paint ();
+	tc->set_operator (Cairo::OPERATOR_OVER);
+	Container::render (area, tc);
+}
+
+void
+ScrollGroup::render_tiled (Rect const & area, Cairo::RefPtr<Cairo::Context> context) const
+{
+	if (!area) {
+		return;
+	}
+
+	/* Only tiles that are completely visible are cached. Many items
+	 * clamp their drawing to the visible area, and changes to items
+	 * outside of the visible area do not queue a redraw.
+	 */
+	Rect const visible = _canvas->visible_area ();
+
+	/* tiles are aligned to canvas coordinates (without scroll offset) */
+	Rect const c = area.translate (_scroll_offset);
+
+	int64_t const tx0 = floor (c.x0 / tile_size);
+	int64_t const ty0 = floor (c.y0 / tile_size);
+	int64_t const tx1 = ceil (c.x1 / tile_size);
+	int64_t const ty1 = ceil (c.y1 / tile_size);
+
+	for (int64_t ty = ty0; ty < ty1; ++ty) {
+		for (int64_t tx = tx0; tx < tx1; ++tx) {
+
+			TileIndex const ti (tx, ty);
+			Rect const tw   = tile_window_rect (ti);
+			Rect const part = tw.intersection (area);
+
+			if (!part) {
+				continue;
+			}
+
+			Tiles::iterator t = _tiles.find (ti);
+
+			if (!rect_inside (tw, visible)) {
+				if (t != _tiles.end ()) {
+					_tiles.erase (t);
+				}
+				context->save ();
+				context->rectangle (part.x0, part.y0, part.width(), part.height());
+				context->clip ();
+				Container::render (part, context);
+				context->restore ();
+				continue;
+			}
+
+			if (t == _tiles.end ()) {
+				t = _tiles.insert (std::make_pair (ti, Tile ())).first;
+			}
+
+			Tile& tile (t->second);
+
+			if (!tile.valid) {
+				render_tile (tile, tw, tw, context);
+				tile.valid = true;
+				tile.dirty = Rect ();
+				++_tiles_rendered;
+			} else if (tile.dirty) {
+				/* only re-render the damaged part of the tile */
+				render_tile (tile, tw, tile.dirty.translate (-_scroll_offset), context);
+				tile.dirty = Rect ();
+				++_tiles_updated;
+			} else {
+				++_tiles_reused;
+			}
+
+			tile.last_used = ++_tile_clock;
+
+			context->set_source (tile.surface, tw.x0, tw.y0);
+			context->rectangle (part.x0, part.y0, part.width(), part.height());
+			context->fill ();
+		}
+	}
+
+	evict_tiles ();
+}
+
+void
+ScrollGroup::evict_tiles () const
+{
+	while (_tiles.size () > max_tiles) {
+		Tiles::iterator lru = _tiles.begin ();
+		for (Tiles::iterator t = _tiles.begin (); t != _tiles.end (); ++t) {
+			if (t->second.last_used < lru->second.last_used) {
+				lru = t;
+			}
+		}
+		_tiles.erase (lru);
+	}
+}
+
+void
+ScrollGroup::set_tile_cache (bool yn)
+{
+	if (_tile_cache == yn) {
+		return;
+	}
+	_tile_cache = yn;
+	_tiles.clear ();
+}
+
+void
+ScrollGroup::invalidate_tiles (Rect const & area)
+{
+	if (_tiles.empty ()) {
+		return;
+	}
+
+	for (Tiles::iterator t = _tiles.begin (); t != _tiles.end (); ++t) {
+		Tile& tile (t->second);
+		if (!tile.valid) {
+			continue;
+		}
+		Rect d = tile_window_rect (t->first).intersection (area);
+		if (!d) {
+			continue;
+		}
+		/* align to pixels, store in canvas coordinates */
+		d.x0 = floor (d.x0);
+		d.y0 = floor (d.y0);
+		d.x1 = ceil (d.x1);
+		d.y1 = ceil (d.y1);
+		d = d.translate (_scroll_offset);
+		tile.dirty = tile.dirty ? tile.dirty.extend (d) : d;
+	}
+}
+
+void
+ScrollGroup::invalidate_all_tiles ()
+{
+	for (Tiles::iterator t = _tiles.begin (); t != _tiles.end (); ++t) {
+		t->second.valid = false;
+	}
+}
+
 void
 ScrollGroup::scroll_to (Duple const& d)
 {
@@ -83,6 +268,19 @@ ScrollGroup::scroll_to (Duple const& d)
 	if (_scroll_sensitivity & ScrollsVertically) {
 		_scroll_offset.y = d.y;
 	}
+
+	if (!_tiles.empty ()) {
+		/* drop tiles that are no longer completely visible */
+		Rect const visible = _canvas->visible_area ();
+		for (Tiles::iterator t = _tiles.begin (); t != _tiles.end (); ) {
+			if (!rect_inside (tile_window_rect (t->first), visible)) {
+				_tiles.erase (t++);
+			} else {
+				++t;
+			}
+		}
+	}
+
 	_canvas->item_visual_property_changed (this);
 }
 
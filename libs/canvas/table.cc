@@ -95,13 +95,13 @@ Table::attach (Item* item, uint32_t ulx, uint32_t uly, uint32_t lrx, uint32_t lr
 }
 
 void
-Table::child_changed (bool bbox_changed)
+Table::child_changed (bool bbox_changed, Item* child)
 {
 	if (ignore_child_changes) {
 		return;
 	}
 
-	Item::child_changed (bbox_changed);
+	Item::child_changed (bbox_changed, child);
 	size_allocate_children (_allocation);
 }
 
@@ -51,6 +51,14 @@ public:
 		return false;
 	}
 
+	/** @return approximate memory used by this command, in bytes.
+	 * Commands that hold large amounts of state should override this,
+	 * so that the undo history can respect its memory budget.
+	 */
+	virtual size_t memory_size () const {
+		return sizeof (*this);
+	}
+
 protected:
 	Command() {}
 	Command(const std::string& name) : _name(name) {}
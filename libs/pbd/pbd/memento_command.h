@@ -104,14 +104,14 @@ class LIBPBD_TEMPLATE_API MementoCommand : public PBD::Command
 {
 public:
 	MementoCommand (obj_T& a_object, XMLNode* a_before, XMLNode* a_after)
-		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object)), before (a_before), after (a_after)
+		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object)), before (a_before), after (a_after), _memory_size (0)
 	{
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, std::bind (&MementoCommand::binder_dying, this));
 	}
 
 	MementoCommand (MementoCommandBinder<obj_T>* b, XMLNode* a_before, XMLNode* a_after)
-		: _binder (b), before (a_before), after (a_after)
+		: _binder (b), before (a_before), after (a_after), _memory_size (0)
 	{
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, std::bind (&MementoCommand::binder_dying, this));
@@ -140,6 +140,14 @@ public:
 		}
 	}
 
+	size_t memory_size () const {
+		/* before and after never change, so compute their size once */
+		if (_memory_size == 0) {
+			_memory_size = sizeof (*this) + (before ? before->memory_size () : 0) + (after ? after->memory_size () : 0);
+		}
+		return _memory_size;
+	}
+
 	virtual XMLNode &get_state() const {
 		std::string name;
 		if (before && after) {
@@ -171,5 +179,8 @@ protected:
 	XMLNode* before;
 	XMLNode* after;
 	PBD::ScopedConnection _binder_death_connection;
+
+private:
+	mutable size_t _memory_size;
 };
 
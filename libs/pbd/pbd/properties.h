@@ -176,6 +176,10 @@ public:
 		}
 	}
 
+	size_t memory_size () const {
+		return sizeof (*this);
+	}
+
 protected:
 
 	void set (T const& v) {
@@ -320,6 +324,10 @@ public:
 		return this->_current;
 	}
 
+	size_t memory_size () const {
+		return sizeof (*this) + _current.capacity () + _old.capacity ();
+	}
+
 private:
 	std::string to_string (std::string const& v) const {
 		return v;
@@ -451,6 +459,11 @@ public:
 		*_current = *(dynamic_cast<SharedStatefulProperty const *> (p))->val ();
 	}
 
+	size_t memory_size () const {
+		/* a diff holds complete copies of the old and new object */
+		return sizeof (*this) + (_old ? sizeof (T) : 0) + (_current ? sizeof (T) : 0);
+	}
+
 	Ptr val () const {
 		return _current;
 	}
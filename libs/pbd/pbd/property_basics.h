@@ -152,6 +152,9 @@ public:
 	/** Set this property's current state from another */
 	virtual void apply_change (PropertyBase const *) = 0;
 
+	/** @return approximate memory used by this property, in bytes */
+	virtual size_t memory_size () const { return sizeof (PropertyBase); }
+
 	const gchar* property_name () const { return g_quark_to_string (_property_id); }
 	PropertyID   property_id () const   { return _property_id; }
 
@@ -217,6 +217,12 @@ class /*LIBPBD_API*/ SequenceProperty : public PropertyBase
 	/** Given an \<Add\> or \<Remove\> node as passed into get_content_to_xml, obtain an item */
 	virtual typename Container::value_type get_content_from_xml (XMLNode const & node) const = 0;
 
+	size_t memory_size () const {
+		/* approximate per-element overhead of a std::set/std::list node */
+		size_t const element_size = sizeof (typename Container::value_type) + 4 * sizeof (void*);
+		return sizeof (*this) + (_val.size () + _changes.added.size () + _changes.removed.size ()) * element_size;
+	}
+
 	void clear_owned_changes () {
 		for (typename Container::iterator i = begin(); i != end(); ++i) {
 			(*i)->clear_changes ();
@@ -24,6 +24,8 @@
 #include <csignal>
 
 #include <list>
+#include <memory>
+#include <vector>
 #include <map>
 
 #ifdef nil
@@ -129,12 +131,55 @@ public:
 
 private:
 
+	/** A connected slot. This is shared between _slots and all
+	 * SlotLists that contain it, so that an emission in progress can
+	 * still call it (or skip it, once it has been disconnected)
+	 * after it was removed from _slots.
+	 */
+	struct Slot {
+		Slot (slot_function_type const & f) : functor (f), connected (true) {}
+		slot_function_type const functor;
+		std::atomic<bool>        connected;
+	};
+
+	/** An immutable snapshot of the connected slots, in the order
+	 * that they were connected. Emission iterates over the current
+	 * snapshot without taking _mutex or allocating memory. Connecting
+	 * or disconnecting (with _mutex held) publishes a new snapshot;
+	 * replaced snapshots are only deleted once no emission is in
+	 * progress.
+	 */
+	struct SlotList {
+		SlotList () : dead_next (0) {}
+		std::vector<std::shared_ptr<Slot> > slots;
+		SlotList* dead_next;
+	};
+
 	/** The slots that this signal will call on emission */
-	typedef std::map<std::shared_ptr<Connection>, slot_function_type> Slots;
+	typedef std::map<std::shared_ptr<Connection>, std::shared_ptr<Slot> > Slots;
 	Slots _slots;
 
+	std::atomic<SlotList*> _slot_list;
+	std::atomic<int>       _emitters;
+	SlotList*              _dead_slot_lists;
+
+	struct EmissionGuard {
+		EmissionGuard (std::atomic<int>& e) : _e (e) { _e.fetch_add (1); }
+		~EmissionGuard () { _e.fetch_sub (1); }
+		std::atomic<int>& _e;
+	};
+
+	void publish (SlotList*);
+	void drop_dead_slot_lists ();
+
 public:
 
+	SignalWithCombiner ()
+		: _slot_list (0)
+		, _emitters (0)
+		, _dead_slot_lists (0)
+	{}
+
 	static void compositor (typename std::function<void(A...)> f,
 	                        EventLoop* event_loop,
 	                        EventLoop::InvalidationRecord* ir, A... a);
@@ -330,6 +375,44 @@ SignalWithCombiner<Combiner, R(A...)>::~SignalWithCombiner ()
 	for (typename Slots::const_iterator i = _slots.begin(); i != _slots.end(); ++i) {
 		i->first->signal_going_away ();
 	}
+	delete _slot_list.exchange (0);
+	drop_dead_slot_lists ();
+}
+
+/** Replace the current slot list with @a sl. Must be called with
+ * _mutex held.
+ */
+
+template <typename Combiner, typename R, typename... A>
+void
+SignalWithCombiner<Combiner, R(A...)>::publish (SlotList* sl)
+{
+	SlotList* old = _slot_list.exchange (sl);
+
+	if (old) {
+		old->dead_next   = _dead_slot_lists;
+		_dead_slot_lists = old;
+	}
+
+	/* An emission that starts after the exchange above can only
+	 * see @a sl, so once there are no emitters, none of the replaced
+	 * lists can be in use any more. Otherwise they are kept until
+	 * a later connect/disconnect, or our d'tor.
+	 */
+	if (_emitters.load () == 0) {
+		drop_dead_slot_lists ();
+	}
+}
+
+template <typename Combiner, typename R, typename... A>
+void
+SignalWithCombiner<Combiner, R(A...)>::drop_dead_slot_lists ()
+{
+	while (_dead_slot_lists) {
+		SlotList* sl = _dead_slot_lists;
+		_dead_slot_lists = sl->dead_next;
+		delete sl;
+	}
 }
 
 /** Arrange for @a slot to be executed whenever this signal is emitted.
@@ -427,89 +510,59 @@ SignalWithCombiner<Combiner, R(A...)>::connect (ScopedConnection& c,
 /** Emit this signal. This will cause all slots connected to it be executed
  * in the order that they were connected (cross-thread issues may alter
  * the precise execution time of cross-thread slots).
+ *
+ * Emission does not take any locks and does not allocate memory (unless
+ * R is not void; see below).
  */
 
 template <typename Combiner, typename R, typename... A>
 typename std::conditional_t<std::is_void_v<R>, R, typename Combiner::result_type>
 SignalWithCombiner<Combiner, R(A...)>::operator() (A... a)
 {
-#ifdef DEBUG_PBD_SIGNAL_EMISSION
-	if (_debug_emission) {
-		std::cerr << "------ Signal @ " << this << " emission process begins with " << _slots.size() << std::endl;
-		PBD::stacktrace (std::cerr, 19);
-	}
-#endif
-
-#ifdef _MSC_VER
-	/* Regarding the note (below) it was initially
-	 * thought that the problem got fixed in VS2015
-	 * but in fact it still persists even in VS2022 */
-
-	/* Use the older (heap based) mapping when building with MSVC.
-	 * Our StackAllocator class depends on 'boost::aligned_storage'
-	 * which is known to be troublesome with Visual C++ :-
-	 * https://www.boost.org/doc/libs/1_65_0/libs/type_traits/doc/html/boost_typetraits/reference/aligned_storage.html
+	/* Fast path for signals without any connections. This does not
+	 * dereference the list, so it is safe without the guard.
 	 */
-	std::vector<Connection*> s;
-#else
-	const std::size_t nslots = 512;
-	std::vector<Connection*,PBD::StackAllocator<Connection*,nslots> > s;
-#endif
+	if (!_slot_list.load (std::memory_order_relaxed)) {
+		if constexpr (std::is_void_v<R>) {
+			return;
+		} else {
+			return typename Combiner::result_type ();
+		}
+	}
 
-	/* First, make a copy of the current connection state for us to iterate
-	 * over later (the connection state may be changed by a signal handler.
+	/* While the guard exists, the slot list we load below will not be
+	 * deleted, even if a slot handler connects or disconnects slots
+	 * (which publishes a new list). Slots that are disconnected during
+	 * emission are marked as such, and skipped.
 	 */
+	EmissionGuard eg (_emitters);
+	SlotList const* sl = _slot_list.load ();
 
-	{
-		Glib::Threads::Mutex::Lock lm (_mutex);
-		/* copy only the raw pointer, no need for a shared_ptr in this
-		 * context, we only use the address as a lookup into the _slots
-		 * container. Note: because of the use of a stack allocator,
-		 * this is *unlikely* to cause any (heap) memory
-		 * allocation. That will only happen if the number of
-		 * connections to this signal exceeds the value of nslots
-		 * defined above. As of April 2025, the maximum number of
-		 * connections appears to be ntracks+1.
-		 */
-		for (auto const & [connection,functor] : _slots) {
-			s.push_back (connection.get());
-		}
+#ifdef DEBUG_PBD_SIGNAL_EMISSION
+	if (_debug_emission) {
+		std::cerr << "------ Signal @ " << this << " emission process begins with " << (sl ? sl->slots.size() : 0) << std::endl;
+		PBD::stacktrace (std::cerr, 19);
 	}
+#endif
 
 	if constexpr (std::is_void_v<R>) {
-		slot_function_type functor;
-
-		for (auto const & c : s) {
 
-			/* We may have just called a slot, and this may have
-			 * resulted in disconnection of other slots from us.
-			 * The list copy means that this won't cause any
-			 * problems with invalidated iterators, but we must
-			 * check to see if the slot we are about to call is
-			 * still on the list.
-			 */
-			bool still_there = false;
-
-			{
-				Glib::Threads::Mutex::Lock lm (_mutex);
-				typename Slots::const_iterator f = std::find_if (_slots.begin(), _slots.end(), [&](typename Slots::value_type const & elem) { return elem.first.get() == c; });
-				if (f != _slots.end()) {
-					functor = f->second;
-					still_there = true;
-				}
-			}
+		if (!sl) {
+			return;
+		}
 
-			if (still_there) {
+		for (auto const & slot : sl->slots) {
+			if (slot->connected.load (std::memory_order_acquire)) {
 #ifdef DEBUG_PBD_SIGNAL_EMISSION
 				if (_debug_emission) {
-					std::cerr << "signal @ " << this << " calling slot for connection @ " << c << " of " << _slots.size() << std::endl;
+					std::cerr << "signal @ " << this << " calling slot @ " << slot.get() << " of " << sl->slots.size() << std::endl;
 				}
 #endif
-				functor (a...);
+				slot->functor (a...);
 			} else {
 #ifdef DEBUG_PBD_SIGNAL_EMISSION
 				if (_debug_emission) {
-					std::cerr << "signal @ " << this << " connection  " << c << " of " << _slots.size() << " was no longer in the slot list\n";
+					std::cerr << "signal @ " << this << " slot  " << slot.get() << " of " << sl->slots.size() << " was disconnected\n";
 				}
 #endif
 			}
@@ -523,7 +576,7 @@ SignalWithCombiner<Combiner, R(A...)>::operator() (A... a)
 		return;
 
 	} else {
-		if (s.empty()) {
+		if (!sl || sl->slots.empty()) {
 			return typename Combiner::result_type ();
 		}
 
@@ -549,42 +602,24 @@ SignalWithCombiner<Combiner, R(A...)>::operator() (A... a)
 		 */
 
 		std::vector<R> r;
-		r.reserve (s.size());
-		slot_function_type functor;
-
-		for (auto const & c : s) {
-
-			/* We may have just called a slot, and this may have resulted in
-			 * disconnection of other slots from us.  The list copy means that
-			 * this won't cause any problems with invalidated iterators, but we
-			 * must check to see if the slot we are about to call is still on the list.
-			 */
-			bool still_there = false;
-
-			{
-				Glib::Threads::Mutex::Lock lm (_mutex);
-				typename Slots::const_iterator f = std::find_if (_slots.begin(), _slots.end(), [&](typename Slots::value_type const & elem) { return elem.first.get() == c; });
+		r.reserve (sl->slots.size());
 
-				if (f != _slots.end()) {
-					functor = f->second;
-					still_there = true;
-				}
-			}
-			if (still_there) {
+		for (auto const & slot : sl->slots) {
+			if (slot->connected.load (std::memory_order_acquire)) {
 #ifdef DEBUG_PBD_SIGNAL_EMISSION
 				if (_debug_emission) {
-					std::cerr << "signal @ " << this << " calling non-void slot for connection @ " << c << " of " << _slots.size() << std::endl;
+					std::cerr << "signal @ " << this << " calling non-void slot @ " << slot.get() << " of " << sl->slots.size() << std::endl;
 				}
 #endif
-				r.push_back (functor (a...));
+				r.push_back (slot->functor (a...));
 			}
+		}
 
 #ifdef DEBUG_PBD_SIGNAL_EMISSION
-			if (_debug_emission) {
-				std::cerr << "------ Signal @ " << this << " emission process ends\n";
-			}
-#endif
+		if (_debug_emission) {
+			std::cerr << "------ Signal @ " << this << " emission process ends\n";
 		}
+#endif
 		/* Call our combiner to do whatever is required to the result values */
 		Combiner c;
 		return c (r.begin(), r.end());
@@ -597,8 +632,18 @@ SignalWithCombiner<Combiner, R(A...)>::_connect (PBD::EventLoop::InvalidationRec
                                                  slot_function_type f)
 {
 	std::shared_ptr<Connection> c (new Connection (this, ir));
+	std::shared_ptr<Slot> slot (new Slot (f));
 	Glib::Threads::Mutex::Lock lm (_mutex);
-	_slots[c] = f;
+	_slots[c] = slot;
+
+	SlotList* sl = new SlotList;
+	SlotList const* cur = _slot_list.load ();
+	if (cur) {
+		sl->slots.reserve (cur->slots.size () + 1);
+		sl->slots = cur->slots;
+	}
+	sl->slots.push_back (slot);
+	publish (sl);
 
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
 	if (_slots.size() > max_signal_subscribers) {
@@ -626,7 +671,29 @@ SignalWithCombiner<Combiner, R(A...)>::disconnect (std::shared_ptr<Connection> c
 		/* Spin */
 		lm.try_acquire ();
 	}
-	_slots.erase (c);
+	typename Slots::iterator i = _slots.find (c);
+	if (i != _slots.end ()) {
+		std::shared_ptr<Slot> slot (i->second);
+		_slots.erase (i);
+
+		/* an emission in progress may still be iterating over
+		 * a list that contains this slot. Make sure it is skipped.
+		 */
+		slot->connected.store (false, std::memory_order_release);
+
+		SlotList* sl = 0;
+		SlotList const* cur = _slot_list.load ();
+		if (cur && cur->slots.size () > 1) {
+			sl = new SlotList;
+			sl->slots.reserve (cur->slots.size () - 1);
+			for (auto const & s : cur->slots) {
+				if (s != slot) {
+					sl->slots.push_back (s);
+				}
+			}
+		}
+		publish (sl);
+	}
 	lm.release ();
 
 	c->disconnected ();
@@ -46,6 +46,8 @@ public:
 
 	bool empty () const;
 
+	size_t memory_size () const;
+
 private:
 	std::weak_ptr<Stateful> _object;  ///< the object in question
 	PBD::PropertyList*        _changes; ///< property changes to execute this command
@@ -22,9 +22,11 @@
 
 #pragma once
 
+#include <functional>
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <sigc++/bind.h>
 #include <sigc++/slot.h>
@@ -38,6 +40,8 @@
 #include "pbd/command.h"
 #include "pbd/libpbd_visibility.h"
 
+class XMLNode;
+
 namespace PBD {
 
 typedef sigc::slot<void> UndoAction;
@@ -67,6 +71,8 @@ public:
 
 	XMLNode& get_state () const;
 
+	size_t memory_size () const;
+
 	void set_timestamp (struct timeval& t)
 	{
 		_timestamp = t;
@@ -81,6 +87,7 @@ private:
 	std::list<PBD::Command*> actions;
 	struct timeval      _timestamp;
 	bool                _clearing;
+	mutable size_t      _command_size;
 
 	void about_to_explicitly_delete ();
 };
@@ -89,7 +96,7 @@ class LIBPBD_API UndoHistory : public PBD::ScopedConnectionList
 {
 public:
 	UndoHistory ();
-	~UndoHistory () {}
+	~UndoHistory ();
 
 	void add (UndoTransaction* ut);
 	void undo (unsigned int n);
@@ -97,7 +104,7 @@ public:
 
 	unsigned long undo_depth () const
 	{
-		return UndoList.size ();
+		return UndoList.size () + (_reload ? _spilled.size () : 0);
 	}
 	unsigned long redo_depth () const
 	{
@@ -106,7 +113,10 @@ public:
 
 	std::string next_undo () const
 	{
-		return (UndoList.empty () ? std::string () : UndoList.back ()->name ());
+		if (UndoList.empty ()) {
+			return (_spilled.empty () || !_reload) ? std::string () : _spilled.back ().name;
+		}
+		return UndoList.back ()->name ();
 	}
 	std::string next_redo () const
 	{
@@ -128,8 +138,37 @@ public:
 	XMLNode& get_state (int32_t depth = 0);
 	void     save_state ();
 
+	/* write the same state as get_state() to a file, including
+	 * transactions that were spilled to disk.
+	 */
+	bool write_state (std::string const& path, int32_t depth = 0);
+
 	void set_depth (uint32_t);
 
+	/* Limit the memory used by the undo list. When the limit is
+	 * exceeded, the oldest transactions are written to the spill
+	 * file and removed from memory (without a spill file they are
+	 * discarded). Spilled transactions are included by write_state(),
+	 * and are re-created by the reload handler when undo reaches them.
+	 * A budget of 0 means no limit.
+	 */
+	void   set_memory_budget (size_t bytes);
+	size_t memory_budget () const { return _memory_budget; }
+	size_t memory_used () const;
+
+	void set_spill_file (std::string const& path);
+
+	/* Re-create a transaction from its state (as returned by
+	 * UndoTransaction::get_state()), or return 0 on failure.
+	 */
+	typedef std::function<UndoTransaction* (XMLNode const&)> ReloadHandler;
+	void set_reload_handler (ReloadHandler const& h) { _reload = h; }
+
+	unsigned long spilled_depth () const
+	{
+		return _spilled.size ();
+	}
+
 	PBD::Signal<void()> Changed;
 	PBD::Signal<void()> BeginUndoRedo;
 	PBD::Signal<void()> EndUndoRedo;
@@ -139,8 +178,26 @@ private:
 	uint32_t                    _depth;
 	std::list<UndoTransaction*> UndoList;
 	std::list<UndoTransaction*> RedoList;
+	size_t                      _memory_budget;
+	std::string                 _spill_file;
+	int64_t                     _spill_end;
+	bool                        _spill_failed;
+	ReloadHandler               _reload;
+
+	struct SpillRecord {
+		SpillRecord (std::string const& n, int64_t o, size_t s) : name (n), offset (o), size (s) {}
+		std::string name;
+		int64_t     offset;
+		size_t      size;
+	};
+
+	std::vector<SpillRecord>    _spilled; /* oldest first */
 
 	void remove (UndoTransaction*);
+	void enforce_memory_budget ();
+	bool spill (UndoTransaction const*);
+	bool reload_spilled ();
+	void clear_spill ();
 };
 
 } /* namespace */
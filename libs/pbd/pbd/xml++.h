@@ -196,6 +196,9 @@ public:
 
 	void dump (std::ostream &, std::string p = "") const;
 
+	/** @return approximate heap memory used by this node and its children, in bytes */
+	size_t memory_size () const;
+
 private:
 	std::string         _name;
 	bool                _is_content;
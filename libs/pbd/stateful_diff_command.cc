@@ -122,3 +122,16 @@ StatefulDiffCommand::empty () const
 {
 	return _changes->empty ();
 }
+
+size_t
+StatefulDiffCommand::memory_size () const
+{
+	size_t s = sizeof (*this) + sizeof (PropertyList);
+
+	for (PropertyList::const_iterator i = _changes->begin (); i != _changes->end (); ++i) {
+		/* std::map node overhead + the property itself */
+		s += sizeof (*i) + 4 * sizeof (void*) + i->second->memory_size ();
+	}
+
+	return s;
+}
@@ -1,7 +1,10 @@
+#include <iostream>
+
 #include <glibmm/thread.h>
 
 #include "signals_test.h"
 #include "pbd/signals.h"
+#include "pbd/timing.h"
 
 using namespace std;
 
@@ -89,3 +92,85 @@ SignalsTest::testScopedConnectionList ()
 
 	CPPUNIT_ASSERT_EQUAL (1, N);
 }
+
+class Disconnector
+{
+public:
+	Disconnector (Emitter* e) {
+		e->Fred.connect_same_thread (first, std::bind (&Disconnector::disconnect_second, this));
+		e->Fred.connect_same_thread (second, std::bind (&receiver));
+		e->Fred.connect_same_thread (third, std::bind (&receiver));
+	}
+
+	void disconnect_second () {
+		second.disconnect ();
+	}
+
+	PBD::ScopedConnection first;
+	PBD::ScopedConnection second;
+	PBD::ScopedConnection third;
+};
+
+void
+SignalsTest::testDisconnectDuringEmission ()
+{
+	Emitter* e = new Emitter;
+	Disconnector* d = new Disconnector (e);
+
+	/* the second slot is disconnected by the first, and must not be called */
+	N = 0;
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (1, N);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, e->Fred.size ());
+
+	N = 0;
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (1, N);
+
+	delete d;
+	CPPUNIT_ASSERT (e->Fred.empty ());
+
+	N = 0;
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (0, N);
+
+	delete e;
+}
+
+static void
+accumulate (int* acc, int v)
+{
+	*acc += v;
+}
+
+void
+SignalsTest::testPerfEmission ()
+{
+	const int n_slots[] = { 0, 1, 50 };
+	const int n_emissions = 100000;
+	const int n_iterations = 10;
+
+	for (size_t i = 0; i < sizeof (n_slots) / sizeof (int); ++i) {
+		PBD::Signal<void(int)>     sig;
+		PBD::ScopedConnectionList  clist;
+		PBD::TimingData            timing;
+		int                        acc = 0;
+
+		for (int s = 0; s < n_slots[i]; ++s) {
+			sig.connect_same_thread (clist, std::bind (&accumulate, &acc, _1));
+		}
+
+		for (int iter = 0; iter < n_iterations; ++iter) {
+			timing.start_timing ();
+			for (int n = 0; n < n_emissions; ++n) {
+				sig (1);
+			}
+			timing.add_elapsed ();
+		}
+
+		CPPUNIT_ASSERT_EQUAL (n_slots[i] * n_emissions * n_iterations, acc);
+
+		std::cerr << std::endl;
+		std::cerr << "   " << n_emissions << " emissions, " << n_slots[i] << " slots : " << timing.summary ();
+	}
+}
@@ -0,0 +1,246 @@
+#include "undo_test.h"
+
+#include <functional>
+
+#include <glibmm/fileutils.h>
+#include <glibmm/miscutils.h>
+
+#include "pbd/command.h"
+#include "pbd/compose.h"
+#include "pbd/gstdio_compat.h"
+#include "pbd/undo.h"
+#include "pbd/xml++.h"
+
+#include "test_common.h"
+
+using namespace std;
+using namespace PBD;
+
+CPPUNIT_TEST_SUITE_REGISTRATION (UndoTest);
+
+/** Sets an integer, and claims to use a given amount of memory */
+class TestCommand : public Command
+{
+public:
+	TestCommand (int& value, int from, int to, size_t size)
+		: Command ("TestCommand")
+		, _value (value)
+		, _from (from)
+		, _to (to)
+		, _size (size)
+	{}
+
+	~TestCommand () { drop_references (); }
+
+	void operator() () { _value = _to; }
+	void undo () { _value = _from; }
+
+	XMLNode& get_state () const
+	{
+		XMLNode* node = new XMLNode ("TestCommand");
+		node->set_property ("from", _from);
+		node->set_property ("to", _to);
+		node->set_property ("size", (int64_t)_size);
+		return *node;
+	}
+
+	size_t memory_size () const { return _size; }
+
+private:
+	int&   _value;
+	int    _from;
+	int    _to;
+	size_t _size;
+};
+
+static const size_t command_size = 1000;
+static const size_t budget       = 2048;
+
+static UndoTransaction*
+make_transaction (int& value, int n)
+{
+	UndoTransaction* ut = new UndoTransaction ();
+	ut->set_name (string_compose ("t%1", n));
+	ut->add_command (new TestCommand (value, n, n + 1, command_size));
+	ut->redo ();
+	return ut;
+}
+
+static UndoTransaction*
+reload_transaction (int* value, XMLNode const& node)
+{
+	std::string name;
+	if (node.name () != "UndoTransaction" || !node.get_property ("name", name)) {
+		return 0;
+	}
+
+	UndoTransaction* ut = new UndoTransaction ();
+	ut->set_name (name);
+
+	for (XMLNodeConstIterator i = node.children ().begin (); i != node.children ().end (); ++i) {
+		int     from, to;
+		int64_t size;
+		if ((*i)->get_property ("from", from) && (*i)->get_property ("to", to) && (*i)->get_property ("size", size)) {
+			ut->add_command (new TestCommand (*value, from, to, size));
+		}
+	}
+	return ut;
+}
+
+static std::string
+spill_file (std::string const& name)
+{
+	return Glib::build_filename (test_output_directory ("undo"), name);
+}
+
+void
+UndoTest::testMemoryBudgetSpill ()
+{
+	int         value = 0;
+	UndoHistory history;
+
+	history.set_spill_file (spill_file ("budget.spill"));
+
+	for (int n = 0; n < 5; ++n) {
+		history.add (make_transaction (value, n));
+	}
+
+	/* no budget, nothing is spilled */
+	CPPUNIT_ASSERT_EQUAL (0UL, history.spilled_depth ());
+	CPPUNIT_ASSERT_EQUAL (5UL, history.undo_depth ());
+	CPPUNIT_ASSERT (history.memory_used () > 5 * command_size);
+
+	/* only one transaction fits, the oldest four are spilled */
+	history.set_memory_budget (budget);
+
+	CPPUNIT_ASSERT_EQUAL (4UL, history.spilled_depth ());
+	CPPUNIT_ASSERT_EQUAL (1UL, history.undo_depth ());
+	CPPUNIT_ASSERT (history.memory_used () <= budget);
+	CPPUNIT_ASSERT_EQUAL (std::string ("t4"), history.next_undo ());
+
+	history.add (make_transaction (value, 5));
+	CPPUNIT_ASSERT_EQUAL (5UL, history.spilled_depth ());
+	CPPUNIT_ASSERT_EQUAL (1UL, history.undo_depth ());
+
+	history.clear ();
+	CPPUNIT_ASSERT_EQUAL (0UL, history.spilled_depth ());
+	CPPUNIT_ASSERT (!Glib::file_test (spill_file ("budget.spill"), Glib::FILE_TEST_EXISTS));
+}
+
+void
+UndoTest::testSpillFailure ()
+{
+	int         value = 0;
+	UndoHistory history;
+
+	history.set_spill_file (Glib::build_filename (spill_file ("does-not-exist"), "failure.spill"));
+	history.set_memory_budget (budget);
+
+	for (int n = 0; n < 5; ++n) {
+		history.add (make_transaction (value, n));
+	}
+
+	/* transactions that cannot be spilled remain in memory */
+	CPPUNIT_ASSERT_EQUAL (0UL, history.spilled_depth ());
+	CPPUNIT_ASSERT_EQUAL (5UL, history.undo_depth ());
+
+	history.undo (5);
+	CPPUNIT_ASSERT_EQUAL (0, value);
+}
+
+void
+UndoTest::testReloadSpilled ()
+{
+	int         value = 0;
+	UndoHistory history;
+
+	history.set_spill_file (spill_file ("reload.spill"));
+	history.set_memory_budget (budget);
+	history.set_reload_handler (std::bind (&reload_transaction, &value, std::placeholders::_1));
+
+	for (int n = 0; n < 5; ++n) {
+		history.add (make_transaction (value, n));
+	}
+
+	CPPUNIT_ASSERT_EQUAL (5, value);
+	CPPUNIT_ASSERT_EQUAL (4UL, history.spilled_depth ());
+	/* spilled transactions can be undone */
+	CPPUNIT_ASSERT_EQUAL (5UL, history.undo_depth ());
+
+	history.undo (2);
+	CPPUNIT_ASSERT_EQUAL (3, value);
+	CPPUNIT_ASSERT_EQUAL (3UL, history.spilled_depth ());
+	CPPUNIT_ASSERT_EQUAL (std::string ("t2"), history.next_undo ());
+
+	/* spill again, overwriting the record of the reloaded transaction */
+	history.add (make_transaction (value, 3));
+	history.add (make_transaction (value, 4));
+	CPPUNIT_ASSERT_EQUAL (5, value);
+	CPPUNIT_ASSERT_EQUAL (0UL, history.redo_depth ());
+	CPPUNIT_ASSERT_EQUAL (4UL, history.spilled_depth ());
+
+	history.undo (5);
+	CPPUNIT_ASSERT_EQUAL (0, value);
+	CPPUNIT_ASSERT_EQUAL (0UL, history.spilled_depth ());
+	CPPUNIT_ASSERT_EQUAL (0UL, history.undo_depth ());
+
+	history.redo (5);
+	CPPUNIT_ASSERT_EQUAL (5, value);
+}
+
+void
+UndoTest::testWriteState ()
+{
+	int         value = 0;
+	UndoHistory history;
+
+	history.set_spill_file (spill_file ("write.spill"));
+	history.set_memory_budget (budget);
+
+	for (int n = 0; n < 5; ++n) {
+		history.add (make_transaction (value, n));
+	}
+
+	CPPUNIT_ASSERT_EQUAL (4UL, history.spilled_depth ());
+
+	std::string const path = spill_file ("write.history");
+	CPPUNIT_ASSERT (history.write_state (path, -1));
+
+	XMLTree tree;
+	CPPUNIT_ASSERT (tree.read (path));
+	CPPUNIT_ASSERT_EQUAL (std::string ("UndoHistory"), tree.root ()->name ());
+	CPPUNIT_ASSERT_EQUAL ((size_t)5, tree.root ()->children ().size ());
+
+	/* spilled and in-memory transactions, oldest first */
+	int n = 0;
+	for (XMLNodeConstIterator i = tree.root ()->children ().begin (); i != tree.root ()->children ().end (); ++i, ++n) {
+		std::string name;
+		CPPUNIT_ASSERT ((*i)->get_property ("name", name));
+		CPPUNIT_ASSERT_EQUAL (string_compose ("t%1", n), name);
+	}
+
+	/* only the most recent transactions */
+	CPPUNIT_ASSERT (history.write_state (path, 2));
+	CPPUNIT_ASSERT (tree.read (path));
+	CPPUNIT_ASSERT_EQUAL ((size_t)2, tree.root ()->children ().size ());
+	std::string name;
+	CPPUNIT_ASSERT (tree.root ()->children ().front ()->get_property ("name", name));
+	CPPUNIT_ASSERT_EQUAL (std::string ("t3"), name);
+
+	/* restore the history from the file, and undo everything */
+	CPPUNIT_ASSERT (history.write_state (path, -1));
+	CPPUNIT_ASSERT (tree.read (path));
+
+	UndoHistory restored;
+	for (XMLNodeConstIterator i = tree.root ()->children ().begin (); i != tree.root ()->children ().end (); ++i) {
+		UndoTransaction* ut = reload_transaction (&value, **i);
+		CPPUNIT_ASSERT (ut);
+		restored.add (ut);
+	}
+
+	CPPUNIT_ASSERT_EQUAL (5UL, restored.undo_depth ());
+	restored.undo (5);
+	CPPUNIT_ASSERT_EQUAL (0, value);
+
+	::g_unlink (path.c_str ());
+}
@@ -0,0 +1,18 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class UndoTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (UndoTest);
+	CPPUNIT_TEST (testMemoryBudgetSpill);
+	CPPUNIT_TEST (testSpillFailure);
+	CPPUNIT_TEST (testReloadSpilled);
+	CPPUNIT_TEST (testWriteState);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testMemoryBudgetSpill ();
+	void testSpillFailure ();
+	void testReloadSpilled ();
+	void testWriteState ();
+};
@@ -304,3 +304,30 @@ XMLTest::testPerfLargeXMLDocument ()
 
 	test_xml_document ("testPerfLargeXMLDocument", node_options);
 }
+
+void
+XMLTest::testXMLNodeMemorySize ()
+{
+	XMLNode node ("Playlist");
+	node.set_property ("name", "Audio 1");
+
+	size_t const empty_size = node.memory_size ();
+	CPPUNIT_ASSERT (empty_size >= sizeof (XMLNode));
+
+	for (uint32_t i = 0; i < 64; ++i) {
+		XMLNode* region = new XMLNode ("Region");
+		region->set_property ("id", i);
+		region->set_property ("position", i * 48000);
+		region->set_property ("name", "Audio 1-1 with a rather long region name");
+		node.add_child_nocopy (*region);
+	}
+
+	size_t const full_size = node.memory_size ();
+	CPPUNIT_ASSERT (full_size > empty_size + 64 * (sizeof (XMLNode) + 3 * sizeof (XMLProperty)));
+
+	XMLNode copy (node);
+	CPPUNIT_ASSERT (copy.memory_size () > empty_size);
+
+	node.remove_nodes_and_delete ("Region");
+	CPPUNIT_ASSERT (node.memory_size () < full_size);
+}
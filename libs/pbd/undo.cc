@@ -21,19 +21,27 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cstdio>
 #include <sstream>
 #include <string>
 #include <time.h>
 
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/gstdio_compat.h"
 #include "pbd/undo.h"
 #include "pbd/xml++.h"
 
+#include "pbd/i18n.h"
+
 using namespace std;
 using namespace sigc;
 using namespace PBD;
 
 UndoTransaction::UndoTransaction ()
 	: _clearing (false)
+	, _command_size (0)
 {
 	gettimeofday (&_timestamp, 0);
 }
@@ -41,6 +49,7 @@ UndoTransaction::UndoTransaction ()
 UndoTransaction::UndoTransaction (const UndoTransaction& rhs)
 	: Command (rhs._name)
 	, _clearing (false)
+	, _command_size (0)
 {
 	_timestamp = rhs._timestamp;
 	clear ();
@@ -76,6 +85,7 @@ UndoTransaction::operator= (const UndoTransaction& rhs)
 	_name = rhs._name;
 	clear ();
 	actions.insert (actions.end (), rhs.actions.begin (), rhs.actions.end ());
+	_command_size = 0;
 	return *this;
 }
 
@@ -89,6 +99,7 @@ UndoTransaction::add_command (Command* const cmd)
 
 	cmd->DropReferences.connect_same_thread (*this, std::bind (&command_death, this, cmd));
 	actions.push_back (cmd);
+	_command_size = 0;
 }
 
 void
@@ -100,6 +111,7 @@ UndoTransaction::remove_command (Command* const action)
 	}
 	actions.erase (i);
 	delete action;
+	_command_size = 0;
 }
 
 bool
@@ -117,6 +129,7 @@ UndoTransaction::clear ()
 	}
 	actions.clear ();
 	_clearing = false;
+	_command_size = 0;
 }
 
 void
@@ -157,6 +170,18 @@ UndoTransaction::get_state () const
 	return *node;
 }
 
+size_t
+UndoTransaction::memory_size () const
+{
+	if (_command_size == 0) {
+		_command_size = sizeof (*this);
+		for (list<Command*>::const_iterator i = actions.begin (); i != actions.end (); ++i) {
+			_command_size += (*i)->memory_size ();
+		}
+	}
+	return _command_size;
+}
+
 class UndoRedoSignaller
 {
 public:
@@ -177,8 +202,18 @@ private:
 
 UndoHistory::UndoHistory ()
 {
-	_clearing = false;
-	_depth    = 0;
+	_clearing      = false;
+	_depth         = 0;
+	_memory_budget = 0;
+	_spill_end     = 0;
+	_spill_failed  = false;
+}
+
+UndoHistory::~UndoHistory ()
+{
+	if (!_spill_file.empty ()) {
+		::g_unlink (_spill_file.c_str ());
+	}
 }
 
 void
@@ -238,9 +273,185 @@ UndoHistory::add (UndoTransaction* const ut)
 
 	/* we are now owners of the transaction and must delete it when finished with it */
 
+	enforce_memory_budget ();
+
 	Changed (); /* EMIT SIGNAL */
 }
 
+void
+UndoHistory::set_memory_budget (size_t bytes)
+{
+	_memory_budget = bytes;
+	enforce_memory_budget ();
+}
+
+size_t
+UndoHistory::memory_used () const
+{
+	size_t s = 0;
+	for (std::list<UndoTransaction*>::const_iterator i = UndoList.begin (); i != UndoList.end (); ++i) {
+		s += (*i)->memory_size ();
+	}
+	for (std::list<UndoTransaction*>::const_iterator i = RedoList.begin (); i != RedoList.end (); ++i) {
+		s += (*i)->memory_size ();
+	}
+	return s;
+}
+
+void
+UndoHistory::enforce_memory_budget ()
+{
+	if (_memory_budget == 0) {
+		return;
+	}
+
+	size_t used = memory_used ();
+
+	/* always keep the most recent transaction, whatever its size */
+
+	while (used > _memory_budget && UndoList.size () > 1) {
+		UndoTransaction* ut = UndoList.front ();
+		if (!_spill_file.empty () && !spill (ut)) {
+			/* keep the transaction, rather than lose it */
+			if (!_spill_failed) {
+				error << string_compose (_("Cannot write undo history to \"%1\", it remains in memory."), _spill_file) << endmsg;
+				_spill_failed = true;
+			}
+			break;
+		}
+		_spill_failed = false;
+		used -= std::min (used, ut->memory_size ());
+		UndoList.pop_front ();
+		delete ut;
+	}
+}
+
+void
+UndoHistory::set_spill_file (std::string const& path)
+{
+	clear_spill ();
+
+	_spill_file = path;
+
+	/* remove any stale file left behind by a crash */
+	clear_spill ();
+}
+
+static int
+seek_to (FILE* f, int64_t pos)
+{
+#ifdef PLATFORM_WINDOWS
+	return _fseeki64 (f, pos, SEEK_SET);
+#else
+	return fseeko (f, (off_t) pos, SEEK_SET);
+#endif
+}
+
+/** @return the state of @p ut as XML text, without the XML declaration */
+static std::string
+serialize (UndoTransaction const& ut)
+{
+	XMLTree tree;
+	tree.set_root (&ut.get_state ());
+
+	std::string rv = tree.write_buffer ();
+
+	std::string::size_type e = rv.find ("?>");
+	if (rv.compare (0, 5, "<?xml") == 0 && e != std::string::npos) {
+		rv.erase (0, e + 2);
+	}
+
+	/* the caller adds a single newline after each transaction */
+	while (!rv.empty () && (rv[0] == '\n' || rv[0] == '\r')) {
+		rv.erase (0, 1);
+	}
+	while (!rv.empty () && (rv[rv.size () - 1] == '\n' || rv[rv.size () - 1] == '\r')) {
+		rv.erase (rv.size () - 1);
+	}
+
+	return rv;
+}
+
+bool
+UndoHistory::spill (UndoTransaction const* ut)
+{
+	if (_spill_file.empty ()) {
+		return false;
+	}
+
+	std::string const xml (serialize (*ut));
+
+	/* records of reloaded transactions are overwritten */
+	FILE* f = g_fopen (_spill_file.c_str (), _spill_end > 0 ? "r+b" : "wb");
+	if (!f) {
+		return false;
+	}
+
+	bool ok = seek_to (f, _spill_end) == 0 && fwrite (xml.c_str (), 1, xml.size (), f) == xml.size () && fputc ('\n', f) != EOF;
+	ok = (fclose (f) == 0) && ok;
+
+	if (ok) {
+		_spilled.push_back (SpillRecord (ut->name (), _spill_end, xml.size () + 1));
+		_spill_end += xml.size () + 1;
+	}
+	return ok;
+}
+
+/** Re-create the most recently spilled transaction and
+ *  put it back at the front of the undo list.
+ */
+bool
+UndoHistory::reload_spilled ()
+{
+	if (_spilled.empty () || !_reload) {
+		return false;
+	}
+
+	SpillRecord const& r (_spilled.back ());
+
+	std::string xml (r.size, '\0');
+	FILE* in = g_fopen (_spill_file.c_str (), "rb");
+	bool  ok = in && seek_to (in, r.offset) == 0 && fread (&xml[0], 1, r.size, in) == r.size;
+	if (in) {
+		fclose (in);
+	}
+
+	UndoTransaction* ut = 0;
+	XMLTree          tree;
+
+	if (ok && tree.read_buffer (xml.c_str ()) && tree.root ()) {
+		try {
+			ut = _reload (*tree.root ());
+		} catch (std::exception const& e) {
+			error << string_compose (_("Error reloading undo transaction (%1)"), e.what ()) << endmsg;
+		}
+	}
+
+	if (!ut) {
+		error << string_compose (_("Cannot reload undo transaction \"%1\" from \"%2\""), r.name, _spill_file) << endmsg;
+		return false;
+	}
+
+	_spill_end = r.offset;
+	_spilled.pop_back ();
+
+	ut->DropReferences.connect_same_thread (*this, std::bind (&UndoHistory::remove, this, ut));
+	UndoList.push_front (ut);
+	return true;
+}
+
+void
+UndoHistory::clear_spill ()
+{
+	_spilled.clear ();
+	_spill_end    = 0;
+	_spill_failed = false;
+
+	if (!_spill_file.empty ()) {
+		::g_unlink (_spill_file.c_str ());
+	}
+}
+
 void
 UndoHistory::remove (UndoTransaction* const ut)
 {
@@ -268,7 +479,7 @@ UndoHistory::undo (unsigned int n)
 		UndoRedoSignaller exception_safe_signaller (*this);
 
 		while (n--) {
-			if (UndoList.size () == 0) {
+			if (UndoList.size () == 0 && !reload_spilled ()) {
 				return;
 			}
 			UndoTransaction* ut = UndoList.back ();
@@ -328,6 +539,8 @@ UndoHistory::clear_undo ()
 	UndoList.clear ();
 	_clearing = false;
 
+	clear_spill ();
+
 	Changed (); /* EMIT SIGNAL */
 }
 
@@ -371,3 +584,63 @@ UndoHistory::get_state (int32_t depth)
 
 	return *node;
 }
+
+bool
+UndoHistory::write_state (std::string const& path, int32_t depth)
+{
+	/* collect the (at most depth) most recent transactions,
+	 * first from memory, then from the spill file.
+	 */
+	std::list<UndoTransaction*> in_order;
+	size_t                      n_spilled = 0;
+
+	if (depth < 0) {
+		in_order  = UndoList;
+		n_spilled = _spilled.size ();
+	} else if (depth > 0) {
+		for (list<UndoTransaction*>::reverse_iterator it = UndoList.rbegin (); it != UndoList.rend () && depth; ++it, depth--) {
+			in_order.push_front (*it);
+		}
+		n_spilled = std::min ((size_t) depth, _spilled.size ());
+	}
+
+	FILE* out = g_fopen (path.c_str (), "wb");
+	if (!out) {
+		return false;
+	}
+
+	static const char header[] = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<UndoHistory>\n";
+	static const char footer[] = "</UndoHistory>\n";
+
+	bool ok = fputs (header, out) >= 0;
+
+	if (ok && n_spilled > 0) {
+		FILE* in = g_fopen (_spill_file.c_str (), "rb");
+		ok       = in != 0;
+
+		char buf[8192];
+		for (size_t i = _spilled.size () - n_spilled; ok && i < _spilled.size (); ++i) {
+			size_t len = _spilled[i].size;
+			ok = seek_to (in, _spilled[i].offset) == 0;
+			while (ok && len > 0) {
+				size_t n = fread (buf, 1, std::min (len, sizeof (buf)), in);
+				ok = n > 0 && fwrite (buf, 1, n, out) == n;
+				len -= n;
+			}
+		}
+
+		if (in) {
+			fclose (in);
+		}
+	}
+
+	for (list<UndoTransaction*>::const_iterator it = in_order.begin (); ok && it != in_order.end (); ++it) {
+		std::string const xml (serialize (**it));
+		ok = fwrite (xml.c_str (), 1, xml.size (), out) == xml.size () && fputc ('\n', out) != EOF;
+	}
+
+	ok = ok && fputs (footer, out) >= 0;
+	ok = (fclose (out) == 0) && ok;
+
+	return ok;
+}
@@ -846,3 +846,21 @@ XMLNode::dump (ostream& s, string p) const
 		s << p << "</" << _name << ">\n";
 	}
 }
+
+size_t
+XMLNode::memory_size () const
+{
+	size_t s = sizeof (XMLNode) + _name.capacity () + _content.capacity ();
+
+	s += _proplist.capacity () * sizeof (XMLProperty*);
+	for (XMLPropertyList::const_iterator i = _proplist.begin(); i != _proplist.end(); ++i) {
+		s += sizeof (XMLProperty) + (*i)->name().capacity () + (*i)->value().capacity ();
+	}
+
+	s += _children.capacity () * sizeof (XMLNode*);
+	for (XMLNodeList::const_iterator i = _children.begin(); i != _children.end(); ++i) {
+		s += (*i)->memory_size ();
+	}
+
+	return s;
+}
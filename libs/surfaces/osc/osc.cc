@@ -127,6 +127,14 @@ OSC::OSC (Session& s, uint32_t port)
 	, scrub_time (0)
 	, global_init (true)
 	, _zeroconf (0)
+	, _bundle (0)
+	, _bundle_addr (0)
+	, _bundle_ok (true)
+	, _sent_messages (0)
+	, _received_messages (0)
+	, _sent_rate (0)
+	, _received_rate (0)
+	, _rate_time (0)
 	, gui (0)
 {
 	_instance = this;
@@ -638,7 +646,9 @@ bool
 OSC::osc_input_handler (IOCondition ioc, lo_server srv)
 {
 	if (ioc & IO_IN) {
-		lo_server_recv (srv);
+		if (lo_server_recv (srv) > 0) {
+			_received_messages.fetch_add (1);
+		}
 	}
 
 	if (ioc & ~(IO_IN|IO_PRI)) {
@@ -750,9 +760,9 @@ OSC::send_current_value (const char* path, lo_arg** argv, int argc, lo_message m
 	OSCSurface *sur = get_surface(get_address (msg));
 
 	if (sur->feedback[14]) {
-		lo_send_message (get_address (msg), X_("/reply"), reply);
+		send_message (get_address (msg), X_("/reply"), reply);
 	} else {
-		lo_send_message (get_address (msg), X_("#reply"), reply);
+		send_message (get_address (msg), X_("#reply"), reply);
 	}
 	lo_message_free (reply);
 }
@@ -1103,9 +1113,9 @@ OSC::routes_list (lo_message msg)
 				lo_message_add_int32 (reply, s->rec_enable_control()->get_value());
 			}
 			if (sur->feedback[14]) {
-				lo_send_message (get_address (msg), X_("/reply"), reply);
+				send_message (get_address (msg), X_("/reply"), reply);
 			} else {
-				lo_send_message (get_address (msg), X_("#reply"), reply);
+				send_message (get_address (msg), X_("#reply"), reply);
 			}
 			lo_message_free (reply);
 		}
@@ -1125,9 +1135,9 @@ OSC::routes_list (lo_message msg)
 	}
 
 	if (sur->feedback[14]) {
-		lo_send_message (get_address (msg), X_("/reply"), reply);
+		send_message (get_address (msg), X_("/reply"), reply);
 	} else {
-		lo_send_message (get_address (msg), X_("#reply"), reply);
+		send_message (get_address (msg), X_("#reply"), reply);
 	}
 
 	lo_message_free (reply);
@@ -1758,7 +1768,7 @@ OSC::surface_parse (const char *path, const char* types, lo_arg **argv, int argc
 					lo_message_add_int32 (reply, (int) linkset);
 					lo_message_add_int32 (reply, (int) linkid);
 					lo_message_add_int32 (reply, (int) port);
-					lo_send_message (get_address (msg), X_("/set_surface"), reply);
+					send_message (get_address (msg), X_("/set_surface"), reply);
 					lo_message_free (reply);
 					return 0;
 				}
@@ -2093,6 +2103,9 @@ OSC::get_surface (lo_address addr , bool quiet)
 	s.plugin_id = 1;
 	s.linkset = 0;
 	s.linkid = 1;
+	s.feedback_interval = 1;
+	s.feedback_countdown = 1;
+	s.feedback_good = 0;
 
 	s.nstrips = s.strips.size();
 	{
@@ -2248,7 +2261,7 @@ OSC::_recalcbanks ()
 			// This surface uses /strip/list tell it routes have changed
 			lo_message reply;
 			reply = lo_message_new ();
-			lo_send_message (addr, X_("/strip/list"), reply);
+			send_message (addr, X_("/strip/list"), reply);
 			lo_message_free (reply);
 		} else {
 			strip_feedback (sur, false);
@@ -2390,7 +2403,7 @@ OSC::bank_leds (OSCSurface* s)
 		} else {
 			lo_message_add_int32 (reply, 1);
 		}
-		lo_send_message (addr, X_("/bank_up"), reply);
+		send_message (addr, X_("/bank_up"), reply);
 		lo_message_free (reply);
 		reply = lo_message_new ();
 		if (bank > 1) {
@@ -2398,7 +2411,7 @@ OSC::bank_leds (OSCSurface* s)
 		} else {
 			lo_message_add_int32 (reply, 0);
 		}
-		lo_send_message (addr, X_("/bank_down"), reply);
+		send_message (addr, X_("/bank_down"), reply);
 		lo_message_free (reply);
 	}
 }
@@ -2966,7 +2979,7 @@ OSC::transport_sample (lo_message msg)
 	lo_message reply = lo_message_new ();
 	lo_message_add_int64 (reply, pos);
 
-	lo_send_message (get_address (msg), X_("/transport_frame"), reply);
+	send_message (get_address (msg), X_("/transport_frame"), reply);
 
 	lo_message_free (reply);
 }
@@ -2983,7 +2996,7 @@ OSC::transport_speed (lo_message msg)
 	lo_message reply = lo_message_new ();
 	lo_message_add_double (reply, ts);
 
-	lo_send_message (get_address (msg), X_("/transport_speed"), reply);
+	send_message (get_address (msg), X_("/transport_speed"), reply);
 
 	lo_message_free (reply);
 }
@@ -3000,7 +3013,7 @@ OSC::record_enabled (lo_message msg)
 	lo_message reply = lo_message_new ();
 	lo_message_add_int32 (reply, re);
 
-	lo_send_message (get_address (msg), X_("/record_enabled"), reply);
+	send_message (get_address (msg), X_("/record_enabled"), reply);
 
 	lo_message_free (reply);
 }
@@ -3144,7 +3157,7 @@ OSC::trigger_bank_state (lo_address addr)
 	lo_message_add_int32 (bank_msg, _tbank_start_route);  //route start offs
 	lo_message_add_int32 (bank_msg, TriggerBox::default_triggers_per_box);  //total avail triggers
 	lo_message_add_int32 (bank_msg, _tbank_start_row);  //trigger start offs
-	lo_send_message (addr, X_("/trigger_grid/bank"), bank_msg);
+	send_message (addr, X_("/trigger_grid/bank"), bank_msg);
 	lo_message_free (bank_msg);
 
 	return 0;
@@ -3161,7 +3174,7 @@ OSC::trigger_grid_state (lo_address addr, bool zero_it)
 		for (int row = 0; row < 8; row++) { //ToDo: trigger bank size
 			lo_message_add_int32 (trig_msg, zero_it ? -1 : trigger_display_at(rt, row).state);  // -1 = empty; 0 stopped; 1 playing
 		}
-		lo_send_message (addr, string_compose(X_("/trigger_grid/%1/state"), rt).c_str(), trig_msg);
+		send_message (addr, string_compose(X_("/trigger_grid/%1/state"), rt).c_str(), trig_msg);
 		lo_message_free (trig_msg);
 	}
 	return 0;
@@ -3180,7 +3193,7 @@ OSC::mixer_scene_state (lo_address addr, bool zero_it)
 		} else {
 			lo_message_add_string (scene_msg, "");
 		}
-		lo_send_message (addr, string_compose(X_("/mixer_scene/%1/name"), scn).c_str(), scene_msg);
+		send_message (addr, string_compose(X_("/mixer_scene/%1/name"), scn).c_str(), scene_msg);
 		lo_message_free (scene_msg);
 	}
 	return 0;
@@ -3280,7 +3293,7 @@ OSC::send_group_list (lo_address addr)
 		RouteGroup *rg = *i;
 		lo_message_add_string (reply, rg->name().c_str());
 	}
-	lo_send_message (addr, X_("/group/list"), reply);
+	send_message (addr, X_("/group/list"), reply);
 	lo_message_free (reply);
 	return 0;
 }
@@ -3343,7 +3356,7 @@ OSC::route_get_sends(lo_message msg) {
 	}
 	// if used dedicated message path to identify this reply in async operation.
 	// Naming it #reply wont help the client to identify the content.
-	lo_send_message(get_address (msg), X_("/strip/sends"), reply);
+	send_message (get_address (msg), X_("/strip/sends"), reply);
 
 	lo_message_free(reply);
 
@@ -3405,7 +3418,7 @@ OSC::route_get_receives(lo_message msg) {
 
 	// I have used a dedicated message path to identify this reply in async operation.
 	// Naming it #reply wont help the client to identify the content.
-	lo_send_message(get_address (msg), X_("/strip/receives"), reply);
+	send_message (get_address (msg), X_("/strip/receives"), reply);
 	lo_message_free(reply);
 	return 0;
 }
@@ -4156,7 +4169,7 @@ OSC::_strip_parse (const char *path, const char *sub_path, const char* types, lo
 						lo_message_add_string (rmsg, v->name().c_str());
 					}
 				}
-				lo_send_message (get_address (msg), path, rmsg);
+				send_message (get_address (msg), path, rmsg);
 				lo_message_free (rmsg);
 				_lo_lock.unlock ();
 				ret = 0;
@@ -4189,7 +4202,7 @@ OSC::_strip_parse (const char *path, const char *sub_path, const char* types, lo
 			//lo_message_add_string (rmsg, val.c_str());
 			lo_message_add_string (rmsg, " ");
 		}
-		lo_send_message (get_address (msg), path, rmsg);
+		send_message (get_address (msg), path, rmsg);
 		lo_message_free (rmsg);
 		_lo_lock.unlock ();
 	}
@@ -4277,7 +4290,7 @@ OSC::strip_state (const char *path, std::shared_ptr<ARDOUR::Stripable> s, int ss
 	} else {
 		lo_message_add_int32 (reply, -1);
 	}
-	lo_send_message (get_address (msg), X_(path), reply);
+	send_message (get_address (msg), X_(path), reply);
 	lo_message_free (reply);
 	return 0;
 }
@@ -5298,7 +5311,7 @@ OSC::route_plugin_list (int ssid, lo_message msg) {
 		piid++;
 	}
 
-	lo_send_message (get_address (msg), X_("/strip/plugin/list"), reply);
+	send_message (get_address (msg), X_("/strip/plugin/list"), reply);
 	lo_message_free (reply);
 	return 0;
 }
@@ -5418,14 +5431,14 @@ OSC::route_plugin_descriptor (int ssid, int piid, lo_message msg) {
 			lo_message_add_double (reply, 0);
 		}
 
-		lo_send_message (get_address (msg), X_("/strip/plugin/descriptor"), reply);
+		send_message (get_address (msg), X_("/strip/plugin/descriptor"), reply);
 		lo_message_free (reply);
 	}
 
 	lo_message reply = lo_message_new ();
 	lo_message_add_int32 (reply, ssid);
 	lo_message_add_int32 (reply, piid);
-	lo_send_message (get_address (msg), X_("/strip/plugin/descriptor_end"), reply);
+	send_message (get_address (msg), X_("/strip/plugin/descriptor_end"), reply);
 	lo_message_free (reply);
 
 	return 0;
@@ -6024,6 +6037,13 @@ OSC::periodic (void)
 	}
 	for (uint32_t it = 0; it < _surface.size(); it++) {
 		OSCSurface* sur = &_surface[it];
+		if (sur->feedback_countdown > 1) {
+			--sur->feedback_countdown;
+			continue;
+		}
+		sur->feedback_countdown = sur->feedback_interval;
+
+		begin_bundle (sur);
 		OSCSelectObserver* so;
 		if ((so = dynamic_cast<OSCSelectObserver*>(sur->sel_obs)) != 0) {
 			so->tick ();
@@ -6041,6 +6061,25 @@ OSC::periodic (void)
 				ro->tick ();
 			}
 		}
+
+		/* back off while the surface can not keep up (or is gone),
+		 * and slowly return to full rate once it does again.
+		 */
+		if (!end_bundle ()) {
+			sur->feedback_interval = std::min<uint32_t> (sur->feedback_interval * 2, 8);
+			sur->feedback_good = 0;
+		} else if (sur->feedback_interval > 1 && ++sur->feedback_good >= 50) {
+			sur->feedback_interval /= 2;
+			sur->feedback_good = 0;
+		}
+	}
+
+	int64_t now = PBD::get_microseconds ();
+	if (now - _rate_time >= 1000000) {
+		float secs = (now - _rate_time) / 1e6f;
+		_sent_rate.store (_sent_messages.exchange (0) / secs);
+		_received_rate.store (_received_messages.exchange (0) / secs);
+		_rate_time = now;
 	}
 	for (FakeTouchMap::iterator x = _touch_timeout.begin(); x != _touch_timeout.end();) {
 		_touch_timeout[(*x).first] = (*x).second - 1;
@@ -6613,24 +6652,19 @@ OSC::cue_send_enable (uint32_t id, float state, lo_message msg)
 int
 OSC::float_message (string path, float val, lo_address addr)
 {
-	_lo_lock.lock ();
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
 
 	lo_message reply;
 	reply = lo_message_new ();
 	lo_message_add_float (reply, (float) val);
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
-	_lo_lock.unlock ();
-
-	return 0;
+	return queue_message (path, reply, addr);
 }
 
 int
 OSC::float_message_with_id (std::string path, uint32_t ssid, float value, bool in_line, lo_address addr)
 {
-	_lo_lock.lock ();
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
 	lo_message msg = lo_message_new ();
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
@@ -6639,34 +6673,25 @@ OSC::float_message_with_id (std::string path, uint32_t ssid, float value, bool i
 	}
 	lo_message_add_float (msg, value);
 
-	lo_send_message (addr, path.c_str(), msg);
-	Glib::usleep(1);
-	lo_message_free (msg);
-	_lo_lock.unlock ();
-	return 0;
+	return queue_message (path, msg, addr);
 }
 
 int
 OSC::int_message (string path, int val, lo_address addr)
 {
-	_lo_lock.lock ();
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
 
 	lo_message reply;
 	reply = lo_message_new ();
 	lo_message_add_int32 (reply, (float) val);
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
-	_lo_lock.unlock ();
-
-	return 0;
+	return queue_message (path, reply, addr);
 }
 
 int
 OSC::int_message_with_id (std::string path, uint32_t ssid, int value, bool in_line, lo_address addr)
 {
-	_lo_lock.lock ();
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
 	lo_message msg = lo_message_new ();
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
@@ -6675,34 +6700,25 @@ OSC::int_message_with_id (std::string path, uint32_t ssid, int value, bool in_li
 	}
 	lo_message_add_int32 (msg, value);
 
-	lo_send_message (addr, path.c_str(), msg);
-	Glib::usleep(1);
-	lo_message_free (msg);
-	_lo_lock.unlock ();
-	return 0;
+	return queue_message (path, msg, addr);
 }
 
 int
 OSC::text_message (string path, string val, lo_address addr)
 {
-	_lo_lock.lock ();
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
 
 	lo_message reply;
 	reply = lo_message_new ();
 	lo_message_add_string (reply, val.c_str());
 
-	lo_send_message (addr, path.c_str(), reply);
-	Glib::usleep(1);
-	lo_message_free (reply);
-	_lo_lock.unlock ();
-
-	return 0;
+	return queue_message (path, reply, addr);
 }
 
 int
 OSC::text_message_with_id (std::string path, uint32_t ssid, std::string val, bool in_line, lo_address addr)
 {
-	_lo_lock.lock ();
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
 	lo_message msg = lo_message_new ();
 	if (in_line) {
 		path = string_compose ("%1/%2", path, ssid);
@@ -6712,13 +6728,92 @@ OSC::text_message_with_id (std::string path, uint32_t ssid, std::string val, boo
 
 	lo_message_add_string (msg, val.c_str());
 
-	lo_send_message (addr, path.c_str(), msg);
+	return queue_message (path, msg, addr);
+}
+
+int
+OSC::send_message (lo_address addr, const char* path, lo_message msg)
+{
+	_sent_messages.fetch_add (1);
+	return lo_send_message (addr, path, msg);
+}
+
+static bool
+same_address (lo_address a, lo_address b)
+{
+	if (a == b) {
+		return true;
+	}
+	const char* ha = lo_address_get_hostname (a);
+	const char* hb = lo_address_get_hostname (b);
+	const char* pa = lo_address_get_port (a);
+	const char* pb = lo_address_get_port (b);
+	if (!ha || !hb || !pa || !pb) {
+		return false;
+	}
+	return !strcmp (ha, hb) && !strcmp (pa, pb);
+}
+
+/* takes ownership of msg, _lo_lock must be held */
+int
+OSC::queue_message (std::string const& path, lo_message msg, lo_address addr)
+{
+	if (_bundle && same_address (addr, _bundle_addr)) {
+		/* the bundle may only reference the path */
+		_bundle_paths.push_back (path);
+		lo_bundle_add_message (_bundle, _bundle_paths.back ().c_str (), msg);
+		if (_bundle_paths.size () >= 64) {
+			// keep bundles small enough for a single UDP packet
+			flush_bundle ();
+		}
+		return 0;
+	}
+
+	send_message (addr, path.c_str (), msg);
 	Glib::usleep(1);
 	lo_message_free (msg);
-	_lo_lock.unlock ();
 	return 0;
 }
 
+void
+OSC::begin_bundle (OSCSurface* sur)
+{
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
+	_bundle_addr = lo_address_new_from_url (sur->remote_url.c_str ());
+	_bundle = lo_bundle_new (LO_TT_IMMEDIATE);
+	_bundle_ok = true;
+}
+
+/* _lo_lock must be held */
+void
+OSC::flush_bundle ()
+{
+	if (!_bundle_paths.empty ()) {
+		if (lo_send_bundle (_bundle_addr, _bundle) < 0) {
+			_bundle_ok = false;
+		} else {
+			_sent_messages.fetch_add (_bundle_paths.size ());
+		}
+	}
+	/* this also frees the messages */
+	lo_bundle_free_messages (_bundle);
+	_bundle_paths.clear ();
+	_bundle = lo_bundle_new (LO_TT_IMMEDIATE);
+}
+
+/* @return false if any part of the bundle could not be sent */
+bool
+OSC::end_bundle ()
+{
+	Glib::Threads::Mutex::Lock lm (_lo_lock);
+	flush_bundle ();
+	lo_bundle_free_messages (_bundle);
+	_bundle = 0;
+	lo_address_free (_bundle_addr);
+	_bundle_addr = 0;
+	return _bundle_ok;
+}
+
 // we have to have a sorted list of stripables that have sends pointed at our aux
 // we can use the one in osc.cc to get an aux list
 OSC::Sorted
@@ -25,7 +25,9 @@
 #ifndef ardour_osc_h
 #define ardour_osc_h
 
+#include <atomic>
 #include <bitset>
+#include <list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -102,6 +104,11 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	int float_message_with_id (std::string, uint32_t ssid, float value, bool in_line, lo_address addr);
 	int int_message_with_id (std::string, uint32_t ssid, int value, bool in_line, lo_address addr);
 	int text_message_with_id (std::string path, uint32_t ssid, std::string val, bool in_line, lo_address addr);
+	int send_message (lo_address addr, const char* path, lo_message msg);
+
+	/* message rates, updated once a second */
+	uint32_t sent_per_second () const { return _sent_rate.load (); }
+	uint32_t received_per_second () const { return _received_rate.load (); }
 
 	int send_group_list (lo_address addr);
 
@@ -171,6 +178,9 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 		OSCCueObserver* cue_obs;	// pointer to this surface's cue observer
 		uint32_t linkset;			// ID of a set of surfaces used as one
 		uint32_t linkid;			// ID of this surface within a linkset
+		uint32_t feedback_interval;	// periodic feedback is sent every n ticks
+		uint32_t feedback_countdown;	// ticks until the next periodic feedback
+		uint32_t feedback_good;		// feedback bundles sent without error at this interval
 	};
 		/*
 		 * feedback bits:
@@ -763,6 +773,22 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	int osc_toggle_roll (bool ret2strt);
 	bool periodic (void);
 	sigc::connection periodic_connection;
+
+	/* feedback sent from periodic () is collected in one bundle per surface */
+	int queue_message (std::string const& path, lo_message msg, lo_address addr);
+	void begin_bundle (OSCSurface* sur);
+	bool end_bundle ();
+	void flush_bundle ();
+	lo_bundle _bundle;
+	lo_address _bundle_addr;
+	bool _bundle_ok;
+	std::list<std::string> _bundle_paths;
+
+	std::atomic<uint32_t> _sent_messages;
+	std::atomic<uint32_t> _received_messages;
+	std::atomic<uint32_t> _sent_rate;
+	std::atomic<uint32_t> _received_rate;
+	int64_t _rate_time;
 	PBD::ScopedConnectionList session_connections;
 
 	void debugmsg (const char *prefix, const char *path, const char* types, lo_arg **argv, int argc);
@@ -17,6 +17,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cmath>
+
 #include "pbd/control_math.h"
 
 #include "ardour/amp.h"
@@ -46,6 +48,9 @@ OSCGlobalObserver::OSCGlobalObserver (OSC& o, Session& s, ArdourSurface::OSC::OS
 	,_last_master_trim (-1.0)
 	,_last_monitor_gain (-1.0)
 	,_jog_mode (1024)
+	,_last_meter (-200)
+	,_last_ledbits (-1)
+	,_last_signal (-1)
 	,last_punchin (4)
 	,last_punchout (4)
 	,last_click (4)
@@ -333,30 +338,32 @@ OSCGlobalObserver::tick ()
 		// the only meter here is master
 		float now_meter = session->master_out()->peak_meter()->meter_level(0, MeterMCP);
 		if (now_meter < -94) now_meter = -193;
-		if (_last_meter != now_meter) {
-			if (feedback[7] || feedback[8]) {
-				if (gainmode && feedback[7]) {
+		/* only send what the surface would display differently */
+		if (feedback[7]) {
+			if (fabsf (now_meter - _last_meter) >= 0.1) {
+				if (gainmode) {
 					// change from db to 0-1
 					_osc.float_message (X_("/master/meter"), ((now_meter + 94) / 100), addr);
-				} else if ((!gainmode) && feedback[7]) {
+				} else {
 					_osc.float_message (X_("/master/meter"), now_meter, addr);
-				} else if (feedback[8]) {
-					uint32_t ledlvl = (uint32_t)(((now_meter + 54) / 3.75)-1);
-					uint32_t ledbits = ~(0xfff<<ledlvl);
-					_osc.float_message (X_("/master/meter"), ledbits, addr);
 				}
+				_last_meter = now_meter;
 			}
-			if (feedback[9]) {
-				float signal;
-				if (now_meter < -40) {
-					signal = 0;
-				} else {
-					signal = 1;
-				}
+		} else if (feedback[8]) {
+			uint32_t ledlvl = (uint32_t)(((now_meter + 54) / 3.75)-1);
+			uint32_t ledbits = ~(0xfff<<ledlvl);
+			if ((int64_t) ledbits != _last_ledbits) {
+				_osc.float_message (X_("/master/meter"), ledbits, addr);
+				_last_ledbits = ledbits;
+			}
+		}
+		if (feedback[9]) {
+			int signal = now_meter < -40 ? 0 : 1;
+			if (signal != _last_signal) {
 				_osc.float_message (X_("/master/signal"), signal, addr);
+				_last_signal = signal;
 			}
 		}
-		_last_meter = now_meter;
 
 	}
 	if (feedback[4]) {
@@ -72,6 +72,8 @@ class OSCGlobalObserver
 	samplepos_t _last_sample;
 	uint32_t _heartbeat;
 	float _last_meter;
+	int64_t _last_ledbits;
+	int _last_signal;
 	uint32_t master_timeout;
 	uint32_t monitor_timeout;
 	uint32_t last_punchin;
@@ -24,6 +24,8 @@
 
 #include <errno.h>
 
+#include <glibmm/main.h>
+
 #include "pbd/file_utils.h"
 
 #include <ytkmm/box.h>
@@ -161,6 +163,15 @@ OSC_GUI::OSC_GUI (OSC& p)
 	debug_combo.set_active ((int)cp.get_debug_mode());
 	++n;
 
+	// message rates
+	label = manage (new Gtk::Label(_("Messages/s:")));
+	label->set_alignment(1, .5);
+	table->attach (*label, 0, 1, n, n+1, AttachOptions(FILL|EXPAND), AttachOptions(0));
+	table->attach (traffic_label, 1, 2, n, n+1, AttachOptions(FILL|EXPAND), AttachOptions(0), 0, 0);
+	update_traffic ();
+	traffic_connection = Glib::signal_timeout().connect (sigc::mem_fun (*this, &OSC_GUI::update_traffic), 1000);
+	++n;
+
 	// Preset loader combo
 	label = manage (new Gtk::Label(_("Preset:")));
 	label->set_alignment(1, .5);
@@ -446,6 +457,14 @@ OSC_GUI::OSC_GUI (OSC& p)
 
 OSC_GUI::~OSC_GUI ()
 {
+	traffic_connection.disconnect ();
+}
+
+bool
+OSC_GUI::update_traffic ()
+{
+	traffic_label.set_text (string_compose (_("%1 sent, %2 received"), cp.sent_per_second (), cp.received_per_second ()));
+	return true;
 }
 
 // static directory and file handling stuff
@@ -44,6 +44,9 @@ public:
 private:
 	// settings page
 	Gtk::ComboBoxText debug_combo;
+	Gtk::Label traffic_label;
+	sigc::connection traffic_connection;
+	bool update_traffic ();
 	Gtk::ComboBoxText portmode_combo;
 	Gtk::SpinButton port_entry;
 	Gtk::SpinButton bank_entry;
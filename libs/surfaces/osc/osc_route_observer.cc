@@ -19,6 +19,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cmath>
+
 #include "pbd/control_math.h"
 #include <glibmm.h>
 
@@ -50,6 +52,9 @@ OSCRouteObserver::OSCRouteObserver (OSC& o, uint32_t ss, ArdourSurface::OSC::OSC
 	: _osc (o)
 	,ssid (ss)
 	,sur (su)
+	,_last_meter (-200)
+	,_last_ledbits (-1)
+	,_last_signal (-1)
 	,_last_gain (-1.0)
 	,_last_trim (-1.0)
 	,_init (true)
@@ -119,6 +124,9 @@ OSCRouteObserver::refresh_strip (std::shared_ptr<ARDOUR::Stripable> new_strip, b
 	}
 	_last_gain =-1.0;
 	_last_trim =-1.0;
+	_last_meter = -200;
+	_last_ledbits = -1;
+	_last_signal = -1;
 	_send = std::shared_ptr<ARDOUR::Send> ();
 
 	send_select_status (ARDOUR::Properties::selected);
@@ -232,6 +240,9 @@ OSCRouteObserver::refresh_send (std::shared_ptr<ARDOUR::Send> new_send, bool for
 	}
 	_last_gain =-1.0;
 	_last_trim =-1.0;
+	_last_meter = -200;
+	_last_ledbits = -1;
+	_last_signal = -1;
 
 	send_select_status (ARDOUR::Properties::selected);
 
@@ -392,29 +403,31 @@ OSCRouteObserver::tick ()
 			now_meter = -193;
 		}
 		if (now_meter < -120) now_meter = -193;
-		if (_last_meter != now_meter) {
-			if (feedback[7] || feedback[8]) {
-				if (gainmode && feedback[7]) {
+		/* only send what the surface would display differently */
+		if (feedback[7]) {
+			if (fabsf (now_meter - _last_meter) >= 0.1) {
+				if (gainmode) {
 					_osc.float_message_with_id (X_("/strip/meter"), ssid, ((now_meter + 94) / 100), in_line, addr);
-				} else if ((!gainmode) && feedback[7]) {
+				} else {
 					_osc.float_message_with_id (X_("/strip/meter"), ssid, now_meter, in_line, addr);
-				} else if (feedback[8]) {
-					uint32_t ledlvl = (uint32_t)(((now_meter + 54) / 3.75)-1);
-					uint16_t ledbits = ~(0xfff<<ledlvl);
-					_osc.int_message_with_id (X_("/strip/meter"), ssid, ledbits, in_line, addr);
 				}
+				_last_meter = now_meter;
 			}
-			if (feedback[9]) {
-				float signal;
-				if (now_meter < -40) {
-					signal = 0;
-				} else {
-					signal = 1;
-				}
+		} else if (feedback[8]) {
+			uint32_t ledlvl = (uint32_t)(((now_meter + 54) / 3.75)-1);
+			uint16_t ledbits = ~(0xfff<<ledlvl);
+			if (ledbits != _last_ledbits) {
+				_osc.int_message_with_id (X_("/strip/meter"), ssid, ledbits, in_line, addr);
+				_last_ledbits = ledbits;
+			}
+		}
+		if (feedback[9]) {
+			int signal = now_meter < -40 ? 0 : 1;
+			if (signal != _last_signal) {
 				_osc.float_message_with_id (X_("/strip/signal"), ssid, signal, in_line, addr);
+				_last_signal = signal;
 			}
 		}
-		_last_meter = now_meter;
 
 	}
 	if (feedback[1]) {
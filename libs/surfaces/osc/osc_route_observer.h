@@ -68,6 +68,8 @@ class OSCRouteObserver
 	uint32_t ssid;
 	ArdourSurface::OSC::OSCSurface* sur;
 	float _last_meter;
+	int _last_ledbits;
+	int _last_signal;
 	uint32_t gain_timeout;
 	float _last_gain;
 	float _last_trim;
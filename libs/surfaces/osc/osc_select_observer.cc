@@ -1188,6 +1188,6 @@ OSCSelectObserver::slaved_changed (std::shared_ptr<VCA> vca, bool state)
 			lo_message_add_string (reply, name.c_str());
 		}
 	}
-	lo_send_message (addr, X_("/select/vcas"), reply);
+	_osc.send_message (addr, X_("/select/vcas"), reply);
 	lo_message_free (reply);
 }
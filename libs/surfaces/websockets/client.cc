@@ -22,6 +22,28 @@
 
 using namespace ArdourSurface;
 
+void
+ClientOutputBuffer::push (const NodeState& state)
+{
+	QueueIndex::iterator it = _index.find (state);
+
+	if (it != _index.end ()) {
+		*it->second = state;
+		return;
+	}
+
+	_index[state] = _queue.insert (_queue.end (), state);
+}
+
+NodeState
+ClientOutputBuffer::pop ()
+{
+	NodeState state = _queue.front ();
+	_index.erase (state);
+	_queue.pop_front ();
+	return state;
+}
+
 bool
 ClientContext::has_state (const NodeState& node_state)
 {
@@ -58,6 +80,30 @@ ClientContext::update_state (const NodeState& node_state)
 	_state.insert (node_state);
 }
 
+void
+ClientContext::set_options (const NodeState& options)
+{
+	_batch  = false;
+	_binary = false;
+
+	for (int i = 0; i < options.n_val (); i++) {
+		TypedValue val = options.nth_val (i);
+
+		if (val.type () != TypedValue::String) {
+			continue;
+		}
+
+		std::string opt = static_cast<std::string> (val);
+
+		if (opt == "batch") {
+			_batch = true;
+		} else if (opt == "binary") {
+			_batch  = true;
+			_binary = true;
+		}
+	}
+}
+
 std::string
 ClientContext::debug_str ()
 {
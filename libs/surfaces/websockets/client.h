@@ -19,8 +19,9 @@
 #ifndef _ardour_surface_websockets_client_h_
 #define _ardour_surface_websockets_client_h_
 
-#include <set>
 #include <list>
+#include <map>
+#include <set>
 
 #include "message.h"
 #include "state.h"
@@ -29,13 +30,34 @@ typedef struct lws* Client;
 
 namespace ArdourSurface {
 
-typedef std::list<NodeStateMessage> ClientOutputBuffer;
+/* Node states waiting to be sent to a client. A newer state of a node
+   replaces a pending one, so that only the latest value is sent. */
+class ClientOutputBuffer
+{
+public:
+	bool empty () const
+	{
+		return _queue.empty ();
+	}
+
+	void push (const NodeState&);
+	NodeState pop ();
+
+private:
+	typedef std::list<NodeState>                 Queue;
+	typedef std::map<NodeState, Queue::iterator> QueueIndex;
+
+	Queue      _queue;
+	QueueIndex _index;
+};
 
 class ClientContext
 {
 public:
 	ClientContext (Client wsi)
-	    : _wsi (wsi){};
+	    : _wsi (wsi)
+	    , _batch (false)
+	    , _binary (false){};
 	virtual ~ClientContext (){};
 
 	Client wsi () const
@@ -51,10 +73,26 @@ public:
 		return _output_buf;
 	}
 
+	/* send all pending messages in one frame */
+	bool batch () const
+	{
+		return _batch;
+	}
+
+	/* use the compact binary encoding, implies batch */
+	bool binary () const
+	{
+		return _binary;
+	}
+
+	void set_options (const NodeState&);
+
 	std::string debug_str ();
 
 private:
 	Client _wsi;
+	bool   _batch;
+	bool   _binary;
 
 	typedef std::set<NodeState> ClientState;
 	ClientState                 _state;
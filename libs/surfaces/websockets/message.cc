@@ -20,9 +20,13 @@
 #include <iostream>
 #endif
 
-#include <boost/property_tree/json_parser.hpp>
-#include <boost/property_tree/ptree.hpp>
-#include <sstream>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <glib.h>
 
 #include "message.h"
 #include "json.h"
@@ -35,162 +39,544 @@
 
 using namespace ArdourSurface;
 
-namespace pt = boost::property_tree;
-
-NodeStateMessage::NodeStateMessage (const NodeState& state)
-    : _valid (true)
-    , _state (state)
+namespace {
+
+/* Node names in the order of their binary encoding ids, must match protocol.js */
+const std::string* const binary_nodes[] = {
+	&Node::strip_description,
+	&Node::strip_meter,
+	&Node::strip_gain,
+	&Node::strip_pan,
+	&Node::strip_mute,
+	&Node::strip_plugin_description,
+	&Node::strip_plugin_enable,
+	&Node::strip_plugin_param_description,
+	&Node::strip_plugin_param_value,
+	&Node::transport_tempo,
+	&Node::transport_time,
+	&Node::transport_bbt,
+	&Node::transport_roll,
+	&Node::transport_record,
+};
+
+const uint8_t binary_node_name = 0xff;
+
+enum BinaryValueTag {
+	BinaryEmpty  = 0,
+	BinaryFalse  = 1,
+	BinaryTrue   = 2,
+	BinaryInt    = 3,
+	BinaryDouble = 4,
+	BinaryString = 5,
+};
+
+void
+append_le (std::string& out, const void* data, size_t size)
 {
-	_write = state.n_val () > 0;
+	const char* p = static_cast<const char*> (data);
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+	out.append (p, size);
+#else
+	for (size_t i = size; i > 0; --i) {
+		out.push_back (p[i - 1]);
+	}
+#endif
 }
 
-NodeStateMessage::NodeStateMessage (void* buf, size_t len)
-    : _valid (false)
-    , _write (false)
+/* Reader for messages of the form {"node":"name","addr":[1,2],"val":[1,0.5,true,"s"]}.
+ * Members other than node, addr and val are skipped.
+ */
+class MessageParser
 {
-	try {
-		std::string s (static_cast<char*> (buf), len);
+public:
+	MessageParser (const char* buf, size_t len)
+		: _p (buf)
+		, _end (buf + len)
+	{}
+
+	bool parse (NodeState& state)
+	{
+		std::string   node;
+		AddressVector addr;
+		ValueVector   val;
+		bool          have_node = false;
+
+		if (!consume ('{')) {
+			return false;
+		}
+
+		if (!consume ('}')) {
+			do {
+				std::string key;
+				if (!parse_string (key) || !consume (':')) {
+					return false;
+				}
+				if (key == "node") {
+					if (!parse_string (node)) {
+						return false;
+					}
+					have_node = true;
+				} else if (key == "addr") {
+					if (!parse_array (addr)) {
+						return false;
+					}
+				} else if (key == "val") {
+					if (!parse_array (val)) {
+						return false;
+					}
+				} else if (!skip_value (0)) {
+					return false;
+				}
+			} while (consume (','));
+
+			if (!consume ('}')) {
+				return false;
+			}
+		}
+
+		if (!have_node) {
+			return false;
+		}
+
+		state = NodeState (node, addr, val);
+		return true;
+	}
+
+private:
+	const char* _p;
+	const char* _end;
+
+	void skip_ws ()
+	{
+		while (_p < _end && (*_p == ' ' || *_p == '\t' || *_p == '\n' || *_p == '\r')) {
+			++_p;
+		}
+	}
 
-		std::istringstream is (s);
-		pt::ptree          root;
-		pt::read_json (is, root);
+	bool consume (char c)
+	{
+		skip_ws ();
+		if (_p < _end && *_p == c) {
+			++_p;
+			return true;
+		}
+		return false;
+	}
 
-		_state = NodeState (root.get<std::string> ("node"));
+	bool consume_word (const char* w)
+	{
+		size_t n = strlen (w);
+		if ((size_t) (_end - _p) < n || strncmp (_p, w, n) != 0) {
+			return false;
+		}
+		_p += n;
+		return true;
+	}
 
-		pt::ptree addr = pt::ptree ();
-		addr = root.get_child ("addr", addr);
+	static void append_utf8 (std::string& s, uint32_t cp)
+	{
+		if (cp < 0x80) {
+			s.push_back ((char) cp);
+		} else if (cp < 0x800) {
+			s.push_back ((char) (0xc0 | (cp >> 6)));
+			s.push_back ((char) (0x80 | (cp & 0x3f)));
+		} else if (cp < 0x10000) {
+			s.push_back ((char) (0xe0 | (cp >> 12)));
+			s.push_back ((char) (0x80 | ((cp >> 6) & 0x3f)));
+			s.push_back ((char) (0x80 | (cp & 0x3f)));
+		} else {
+			s.push_back ((char) (0xf0 | (cp >> 18)));
+			s.push_back ((char) (0x80 | ((cp >> 12) & 0x3f)));
+			s.push_back ((char) (0x80 | ((cp >> 6) & 0x3f)));
+			s.push_back ((char) (0x80 | (cp & 0x3f)));
+		}
+	}
 
-		for (pt::ptree::iterator it = addr.begin (); it != addr.end (); ++it) {
-			// throws if datatype not uint32_t
-			_state.add_addr (static_cast<uint32_t> (stoul (it->second.data ())));
+	bool parse_hex4 (uint32_t& cp)
+	{
+		if (_end - _p < 4) {
+			return false;
+		}
+		cp = 0;
+		for (int i = 0; i < 4; ++i, ++_p) {
+			int d = g_ascii_xdigit_value (*_p);
+			if (d < 0) {
+				return false;
+			}
+			cp = (cp << 4) | d;
 		}
+		return true;
+	}
+
+	bool parse_string (std::string& s)
+	{
+		if (!consume ('"')) {
+			return false;
+		}
+
+		s.clear ();
+
+		while (_p < _end) {
+			char c = *_p++;
+
+			if (c == '"') {
+				return true;
+			}
 
-		pt::ptree val = pt::ptree ();
-		val = root.get_child ("val", val);
+			if (c != '\\') {
+				s.push_back (c);
+				continue;
+			}
 
-		for (pt::ptree::iterator it = val.begin (); it != val.end (); ++it) {
-			std::string val = it->second.data ();
+			if (_p == _end) {
+				return false;
+			}
 
-			try {
-				_state.add_val (stoi (val));
-			} catch (...) {
-				try {
-					double d = stod (val);
-					if (d >= JSON_INF) {
-						d = std::numeric_limits<double>::infinity ();
-					} else if (d <= -JSON_INF) {
-						d = -std::numeric_limits<double>::infinity ();
+			switch (*_p++) {
+				case '"':  s.push_back ('"');  break;
+				case '\\': s.push_back ('\\'); break;
+				case '/':  s.push_back ('/');  break;
+				case 'b':  s.push_back ('\b'); break;
+				case 'f':  s.push_back ('\f'); break;
+				case 'n':  s.push_back ('\n'); break;
+				case 'r':  s.push_back ('\r'); break;
+				case 't':  s.push_back ('\t'); break;
+				case 'u': {
+					uint32_t cp;
+					if (!parse_hex4 (cp)) {
+						return false;
 					}
-					_state.add_val (d);
-				} catch (...) {
-					if (val == "false") {
-						_state.add_val (false);
-					} else if (val == "true") {
-						_state.add_val (true);
-					} else {
-						_state.add_val (val);
+					if (cp >= 0xd800 && cp < 0xdc00) {
+						/* surrogate pair */
+						uint32_t lo;
+						if (!consume_word ("\\u") || !parse_hex4 (lo) || lo < 0xdc00 || lo > 0xdfff) {
+							return false;
+						}
+						cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
 					}
+					append_utf8 (s, cp);
+					break;
 				}
+				default:
+					return false;
 			}
 		}
 
-		if (_state.n_val () > 0) {
-			_write = true;
+		return false;
+	}
+
+	bool parse_number (TypedValue& v)
+	{
+		const char* start    = _p;
+		bool        integral = true;
+
+		while (_p < _end && (g_ascii_isdigit (*_p) || *_p == '-' || *_p == '+' || *_p == '.' || *_p == 'e' || *_p == 'E')) {
+			if (*_p == '.' || *_p == 'e' || *_p == 'E') {
+				integral = false;
+			}
+			++_p;
 		}
 
-		_valid = true;
+		if (_p == start) {
+			return false;
+		}
 
-	} catch (const std::exception& exc) {
-#ifndef NDEBUG
-		std::cerr << "cannot parse message - " << exc.what () << std::endl;
-#endif
+		std::string num (start, _p - start);
+		char*       num_end;
+
+		if (integral) {
+			errno = 0;
+			long l = strtol (num.c_str (), &num_end, 10);
+			if (*num_end == '\0' && errno == 0 && l >= std::numeric_limits<int>::min () && l <= std::numeric_limits<int>::max ()) {
+				v = TypedValue ((int) l);
+				return true;
+			}
+		}
+
+		double d = g_ascii_strtod (num.c_str (), &num_end);
+		if (*num_end != '\0') {
+			return false;
+		}
+
+		if (d >= JSON_INF) {
+			d = std::numeric_limits<double>::infinity ();
+		} else if (d <= -JSON_INF) {
+			d = -std::numeric_limits<double>::infinity ();
+		}
+
+		v = TypedValue (d);
+		return true;
+	}
+
+	bool parse_value (TypedValue& v)
+	{
+		skip_ws ();
+
+		if (_p == _end) {
+			return false;
+		}
+
+		switch (*_p) {
+			case '"': {
+				std::string s;
+				if (!parse_string (s)) {
+					return false;
+				}
+				v = TypedValue (s);
+				return true;
+			}
+			case 't':
+				v = TypedValue (true);
+				return consume_word ("true");
+			case 'f':
+				v = TypedValue (false);
+				return consume_word ("false");
+			case 'n':
+				v = TypedValue ();
+				return consume_word ("null");
+			default:
+				return parse_number (v);
+		}
+	}
+
+	/** skip any value, up to @a depth levels of nesting */
+	bool skip_value (int depth)
+	{
+		skip_ws ();
+
+		if (_p < _end && (*_p == '[' || *_p == '{')) {
+			bool obj = *_p == '{';
+			++_p;
+			if (depth > 16) {
+				return false;
+			}
+			if (consume (obj ? '}' : ']')) {
+				return true;
+			}
+			do {
+				if (obj) {
+					std::string key;
+					if (!parse_string (key) || !consume (':')) {
+						return false;
+					}
+				}
+				if (!skip_value (depth + 1)) {
+					return false;
+				}
+			} while (consume (','));
+			return consume (obj ? '}' : ']');
+		}
+
+		TypedValue ignored;
+		return parse_value (ignored);
+	}
+
+	bool parse_array (AddressVector& addr)
+	{
+		if (!consume ('[')) {
+			return false;
+		}
+		if (consume (']')) {
+			return true;
+		}
+		do {
+			TypedValue v;
+			if (!parse_value (v) || v.type () != TypedValue::Int || static_cast<int> (v) < 0) {
+				return false;
+			}
+			addr.push_back (static_cast<uint32_t> (static_cast<int> (v)));
+		} while (consume (','));
+		return consume (']');
+	}
+
+	bool parse_array (ValueVector& val)
+	{
+		if (!consume ('[')) {
+			return false;
+		}
+		if (consume (']')) {
+			return true;
+		}
+		do {
+			TypedValue v;
+			if (!parse_value (v)) {
+				return false;
+			}
+			val.push_back (v);
+		} while (consume (','));
+		return consume (']');
 	}
+};
+
+} // namespace
+
+NodeStateMessage::NodeStateMessage (const NodeState& state)
+    : _valid (true)
+    , _state (state)
+{
+	_write = state.n_val () > 0;
 }
 
-size_t
-NodeStateMessage::serialize (void* buf, size_t len) const
+NodeStateMessage::NodeStateMessage (void* buf, size_t len)
+    : _valid (false)
+    , _write (false)
 {
-	// boost json writes all values as strings, we do not want that
+	MessageParser parser (static_cast<const char*> (buf), len);
+
+	if (!parser.parse (_state)) {
+#ifndef NDEBUG
+		std::cerr << "cannot parse message - " << std::string (static_cast<char*> (buf), len) << std::endl;
+#endif
+		return;
+	}
 
-	if (len == 0) {
-		return -1;
+	if (_state.n_val () > 0) {
+		_write = true;
 	}
 
-	std::stringstream ss;
+	_valid = true;
+}
+
+void
+NodeStateMessage::serialize_json (std::string& out) const
+{
+	char num[G_ASCII_DTOSTR_BUF_SIZE];
 
-	ss << "{\"node\":\"" << _state.node () << "\"";
+	out += "{\"node\":\"";
+	out += _state.node ();
+	out += '"';
 
 	int n_addr = _state.n_addr ();
 
 	if (n_addr > 0) {
-		ss << ",\"addr\":[";
+		out += ",\"addr\":[";
 
 		for (int i = 0; i < n_addr; i++) {
 			if (i > 0) {
-				ss << ',';
+				out += ',';
 			}
 
-			ss << _state.nth_addr (i);
+			g_snprintf (num, sizeof (num), "%u", _state.nth_addr (i));
+			out += num;
 		}
 
-		ss << "]";
+		out += ']';
 	}
 
 	int n_val = _state.n_val ();
 
 	if (n_val > 0) {
-		ss << ",\"val\":[";
+		out += ",\"val\":[";
 
 		for (int i = 0; i < n_val; i++) {
 			if (i > 0) {
-				ss << ',';
+				out += ',';
 			}
 
 			TypedValue val = _state.nth_val (i);
 
 			switch (val.type ()) {
 				case TypedValue::Empty:
-					ss << "null";
+					out += "null";
 					break;
 				case TypedValue::Bool:
-					ss << (static_cast<bool> (val) ? "true" : "false");
+					out += static_cast<bool> (val) ? "true" : "false";
 					break;
 				case TypedValue::Int:
-					ss << static_cast<int> (val);
+					g_snprintf (num, sizeof (num), "%d", static_cast<int> (val));
+					out += num;
 					break;
 				case TypedValue::Double: {
 					double d = static_cast<double> (val);
 					if (d == std::numeric_limits<double>::infinity ()) {
-						ss << JSON_INF_STR;
+						out += JSON_INF_STR;
 					} else if (d == -std::numeric_limits<double>::infinity ()) {
-						ss << "-" JSON_INF_STR;
+						out += "-" JSON_INF_STR;
 					} else {
-						ss << d;
+						/* same precision as std::ostream, but independent of the locale */
+						out += g_ascii_formatd (num, sizeof (num), "%.6g", d);
 					}
 					break;
 				}
 				case TypedValue::String:
-					ss << '"' << WebSocketsJSON::escape (static_cast<std::string> (val)) << '"';
+					out += '"';
+					out += WebSocketsJSON::escape (static_cast<std::string> (val));
+					out += '"';
 					break;
 				default:
 					break;
 			}
 		}
 
-		ss << "]";
+		out += ']';
 	}
 
-	ss << '}';
+	out += '}';
+}
 
-	std::string s     = ss.str ();
-	const char* cs    = s.c_str ();
-	size_t      cs_sz = strlen (cs);
+void
+NodeStateMessage::serialize_binary (std::string& out) const
+{
+	/* node id or name, u8 address count, u32 addresses, u8 value count
+	 * and tagged values, all numbers are little endian.
+	 */
+	const std::string node = _state.node ();
+	const size_t      n_nodes = sizeof (binary_nodes) / sizeof (binary_nodes[0]);
+
+	size_t id = 0;
+	while (id < n_nodes && *binary_nodes[id] != node) {
+		++id;
+	}
 
-	if (len < cs_sz) {
-		return -1;
+	if (id < n_nodes) {
+		out.push_back ((char) id);
+	} else {
+		out.push_back ((char) binary_node_name);
+		out.push_back ((char) std::min<size_t> (node.size (), 255));
+		out.append (node, 0, 255);
 	}
 
-	memcpy (buf, cs, cs_sz);
+	int n_addr = std::min (_state.n_addr (), 255);
+	out.push_back ((char) n_addr);
 
-	return cs_sz;
+	for (int i = 0; i < n_addr; i++) {
+		uint32_t a = _state.nth_addr (i);
+		append_le (out, &a, sizeof (a));
+	}
+
+	int n_val = std::min (_state.n_val (), 255);
+	out.push_back ((char) n_val);
+
+	for (int i = 0; i < n_val; i++) {
+		TypedValue val = _state.nth_val (i);
+
+		switch (val.type ()) {
+			case TypedValue::Bool:
+				out.push_back ((char) (static_cast<bool> (val) ? BinaryTrue : BinaryFalse));
+				break;
+			case TypedValue::Int: {
+				int32_t v = static_cast<int> (val);
+				out.push_back ((char) BinaryInt);
+				append_le (out, &v, sizeof (v));
+				break;
+			}
+			case TypedValue::Double: {
+				double v = static_cast<double> (val);
+				out.push_back ((char) BinaryDouble);
+				append_le (out, &v, sizeof (v));
+				break;
+			}
+			case TypedValue::String: {
+				std::string s = static_cast<std::string> (val);
+				uint16_t    len = std::min<size_t> (s.size (), 65535);
+				out.push_back ((char) BinaryString);
+				append_le (out, &len, sizeof (len));
+				out.append (s, 0, len);
+				break;
+			}
+			default:
+				out.push_back ((char) BinaryEmpty);
+				break;
+		}
+	}
 }
@@ -19,6 +19,8 @@
 #ifndef _ardour_surface_websockets_message_h_
 #define _ardour_surface_websockets_message_h_
 
+#include <string>
+
 #include "state.h"
 
 namespace ArdourSurface {
@@ -29,7 +31,10 @@ public:
 	NodeStateMessage (const NodeState& state);
 	NodeStateMessage (void*, size_t);
 
-	size_t serialize (void*, size_t) const;
+	/** Append the message as a JSON object to @a out */
+	void serialize_json (std::string& out) const;
+	/** Append the message in compact binary encoding to @a out, see protocol.js */
+	void serialize_binary (std::string& out) const;
 
 	bool is_valid () const
 	{
@@ -215,9 +215,16 @@ WebsocketsServer::update_client (Client wsi, const NodeState& state, bool force)
 
 	if (force || !it->second.has_state (state)) {
 		/* write to client only if state was updated */
+		ClientOutputBuffer& pending = it->second.output_buf ();
+		bool                idle    = pending.empty ();
+
 		it->second.update_state (state);
-		it->second.output_buf ().push_back (NodeStateMessage (state));
-		request_write (wsi);
+		pending.push (state);
+
+		/* a write was already requested for pending states */
+		if (idle) {
+			request_write (wsi);
+		}
 	}
 }
 
@@ -266,6 +273,11 @@ WebsocketsServer::recv_client (Client wsi, void* buf, size_t len)
 		return 1;
 	}
 
+	if (msg.state ().node () == Node::client_options) {
+		it->second.set_options (msg.state ());
+		return 0;
+	}
+
 	/* avoid echo */
 	it->second.update_state (msg.state ());
 
@@ -282,28 +294,47 @@ WebsocketsServer::write_client (Client wsi)
 		return 1;
 	}
 
-	ClientOutputBuffer& pending = it->second.output_buf ();
+	ClientContext&      ctx     = it->second;
+	ClientOutputBuffer& pending = ctx.output_buf ();
 	if (pending.empty ()) {
 		return 0;
 	}
 
-	/* one lws_write() call per LWS_CALLBACK_SERVER_WRITEABLE callback */
+	/* one lws_write() call per LWS_CALLBACK_SERVER_WRITEABLE callback, clients
+	   that support it receive all pending messages in a single frame */
 
-	NodeStateMessage msg = pending.front ();
-	pending.pop_front ();
+	_frame.assign (LWS_PRE, '\0');
+
+	if (ctx.batch () && !ctx.binary ()) {
+		_frame += '[';
+	}
 
-	unsigned char out_buf[1024];
-	int len = msg.serialize (out_buf + LWS_PRE, 1024 - LWS_PRE);
+	do {
+		NodeStateMessage msg (pending.pop ());
 
-	if (len > 0) {
 #ifdef PRINT_TRAFFIC
 		std::cerr << "TX " << msg.state ().debug_str () << std::endl;
 #endif
-		if (lws_write (wsi, out_buf + LWS_PRE, len, LWS_WRITE_TEXT) != len) {
-			return 1;
+		if (ctx.binary ()) {
+			msg.serialize_binary (_frame);
+		} else {
+			if (_frame.size () > LWS_PRE + 1) {
+				_frame += ',';
+			}
+			msg.serialize_json (_frame);
 		}
-	} else {
-		PBD::error << "ArdourWebsockets: cannot serialize message" << endmsg;
+	} while (ctx.batch () && !pending.empty () && _frame.size () < LWS_PRE + MAX_FRAME_SIZE);
+
+	if (ctx.batch () && !ctx.binary ()) {
+		_frame += ']';
+	}
+
+	int                     len   = _frame.size () - LWS_PRE;
+	unsigned char*          buf   = reinterpret_cast<unsigned char*> (&_frame[LWS_PRE]);
+	enum lws_write_protocol proto = ctx.binary () ? LWS_WRITE_BINARY : LWS_WRITE_TEXT;
+
+	if (lws_write (wsi, buf, len, proto) != len) {
+		return 1;
 	}
 
 	if (!pending.empty ()) {
@@ -39,6 +39,9 @@
 // TO DO: make this configurable
 #define WEBSOCKET_LISTEN_PORT 3818
 
+// batched frames are split when they exceed this size
+#define MAX_FRAME_SIZE 32768
+
 namespace ArdourSurface {
 
 class WebsocketsServer : public SurfaceComponent
@@ -68,6 +71,9 @@ private:
 
 	ServerResources _resources;
 
+	/* reused for serializing outgoing messages */
+	std::string _frame;
+
 	int add_client (Client);
 	int del_client (Client);
 	int recv_client (Client, void*, size_t);
@@ -5220,6 +5220,12 @@ TempoCommand::get_state() const
 	return *node;
 }
 
+size_t
+TempoCommand::memory_size () const
+{
+	return sizeof (*this) + (_before ? _before->memory_size () : 0) + (_after ? _after->memory_size () : 0);
+}
+
 void
 TempoCommand::undo ()
 {
@@ -1300,6 +1300,8 @@ class LIBTEMPORAL_API TempoCommand : public PBD::Command {
 
 	XMLNode & get_state () const;
 
+	size_t memory_size () const;
+
   protected:
 	std::string _name;
 	XMLNode const * _before;
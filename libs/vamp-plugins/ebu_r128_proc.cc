@@ -33,6 +33,10 @@
 
 using namespace FonsEBU;
 
+#ifdef ENABLE_VECTOR_MODE
+typedef float FV4 __attribute__ ((vector_size (16)));
+#endif
+
 float Ebu_r128_proc::Ebu_r128_hist::_bin_power[100] = { 0.0f };
 float Ebu_r128_proc::_chan_gain[5]   = { 1.0f, 1.0f, 1.0f, 1.41f, 1.41f };
 
@@ -326,6 +330,49 @@ Ebu_r128_proc::detect_reset ()
 float
 Ebu_r128_proc::detect_process (int nfram)
 {
+#ifdef ENABLE_VECTOR_MODE
+	// Process four channels at a time, one per vector element.
+	// Unused elements repeat the last channel.
+	int           i, j, k, n;
+	float         si;
+	FV4           x, y, z1, z2, z3, z4, sj;
+	float const*  p[4];
+	Ebu_r128_fst* S;
+
+	si = 0;
+	for (i = 0; i < _nchan; i += 4) {
+		n = (_nchan - i < 4) ? _nchan - i : 4;
+		for (k = 0; k < 4; k++) {
+			S     = _fst + i + (k < n ? k : n - 1);
+			p[k]  = _ipp[i + (k < n ? k : n - 1)];
+			z1[k] = S->_z1;
+			z2[k] = S->_z2;
+			z3[k] = S->_z3;
+			z4[k] = S->_z4;
+			sj[k] = 0;
+		}
+		for (j = 0; j < nfram; j++) {
+			FV4 d = { p[0][j], p[1][j], p[2][j], p[3][j] };
+			x  = d - _b1 * z1 - _b2 * z2 + 1e-15f;
+			y  = _a0 * x + _a1 * z1 + _a2 * z2 - _c3 * z3 - _c4 * z4;
+			z2 = z1;
+			z1 = x;
+			z4 += z3;
+			z3 += y;
+			sj += y * y;
+		}
+		for (k = 0; k < n; k++) {
+			si += _chan_gain[i + k] * sj[k];
+
+			S = _fst + i + k;
+			S->_z1 = !isfinite_local (z1[k]) ? 0 : z1[k];
+			S->_z2 = !isfinite_local (z2[k]) ? 0 : z2[k];
+			S->_z3 = !isfinite_local (z3[k]) ? 0 : z3[k];
+			S->_z4 = !isfinite_local (z4[k]) ? 0 : z4[k];
+		}
+	}
+	return si;
+#else
 	int           i, j;
 	float         si, sj;
 	float         x, y, z1, z2, z3, z4;
@@ -358,4 +405,5 @@ Ebu_r128_proc::detect_process (int nfram)
 		S->_z4 = !isfinite_local (z4) ? 0 : z4;
 	}
 	return si;
+#endif
 }
@@ -17,6 +17,9 @@
 //
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <chrono>
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -55,6 +58,12 @@ calloc_complex (uint32_t k)
 	return p;
 }
 
+static int64_t
+usec_now (void)
+{
+	return std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
 Convproc::Convproc (void)
 	: _state (ST_IDLE)
 	, _options (0)
@@ -279,6 +288,27 @@ Convproc::start_process (int abspri, int policy)
 	return 0;
 }
 
+int
+Convproc::start_process (Convpool& pool, float rate)
+{
+	uint32_t k;
+
+	if (_state != ST_STOP) {
+		return Converror::BAD_STATE;
+	}
+	_latecnt = 0;
+	_inpoffs = 0;
+	_outoffs = 0;
+	reset ();
+
+	for (k = (_minpart == _quantum) ? 1 : 0; k < _nlevels; k++) {
+		_convlev[k]->start (&pool, rate);
+	}
+
+	_state = ST_PROC;
+	return 0;
+}
+
 int
 Convproc::process ()
 {
@@ -405,7 +435,7 @@ Convproc::check_stop (void)
 {
 	uint32_t k;
 
-	for (k = 0; (k < _nlevels) && (_convlev[k]->_stat == Convlevel::ST_IDLE); k++) ;
+	for (k = 0; (k < _nlevels) && (_convlev[k]->_stat == Convlevel::ST_IDLE) && (_convlev[k]->_job.load () == Convlevel::JOB_IDLE) && (_convlev[k]->_inflight.load () == 0); k++) ;
 	if (k == _nlevels) {
 		_state = ST_STOP;
 		return true;
@@ -442,11 +472,23 @@ Convlevel::Convlevel (void)
 	, _time_data (0)
 	, _prep_data (0)
 	, _freq_data (0)
+	, _pool (0)
+	, _job (JOB_IDLE)
+	, _inflight (0)
+	, _deadline (0)
+	, _usec_per_sample (1e6f / 48000.f)
 {
 }
 
 Convlevel::~Convlevel (void)
 {
+	if (_pool) {
+		_pool->remove (this);
+		/* a worker may still be finishing a job */
+		while (_inflight.load () > 0) {
+			sched_yield ();
+		}
+	}
 	cleanup ();
 }
 
@@ -607,6 +649,11 @@ Convlevel::start (int abspri, int policy)
 	pthread_attr_t     attr;
 	struct sched_param parm;
 
+	if (_pool) {
+		_pool->remove (this);
+		_pool = 0;
+	}
+
 #ifndef PTW32_VERSION
 	_pthr = 0;
 #endif
@@ -631,9 +678,39 @@ Convlevel::start (int abspri, int policy)
 	pthread_attr_destroy (&attr);
 }
 
+void
+Convlevel::start (Convpool* pool, float rate)
+{
+	_pool = pool;
+	if (rate > 0) {
+		_usec_per_sample = 1e6f / rate;
+	}
+	_stat = ST_PROC;
+	_pool->add (this);
+}
+
+void
+Convlevel::pool_done (void)
+{
+	/* The job must be idle before the process thread is woken up,
+	 * since it may immediately submit the next job.
+	 */
+	int busy = JOB_BUSY;
+	_job.compare_exchange_strong (busy, JOB_IDLE);
+	_done.post ();
+	/* this must be the last access, the level may be deleted once idle */
+	_inflight.fetch_sub (1);
+}
+
 void
 Convlevel::stop (void)
 {
+	if (_pool) {
+		/* no new jobs are queued, Convproc::check_stop ()
+		 * waits for a pending job to complete */
+		_stat = ST_IDLE;
+		return;
+	}
 	if (_stat != ST_IDLE) {
 		_stat = ST_TERM;
 		_trig.post ();
@@ -816,19 +893,30 @@ Convlevel::readout ()
 	uint32_t       i;
 	float *        p, *q;
 	Outnode const* Y;
+	int            late = 0;
 
 	_outoffs += _outsize;
 	if (_outoffs == _parsize) {
 		_outoffs = 0;
 		if (_stat == ST_PROC) {
 			while (_wait) {
-				_done.wait ();
+				if (!_pool) {
+					_done.wait ();
+				} else if (_done.trywait ()) {
+					/* the pool missed the deadline */
+					late = _bits;
+					_done.wait ();
+				}
 				_wait--;
 			}
 			if (++_opind == 3) {
 				_opind = 0;
 			}
-			_trig.post ();
+			if (_pool) {
+				_pool->submit (this);
+			} else {
+				_trig.post ();
+			}
 			_wait++;
 		} else {
 			process ();
@@ -846,7 +934,7 @@ Convlevel::readout ()
 		}
 	}
 
-	return (_wait > 1) ? _bits : 0;
+	return ((_wait > 1) ? _bits : 0) | late;
 }
 
 int
@@ -1045,3 +1133,177 @@ Outnode::~Outnode (void)
 	fftwf_free (_buff[1]);
 	fftwf_free (_buff[2]);
 }
+
+// ----------------------------------------------------------------------------
+
+Convpool::Convpool (void)
+	: _nthr (0)
+	, _run (false)
+	, _late (0)
+{
+	pthread_mutex_init (&_mutex, 0);
+	_trig.init (0, 0);
+}
+
+Convpool::~Convpool (void)
+{
+	stop ();
+	pthread_mutex_destroy (&_mutex);
+}
+
+int
+Convpool::start (uint32_t nthr, int abspri, int policy)
+{
+	int                min, max;
+	pthread_attr_t     attr;
+	struct sched_param parm;
+
+	if (_nthr > 0) {
+		return Converror::BAD_STATE;
+	}
+	if ((nthr < 1) || (nthr > MAXTHR)) {
+		return Converror::BAD_PARAM;
+	}
+
+	min = sched_get_priority_min (policy);
+	max = sched_get_priority_max (policy);
+	if (abspri > max) {
+		abspri = max;
+	}
+	if (abspri < min) {
+		abspri = min;
+	}
+	parm.sched_priority = abspri;
+
+	_run = true;
+
+	for (uint32_t i = 0; i < nthr; i++) {
+		pthread_attr_init (&attr);
+		pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_JOINABLE);
+		pthread_attr_setschedpolicy (&attr, policy);
+		pthread_attr_setschedparam (&attr, &parm);
+		pthread_attr_setscope (&attr, PTHREAD_SCOPE_SYSTEM);
+		pthread_attr_setinheritsched (&attr, PTHREAD_EXPLICIT_SCHED);
+		pthread_attr_setstacksize (&attr, 0x10000); // 64kB
+		int rv = pthread_create (&_pthr[_nthr], &attr, static_main, this);
+		pthread_attr_destroy (&attr);
+
+		if (rv) {
+			/* no permission for realtime scheduling, use a normal thread */
+			rv = pthread_create (&_pthr[_nthr], 0, static_main, this);
+		}
+		if (rv) {
+			break;
+		}
+		_nthr++;
+	}
+
+	if (_nthr == 0) {
+		_run = false;
+		return Converror::MEM_ALLOC;
+	}
+	return 0;
+}
+
+void
+Convpool::stop (void)
+{
+	uint32_t k;
+
+	if (_nthr == 0) {
+		return;
+	}
+
+	_run = false;
+	for (k = 0; k < _nthr; k++) {
+		_trig.post ();
+	}
+	for (k = 0; k < _nthr; k++) {
+		pthread_join (_pthr[k], 0);
+	}
+	_nthr = 0;
+}
+
+void
+Convpool::add (Convlevel* L)
+{
+	pthread_mutex_lock (&_mutex);
+	if (std::find (_levels.begin (), _levels.end (), L) == _levels.end ()) {
+		_levels.push_back (L);
+	}
+	pthread_mutex_unlock (&_mutex);
+}
+
+void
+Convpool::remove (Convlevel* L)
+{
+	pthread_mutex_lock (&_mutex);
+	std::vector<Convlevel*>::iterator i = std::find (_levels.begin (), _levels.end (), L);
+	if (i != _levels.end ()) {
+		_levels.erase (i);
+	}
+	pthread_mutex_unlock (&_mutex);
+}
+
+void
+Convpool::submit (Convlevel* L)
+{
+	/* realtime context. The result is needed when the level's next partition is due */
+	L->_deadline = usec_now () + (int64_t)(L->_parsize * L->_usec_per_sample);
+	L->_job.store (Convlevel::JOB_QUEUED);
+	_trig.post ();
+}
+
+Convlevel*
+Convpool::claim (void)
+{
+	Convlevel* rv = 0;
+
+	/* earliest deadline first, shorter partitions first */
+	pthread_mutex_lock (&_mutex);
+	for (std::vector<Convlevel*>::const_iterator i = _levels.begin (); i != _levels.end (); ++i) {
+		Convlevel* L = *i;
+		if (L->_job.load () != Convlevel::JOB_QUEUED) {
+			continue;
+		}
+		if (!rv || L->_deadline < rv->_deadline || (L->_deadline == rv->_deadline && L->_parsize < rv->_parsize)) {
+			rv = L;
+		}
+	}
+	if (rv) {
+		rv->_inflight.fetch_add (1);
+		rv->_job.store (Convlevel::JOB_BUSY);
+	}
+	pthread_mutex_unlock (&_mutex);
+	return rv;
+}
+
+void*
+Convpool::static_main (void* arg)
+{
+#if !defined PTW32_VERSION && defined _GNU_SOURCE
+	pthread_setname_np (pthread_self(), "ZConvpool");
+#endif
+	((Convpool*)arg)->main ();
+	return 0;
+}
+
+void
+Convpool::main (void)
+{
+	while (true) {
+		_trig.wait ();
+		if (!_run) {
+			return;
+		}
+		Convlevel* L = claim ();
+		if (!L) {
+			continue;
+		}
+		L->process ();
+		if (usec_now () > L->_deadline) {
+			_late.fetch_add (1);
+		}
+		L->pool_done ();
+	}
+}
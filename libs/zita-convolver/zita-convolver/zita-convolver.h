@@ -21,6 +21,9 @@
 #define ARDOUR_ZITA_CONVOLVER_H
 
 
+#include <atomic>
+#include <vector>
+
 #include <fftw3.h>
 #include <pthread.h>
 #include <stdint.h>
@@ -227,10 +230,13 @@ private:
 	int _error;
 };
 
+class Convpool;
+
 class LIBZCONVOLVER_API Convlevel
 {
 private:
 	friend class Convproc;
+	friend class Convpool;
 
 	enum {
 		OPT_FFTW_MEASURE = 1,
@@ -244,6 +250,12 @@ private:
 		ST_PROC
 	};
 
+	enum {
+		JOB_IDLE,
+		JOB_QUEUED,
+		JOB_BUSY
+	};
+
 	Convlevel (void);
 	~Convlevel (void);
 
@@ -270,8 +282,10 @@ private:
 	            float**  outbuff);
 
 	void start (int absprio, int policy);
+	void start (Convpool* pool, float rate);
 
 	void process ();
+	void pool_done (void);
 
 	int readout ();
 	int readtail (uint32_t n_samples);
@@ -316,6 +330,70 @@ private:
 	fftwf_complex*    _freq_data; // workspace
 	float**           _inpbuff;   // array of shared input buffers
 	float**           _outbuff;   // array of shared output buffers
+	Convpool*         _pool;      // shared worker pool, if any
+	std::atomic<int>  _job;       // pool job state
+	std::atomic<int>  _inflight;  // pool worker still accessing this level
+	int64_t           _deadline;  // pool job deadline [usec]
+	float             _usec_per_sample; // used to compute the deadline
+};
+
+// ----------------------------------------------------------------------------
+
+/** A pool of worker threads shared by the partition levels of many Convproc.
+ *
+ * Instead of one thread per partition level, levels started with
+ * Convproc::start_process (Convpool&, float) queue their work here. Jobs are
+ * executed earliest-deadline-first, the deadline being the time when
+ * the level's next partition is due (one partition length later).
+ */
+class LIBZCONVOLVER_API Convpool
+{
+public:
+	Convpool (void);
+	~Convpool (void);
+
+	enum {
+		MAXTHR = 64
+	};
+
+	int  start (uint32_t nthr, int abspri, int policy);
+	void stop (void);
+
+	uint32_t nthreads (void) const
+	{
+		return _nthr;
+	}
+
+	/** Number of jobs that completed after their deadline */
+	uint64_t late_count (void) const
+	{
+		return _late.load ();
+	}
+
+private:
+	friend class Convlevel;
+	friend class Convproc;
+
+	Convpool (const Convpool&);            // disabled
+	Convpool& operator= (const Convpool&); // disabled
+
+	void add (Convlevel*);
+	void remove (Convlevel*);
+	void submit (Convlevel*);
+
+	Convlevel* claim (void);
+
+	static void* static_main (void* arg);
+
+	void main (void);
+
+	pthread_mutex_t         _mutex;         // protects _levels
+	std::vector<Convlevel*> _levels;        // levels using this pool
+	ZCsema                  _trig;          // one post per queued job
+	pthread_t               _pthr[MAXTHR];  // worker threads
+	uint32_t                _nthr;          // number of worker threads
+	std::atomic<bool>       _run;
+	std::atomic<uint64_t>   _late;
 };
 
 // ----------------------------------------------------------------------------
@@ -393,6 +471,8 @@ public:
 	int reset (void);
 
 	int start_process (int abspri, int policy);
+	/** @param rate sample rate, used to compute job deadlines */
+	int start_process (Convpool& pool, float rate);
 
 	int process ();
 	int tailonly (uint32_t n_samples);
@@ -28,11 +28,24 @@
 
 using namespace ArdourZita;
 
+VMResampler::filter_t VMResampler::_filter = VMResampler::default_filter;
+
+float
+VMResampler::default_filter (float const* p1, float const* p2, float const* q1, float const* q2, float a, float b, unsigned int hl)
+{
+	const int n = hl;
+	float s = 1e-25f;
+	for (int i = 0; i < n; i++) {
+		const float c1 = a * q1 [i] + b * q1 [i + n];
+		const float c2 = a * q2 [i] + b * q2 [i - n];
+		s += p1[i] * c1 + p2[-i-1] * c2;
+	}
+	return s - 1e-25f;
+}
+
 VMResampler::VMResampler (void)
 	: _table (0)
   , _buff  (0)
-  , _c1 (0)
-  , _c2 (0)
   , _reset (false)
 {
 	reset ();
@@ -66,8 +79,6 @@ VMResampler::setup (unsigned int hlen, double frel)
 	if (T) {
 		_table = T;
 		_buff  = new float [2 * h - 1 + k];
-		_c1 = new float [2 * h];
-		_c2 = new float [2 * h];
 		_inmax = k;
 		_pstep = s;
 		_qstep = s;
@@ -82,11 +93,7 @@ VMResampler::clear (void)
 {
 	Resampler_table::destroy (_table);
 	delete[] _buff;
-	delete[] _c1;
-	delete[] _c2;
 	_buff  = 0;
-	_c1 = 0;
-	_c2 = 0;
 	_table = 0;
 	_inmax = 0;
 	_pstep = 0;
@@ -167,7 +174,7 @@ VMResampler::process (void)
 {
 	unsigned int   in, nr, n;
 	double         ph, dp;
-	float          a, *p1, *p2;
+	float          *p1, *p2;
 
 	if (!_table) {
 		n = std::min (inp_count, out_count);
@@ -246,16 +253,7 @@ VMResampler::process (void)
 				const float aa = 1.0f - bb;
 				float const* cq1 = _table->_ctab + hl * k;
 				float const* cq2 = _table->_ctab + hl * (np - k);
-				for (int i = 0; i < hl; i++) {
-					_c1 [i] = aa * cq1 [i] + bb * cq1 [i + hl];
-					_c2 [i] = aa * cq2 [i] + bb * cq2 [i - hl];
-				}
-
-				a = 1e-25f;
-				for (int i = 0; i < hl; i++) {
-					a += p1[i] * _c1 [i] + p2[-i-1] * _c2 [i];
-				}
-				*out_data++ = a - 1e-25f;
+				*out_data++ = _filter (p1, p2, cq1, cq2, aa, bb, hl);
 			}
 			out_count--;
 
@@ -45,6 +45,19 @@ public:
 	void   set_rrfilt (double t);
 	double set_rratio (double r);
 
+	/** FIR filter kernel: interpolates the filter coefficients
+	 * c1[i] = a * q1[i] + b * q1[i + hl], c2[i] = a * q2[i] + b * q2[i - hl]
+	 * and returns the sum of p1[i] * c1[i] + p2[-i-1] * c2[i] for i in [0, hl).
+	 */
+	typedef float (*filter_t) (float const* p1, float const* p2, float const* q1, float const* q2, float a, float b, unsigned int hl);
+
+	/** Replace the filter kernel, e.g. with a SIMD optimized version.
+	 * This is not thread-safe and must be called before processing starts.
+	 */
+	static void override_filter (filter_t f) { _filter = f ? f : default_filter; }
+
+	static float default_filter (float const* p1, float const* p2, float const* q1, float const* q2, float a, float b, unsigned int hl);
+
 	unsigned int         inp_count;
 	unsigned int         out_count;
 	float               *inp_data;
@@ -64,9 +77,9 @@ private:
 	double               _qstep;
 	double               _wstep;
 	float               *_buff;
-	float               *_c1;
-	float               *_c2;
 	bool                 _reset;
+
+	static filter_t      _filter;
 };
 
 };
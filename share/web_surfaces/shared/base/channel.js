@@ -16,7 +16,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-import { Message } from './protocol.js';
+import { Message, StateNode } from './protocol.js';
 
 export default class MessageChannel {
 
@@ -29,23 +29,32 @@ export default class MessageChannel {
 	async open () {
 		return new Promise((resolve, reject) => {
 			this._socket = new WebSocket(`ws://${this._host}`);
+			this._socket.binaryType = 'arraybuffer';
 
 			this._socket.onclose = () => this.onClose();
 
 			this._socket.onerror = (error) => this.onError(error);
 
 			this._socket.onmessage = (event) => {
-				const msg = Message.fromJsonText(event.data);
+				const msgs = (typeof event.data == 'string') ? Message.listFromJsonText(event.data)
+					: Message.listFromBinary(event.data);
 
-				if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
-					this._pending.resolve(msg);
-					this._pending = null;
-				} else {
-					this.onMessage(msg, true);
+				for (const msg of msgs) {
+					if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
+						this._pending.resolve(msg);
+						this._pending = null;
+					} else {
+						this.onMessage(msg, true);
+					}
 				}
 			};
 
-			this._socket.onopen = resolve;
+			this._socket.onopen = () => {
+				// receive all updates of a server tick in one compact frame
+				const options = new Message(StateNode.CLIENT_OPTIONS, [], ['batch', 'binary']);
+				this._socket.send(options.toJsonText());
+				resolve();
+			};
 		});
 	}
 
@@ -30,10 +30,32 @@ export const StateNode = Object.freeze({
 	STRIP_PLUGIN_PARAM_VALUE       : 'strip_plugin_param_value',
 	TRANSPORT_TEMPO                : 'transport_tempo',
 	TRANSPORT_TIME                 : 'transport_time',
+	TRANSPORT_BBT                  : 'transport_bbt',
 	TRANSPORT_ROLL                 : 'transport_roll',
-	TRANSPORT_RECORD               : 'transport_record'
+	TRANSPORT_RECORD               : 'transport_record',
+	CLIENT_OPTIONS                 : 'client_options'
 });
 
+// Node ids of the binary encoding, must match message.cc
+const BINARY_NODES = [
+	StateNode.STRIP_DESCRIPTION,
+	StateNode.STRIP_METER,
+	StateNode.STRIP_GAIN,
+	StateNode.STRIP_PAN,
+	StateNode.STRIP_MUTE,
+	StateNode.STRIP_PLUGIN_DESCRIPTION,
+	StateNode.STRIP_PLUGIN_ENABLE,
+	StateNode.STRIP_PLUGIN_PARAM_DESCRIPTION,
+	StateNode.STRIP_PLUGIN_PARAM_VALUE,
+	StateNode.TRANSPORT_TEMPO,
+	StateNode.TRANSPORT_TIME,
+	StateNode.TRANSPORT_BBT,
+	StateNode.TRANSPORT_ROLL,
+	StateNode.TRANSPORT_RECORD
+];
+
+const BINARY_NODE_NAME = 0xff;
+
 export class Message {
 
 	constructor (node, addr, val) {
@@ -61,6 +83,80 @@ export class Message {
 		return new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val);
 	}
 
+	// A frame holds either a single message or, for clients that requested
+	// batching, an array of messages
+	static listFromJsonText (jsonText) {
+		const raw = JSON.parse(jsonText);
+		const rawMsgs = Array.isArray(raw) ? raw : [raw];
+		return rawMsgs.map((rawMsg) => new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val || []));
+	}
+
+	static listFromBinary (buffer) {
+		const view = new DataView(buffer);
+		const decoder = new TextDecoder();
+		const msgs = [];
+		let pos = 0;
+
+		const string = (len) => {
+			const s = decoder.decode(new Uint8Array(buffer, pos, len));
+			pos += len;
+			return s;
+		};
+
+		while (pos < view.byteLength) {
+			let node;
+			const nodeId = view.getUint8(pos++);
+
+			if (nodeId == BINARY_NODE_NAME) {
+				node = string(view.getUint8(pos++));
+			} else {
+				node = BINARY_NODES[nodeId];
+			}
+
+			const addr = [];
+			const nAddr = view.getUint8(pos++);
+
+			for (let i = 0; i < nAddr; i++, pos += 4) {
+				addr.push(view.getUint32(pos, true));
+			}
+
+			const val = [];
+			const nVal = view.getUint8(pos++);
+
+			for (let i = 0; i < nVal; i++) {
+				switch (view.getUint8(pos++)) {
+					case 1:
+						val.push(false);
+						break;
+					case 2:
+						val.push(true);
+						break;
+					case 3:
+						val.push(view.getInt32(pos, true));
+						pos += 4;
+						break;
+					case 4:
+						val.push(view.getFloat64(pos, true));
+						pos += 8;
+						break;
+					case 5: {
+						const len = view.getUint16(pos, true);
+						pos += 2;
+						val.push(string(len));
+						break;
+					}
+					default:
+						val.push(null);
+						break;
+				}
+			}
+
+			msgs.push(new Message(node, addr, val));
+		}
+
+		return msgs;
+	}
+
 	toJsonText () {
 		let val = [];
 
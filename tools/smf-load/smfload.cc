@@ -1,22 +1,333 @@
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <list>
+#include <vector>
 
 #include <glib/gstdio.h>
 
+#include "pbd/pbd.h"
+
+#include "temporal/tempo.h"
+
+#include "evoral/Control.h"
+#include "evoral/ControlList.h"
+#include "evoral/Event.h"
+#include "evoral/ParameterDescriptor.h"
 #include "evoral/SMF.h"
+#include "evoral/Sequence.h"
+#include "evoral/TypeMap.h"
+#include "evoral/midi_events.h"
 #include "libsmf/smf.h"
 
+/* Compare loading a SMF into a model (Evoral::Sequence, as done by
+ * ARDOUR::SMFSource::load_model) with the playback-only path that
+ * just scans the file once, and streams events from the file when
+ * rendering a region.
+ */
+
+using namespace Evoral;
+
+class BenchTypeMap : public TypeMap
+{
+public:
+	enum BenchEventType {
+		NOTE = 1,
+		CONTROL,
+		PGM_CHANGE,
+		PITCH_BEND,
+		CHANNEL_PRESSURE,
+		KEY_PRESSURE,
+		SYSEX
+	};
+
+	bool type_is_midi (uint32_t) const { return true; }
+
+	uint8_t parameter_midi_type (const Parameter& param) const
+	{
+		switch (param.type ()) {
+			case CONTROL:          return MIDI_CMD_CONTROL;
+			case PGM_CHANGE:       return MIDI_CMD_PGM_CHANGE;
+			case PITCH_BEND:       return MIDI_CMD_BENDER;
+			case CHANNEL_PRESSURE: return MIDI_CMD_CHANNEL_PRESSURE;
+			case KEY_PRESSURE:     return MIDI_CMD_NOTE_PRESSURE;
+			case SYSEX:            return MIDI_CMD_COMMON_SYSEX;
+			default:               return 0;
+		}
+	}
+
+	ParameterType midi_parameter_type (const uint8_t* buf, uint32_t) const
+	{
+		switch (buf[0] & 0xF0) {
+			case MIDI_CMD_CONTROL:          return CONTROL;
+			case MIDI_CMD_PGM_CHANGE:       return PGM_CHANGE;
+			case MIDI_CMD_BENDER:           return PITCH_BEND;
+			case MIDI_CMD_CHANNEL_PRESSURE: return CHANNEL_PRESSURE;
+			case MIDI_CMD_NOTE_PRESSURE:    return KEY_PRESSURE;
+			case MIDI_CMD_NOTE_ON:          return NOTE;
+			case MIDI_CMD_NOTE_OFF:         return NOTE;
+			case MIDI_CMD_COMMON_SYSEX:     return SYSEX;
+			default:                        return 0;
+		}
+	}
+
+	ParameterDescriptor descriptor (const Parameter& param) const
+	{
+		ParameterDescriptor desc;
+		desc.upper      = param.type () == PITCH_BEND ? 16383 : 127;
+		desc.rangesteps = param.type () == PITCH_BEND ? 16384 : 128;
+		return desc;
+	}
+
+	std::string to_symbol (const Parameter&) const { return "control"; }
+};
+
+class BenchSequence : public Sequence<Temporal::Beats>
+{
+public:
+	BenchSequence (BenchTypeMap& map)
+		: Sequence<Temporal::Beats> (map)
+		, _type_map (map)
+	{}
+
+	std::shared_ptr<Control> control_factory (const Parameter& param)
+	{
+		ParameterDescriptor          desc (_type_map.descriptor (param));
+		std::shared_ptr<ControlList> list (new ControlList (param, desc, Temporal::TimeDomainProvider (Temporal::BeatTime)));
+		return std::shared_ptr<Control> (new Control (param, desc, list));
+	}
+
+private:
+	BenchTypeMap& _type_map;
+};
+
+/* what a rendered playlist buffer stores per event */
+struct RenderedEvent {
+	Temporal::Beats time;
+	uint32_t        offset;
+	uint32_t        size;
+};
+
+struct Rendered {
+	std::vector<RenderedEvent> events;
+	std::vector<uint8_t>       data;
+
+	void clear ()
+	{
+		events.clear ();
+		data.clear ();
+	}
+
+	void write (Temporal::Beats const& t, uint32_t size, uint8_t const* buf)
+	{
+		RenderedEvent ev = { t, (uint32_t)data.size (), size };
+		events.push_back (ev);
+		data.insert (data.end (), buf, buf + size);
+	}
+};
+
+static bool
+compare_eventlist (const Event<Temporal::Beats>* a, const Event<Temporal::Beats>* b)
+{
+	return a->time () < b->time ();
+}
+
+/* cf. SMFSource::load_model_unlocked */
+static size_t
+load_model (SMF& smf, BenchTypeMap& type_map)
+{
+	BenchSequence seq (type_map);
+
+	seq.start_write ();
+
+	uint32_t scratch_size = 0;
+	uint32_t delta_t      = 0;
+	uint32_t size         = 0;
+	uint8_t* buf          = NULL;
+	event_id_t event_id;
+	int        ret;
+
+	std::list<Event<Temporal::Beats>*> eventlist;
+
+	for (unsigned i = 1; i <= smf.num_tracks (); ++i) {
+		if (smf.seek_to_track (i)) {
+			continue;
+		}
+
+		uint64_t time = 0; /* in SMF ticks */
+
+		while ((ret = smf.read_event (&delta_t, &size, &buf, &event_id)) >= 0) {
+			time += delta_t;
+			if (ret == 0) {
+				continue;
+			}
+			eventlist.push_back (new Event<Temporal::Beats> (MIDI_EVENT, Temporal::Beats::ticks_at_rate (time, smf.ppqn ()), size, buf, true));
+
+			scratch_size = std::max (size, scratch_size);
+			size         = scratch_size;
+		}
+	}
+
+	eventlist.sort (compare_eventlist);
+
+	for (auto const& ev : eventlist) {
+		seq.append (*ev, next_event_id ());
+		delete ev;
+	}
+
+	seq.end_write (Sequence<Temporal::Beats>::ResolveStuckNotes, smf.file_duration ());
+
+	free (buf);
+
+	return seq.n_notes ();
+}
+
+/* cf. SMFSource::scan_unlocked */
+static uint64_t
+scan (SMF& smf)
+{
+	uint32_t   scratch_size = 0;
+	uint32_t   delta_t      = 0;
+	uint32_t   size         = 0;
+	uint8_t*   buf          = NULL;
+	uint64_t   n_events     = 0;
+	event_id_t ignored;
+	int        ret;
+
+	for (unsigned i = 1; i <= smf.num_tracks (); ++i) {
+		if (smf.seek_to_track (i)) {
+			continue;
+		}
+		while ((ret = smf.read_event (&delta_t, &size, &buf, &ignored)) >= 0) {
+			if (ret > 0) {
+				++n_events;
+				scratch_size = std::max (size, scratch_size);
+				size         = scratch_size;
+			}
+		}
+	}
+
+	free (buf);
+
+	return n_events;
+}
+
+/* cf. SMFSource::read_unlocked */
+static void
+stream (SMF const& smf, Rendered& dst)
+{
+	uint32_t   scratch_size = 0;
+	uint32_t   delta_t      = 0;
+	uint32_t   size         = 0;
+	uint8_t*   buf          = NULL;
+	uint64_t   time         = 0;
+	event_id_t ignored;
+	int        ret;
+
+	smf.seek_to_start ();
+
+	while ((ret = smf.read_event (&delta_t, &size, &buf, &ignored)) >= 0) {
+		time += delta_t;
+		if (ret == 0) {
+			continue;
+		}
+		dst.write (Temporal::Beats::ticks_at_rate (time, smf.ppqn ()), size, buf);
+
+		scratch_size = std::max (size, scratch_size);
+		size         = scratch_size;
+	}
+
+	free (buf);
+}
+
+static double
+elapsed_ms (std::chrono::steady_clock::time_point const& t0)
+{
+	return std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - t0).count ();
+}
+
+static void
+benchmark (const char* fn, int iterations)
+{
+	BenchTypeMap type_map;
+	Rendered     rendered;
+
+	double t_open   = 0;
+	double t_model  = 0;
+	double t_scan   = 0;
+	double t_stream = 0;
+
+	size_t   n_notes  = 0;
+	uint64_t n_events = 0;
+
+	for (int i = 0; i < iterations; ++i) {
+		SMF smf;
+
+		auto t0 = std::chrono::steady_clock::now ();
+		if (smf.open (fn, 1, false)) {
+			printf ("SMF failed to open file '%s'\n", fn);
+			::exit (EXIT_FAILURE);
+		}
+		t_open += elapsed_ms (t0);
+
+		t0 = std::chrono::steady_clock::now ();
+		n_notes = load_model (smf, type_map);
+		t_model += elapsed_ms (t0);
+
+		t0 = std::chrono::steady_clock::now ();
+		n_events = scan (smf);
+		t_scan += elapsed_ms (t0);
+
+		rendered.clear ();
+		t0 = std::chrono::steady_clock::now ();
+		stream (smf, rendered);
+		t_stream += elapsed_ms (t0);
+	}
+
+	printf ("SMF '%s': %" PRIu64 " events, %zu notes, %d iterations\n", fn, n_events, n_notes, iterations);
+	printf ("  open          %8.3f ms\n", t_open / iterations);
+	printf ("  load model    %8.3f ms\n", t_model / iterations);
+	printf ("  scan          %8.3f ms\n", t_scan / iterations);
+	printf ("  stream render %8.3f ms (%zu events)\n", t_stream / iterations, rendered.events.size ());
+	printf ("  model load: %.3f ms, deferred model: %.3f ms (scan + render)\n",
+	        (t_open + t_model) / iterations, (t_open + t_scan + t_stream) / iterations);
+}
+
+static void
+usage (const char* argv0)
+{
+	std::cerr << "Usage: " << argv0 << " [-b <iterations>] <midi file>.\n";
+	::exit (EXIT_FAILURE);
+}
+
 int
 main (int argc, char** argv)
 {
-	const char* fn = "";
+	const char* fn         = "";
+	int         iterations = 0;
 
-	if (argc > 1) {
+	if (argc > 3 && !strcmp (argv[1], "-b")) {
+		iterations = atoi (argv[2]);
+		fn         = argv[3];
+	} else if (argc == 2) {
 		fn = argv[1];
 	} else {
-		std::cerr << "Usage: " << argv[0] << " <midi file>.\n";
+		usage (argv[0]);
+	}
+
+	if (!PBD::init ()) {
 		::exit (EXIT_FAILURE);
 	}
+	Temporal::init ();
+
+	if (iterations > 0) {
+		benchmark (fn, iterations);
+		return 0;
+	}
 
 #if 1
 	Evoral::SMF smf;